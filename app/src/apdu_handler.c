@@ -28,16 +28,21 @@
 #include "coin.h"
 #include "coin_evm.h"
 #include "crypto.h"
+#include "crypto_cache.h"
 #include "crypto_helper.h"
 #include "tx.h"
+#include "tx_pb.h"
 #include "view.h"
 #include "view_internal.h"
 #include "zxmacros.h"
 
 static bool tx_initialized = false;
+// INS_SIGN_BATCH session accepting transactions
+static bool batch_active = false;
 
 void extractHDPath(uint32_t rx, uint32_t offset) {
     tx_initialized = false;
+    batch_active = false;
 
     if ((rx - offset) < sizeof(uint32_t) * HDPATH_LEN_DEFAULT) {
         THROW(APDU_CODE_WRONG_LENGTH);
@@ -62,6 +67,9 @@ __Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx) {
         case P1_INIT:
             tx_initialize();
             tx_reset();
+            if (crypto_txDigestInit() != zxerr_ok) {
+                THROW(APDU_CODE_EXECUTION_ERROR);
+            }
             extractHDPath(rx, OFFSET_DATA);
             tx_initialized = true;
             return false;
@@ -74,6 +82,10 @@ __Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx) {
                 tx_initialized = false;
                 THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
             }
+            if (crypto_txDigestUpdate(&(G_io_apdu_buffer[OFFSET_DATA]), added) != zxerr_ok) {
+                tx_initialized = false;
+                THROW(APDU_CODE_EXECUTION_ERROR);
+            }
             return false;
         case P1_LAST:
             if (!tx_initialized) {
@@ -84,6 +96,10 @@ __Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx) {
             if (added != rx - OFFSET_DATA) {
                 THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
             }
+            if (crypto_txDigestUpdate(&(G_io_apdu_buffer[OFFSET_DATA]), added) != zxerr_ok ||
+                crypto_txDigestFinalize() != zxerr_ok) {
+                THROW(APDU_CODE_EXECUTION_ERROR);
+            }
             return true;
     }
 
@@ -141,11 +157,17 @@ __Z_INLINE void handleGetAddr(volatile uint32_t *flags, volatile uint32_t *tx, u
 
 __Z_INLINE void handleSign(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
     zemu_log("handleSign\n");
+    const uint8_t signMode = G_io_apdu_buffer[OFFSET_P2];
+    if (signMode != P2_SIGN_AMINO_JSON && signMode != P2_SIGN_PROTOBUF_DIRECT) {
+        THROW(APDU_CODE_INVALIDP1P2);
+    }
+
     if (!process_chunk(tx, rx)) {
         THROW(APDU_CODE_OK);
     }
 
-    const char *error_msg = tx_parse();
+    const bool direct = signMode == P2_SIGN_PROTOBUF_DIRECT;
+    const char *error_msg = direct ? tx_parse_pb() : tx_parse();
     CHECK_APP_CANARY()
     if (error_msg != NULL) {
         const int error_msg_length = strnlen(error_msg, sizeof(G_io_apdu_buffer));
@@ -154,16 +176,105 @@ __Z_INLINE void handleSign(volatile uint32_t *flags, volatile uint32_t *tx, uint
         THROW(APDU_CODE_DATA_INVALID);
     }
 
-    view_review_init(tx_getItem, tx_getNumItems, app_sign);
+    if (direct) {
+        view_review_init(tx_getItemPb, tx_getNumItemsPb, app_sign);
+    } else {
+        view_review_init(tx_view_getItem, tx_view_getNumItems, app_sign);
+    }
     view_review_show(REVIEW_TXN);
     *flags |= IO_ASYNCH_REPLY;
 }
 
+__Z_INLINE void handleSignBatch(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
+    zemu_log("handleSignBatch\n");
+    const uint8_t payloadType = G_io_apdu_buffer[OFFSET_PAYLOAD_TYPE];
+
+    if (payloadType == P1_BATCH_SIGNATURES) {
+        // P2 is the index of the first signature to return
+        const uint8_t first = G_io_apdu_buffer[OFFSET_P2];
+        if (first >= crypto_batchCount()) {
+            THROW(APDU_CODE_DATA_INVALID);
+        }
+        *tx = app_fill_batch_signatures(first);
+        if (*tx == 0) {
+            THROW(APDU_CODE_COMMAND_NOT_ALLOWED);
+        }
+        THROW(APDU_CODE_OK);
+    }
+
+    if (G_io_apdu_buffer[OFFSET_P2] != P2_SIGN_AMINO_JSON) {
+        THROW(APDU_CODE_INVALIDP1P2);
+    }
+
+    if (payloadType == P1_BATCH_REVIEW) {
+        if (!batch_active || crypto_batchCount() == 0) {
+            THROW(APDU_CODE_TX_NOT_INITIALIZED);
+        }
+        // Nothing can be added once the summary is shown
+        batch_active = false;
+        tx_initialized = false;
+        view_review_init(tx_batch_getItem, tx_batch_getNumItems, app_sign_batch);
+        view_review_show(REVIEW_TXN);
+        *flags |= IO_ASYNCH_REPLY;
+        return;
+    }
+
+    if (payloadType != P1_INIT && !batch_active) {
+        THROW(APDU_CODE_TX_NOT_INITIALIZED);
+    }
+
+    if (!process_chunk(tx, rx)) {
+        if (payloadType == P1_INIT) {
+            tx_batch_init();
+            if (crypto_batchInit() != zxerr_ok) {
+                THROW(APDU_CODE_EXECUTION_ERROR);
+            }
+            batch_active = true;
+        }
+        THROW(APDU_CODE_OK);
+    }
+
+    // Last chunk of one transaction, any error discards the whole batch
+    const char *error_msg = tx_batch_add();
+    CHECK_APP_CANARY()
+    if (error_msg != NULL) {
+        batch_active = false;
+        const int error_msg_length = strnlen(error_msg, sizeof(G_io_apdu_buffer));
+        memcpy(G_io_apdu_buffer, error_msg, error_msg_length);
+        *tx += (error_msg_length);
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+
+    // Keep its digest and get ready for the next transaction
+    tx_reset();
+    if (crypto_batchAddDigest() != zxerr_ok || crypto_txDigestInit() != zxerr_ok) {
+        batch_active = false;
+        THROW(APDU_CODE_EXECUTION_ERROR);
+    }
+    tx_initialized = true;
+
+    G_io_apdu_buffer[0] = crypto_batchCount();
+    *tx = 1;
+    THROW(APDU_CODE_OK);
+}
+
+// INS_SIGN_ETH and INS_SIGN_PERSONAL_MESSAGE reuse the transaction buffer, a transfer in progress can't continue
+// after them
+__Z_INLINE void end_transfer() {
+    tx_initialized = false;
+    batch_active = false;
+}
+
 void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
     volatile uint16_t sw = 0;
 
     BEGIN_TRY {
         TRY {
+            // Cached public keys belong to the unlocked seed, drop them as soon as the device is locked
+            if (os_global_pin_is_validated() != BOLOS_UX_OK) {
+                crypto_cache_reset();
+            }
+
             const uint8_t cla = G_io_apdu_buffer[OFFSET_CLA];
 
             if ((cla != CLA) && (cla != CLA_ETH)) {
@@ -191,11 +302,20 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
                         CHECK_PIN_VALIDATED()
                         handleSign(flags, tx, rx);
                         break;
+                    case INS_SIGN_BATCH: {
+                        CHECK_PIN_VALIDATED()
+                        if (cla != CLA) {
+                            THROW(APDU_CODE_COMMAND_NOT_ALLOWED);
+                        }
+                        handleSignBatch(flags, tx, rx);
+                        break;
+                    }
                     case INS_SIGN_ETH: {
                         CHECK_PIN_VALIDATED()
                         if (cla != CLA_ETH) {
                             THROW(APDU_CODE_COMMAND_NOT_ALLOWED);
                         }
+                        end_transfer();
                         handleSignEth(flags, tx, rx);
                         break;
                     }
@@ -205,6 +325,7 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
                         if (cla != CLA_ETH) {
                             THROW(APDU_CODE_COMMAND_NOT_ALLOWED);
                         }
+                        end_transfer();
                         handleSignEip191(flags, tx, rx);
                         break;
                     }
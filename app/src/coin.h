@@ -35,6 +35,24 @@ extern "C" {
 
 #define MAX_SIGN_SIZE 256u
 
+// INS_SIGN P2, encoding of the document to sign
+#define P2_SIGN_AMINO_JSON 0x00
+#define P2_SIGN_PROTOBUF_DIRECT 0x01
+
+// INS_SIGN_BATCH: P1 0/1/2 stream each transaction like INS_SIGN, P1_BATCH_REVIEW shows the summary of all of
+// them and P1_BATCH_SIGNATURES reads the signatures once it is approved
+#define INS_SIGN_BATCH 0x03
+#define P1_BATCH_REVIEW 0x03
+#define P1_BATCH_SIGNATURES 0x04
+
+// Transactions signed by one INS_SIGN_BATCH session, and signatures returned per reply
+#if defined(TARGET_NANOS)
+#define BATCH_MAX_TXS 4u
+#else
+#define BATCH_MAX_TXS 16u
+#endif
+#define BATCH_SIGNATURES_PER_REPLY 3u
+
 #define COIN_AMOUNT_DECIMAL_PLACES 6
 #define COIN_TICKER "SEI "
 
@@ -64,6 +82,13 @@ extern "C" {
 #define COIN_DENOM_MAXSIZE 129
 #define COIN_AMOUNT_MAXSIZE 50
 
+// Denoms a transaction can spend and still get totals screens
+#if defined(TARGET_NANOS)
+#define COIN_TOTALS_MAX_DENOMS 1u
+#else
+#define COIN_TOTALS_MAX_DENOMS 4u
+#endif
+
 #ifdef __cplusplus
 }
 #endif
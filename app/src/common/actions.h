@@ -70,6 +70,40 @@ __Z_INLINE void app_sign() {
     }
 }
 
+// Count of signatures in the batch, then the signatures from index first on, as many as fit in one reply
+__Z_INLINE uint16_t app_fill_batch_signatures(uint8_t first) {
+    const uint8_t count = crypto_batchCount();
+    uint16_t len = 0;
+
+    MEMZERO(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE);
+    G_io_apdu_buffer[len++] = count;
+    const uint8_t last = (uint8_t)MIN((uint16_t)first + BATCH_SIGNATURES_PER_REPLY, count);
+    for (uint8_t i = first; i < last; i++) {
+        if (crypto_batchGetSignature(i, G_io_apdu_buffer + len, IO_APDU_BUFFER_SIZE - 2 - len) != zxerr_ok) {
+            MEMZERO(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE);
+            return 0;
+        }
+        len += CRYPTO_SIGNATURE_LEN;
+    }
+    return len;
+}
+
+__Z_INLINE void app_sign_batch() {
+    uint16_t replyLen = 0;
+
+    if (crypto_batchSign() == zxerr_ok) {
+        replyLen = app_fill_batch_signatures(0);
+    }
+
+    if (replyLen == 0) {
+        set_code(G_io_apdu_buffer, 0, APDU_CODE_SIGN_VERIFY_ERROR);
+        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
+    } else {
+        set_code(G_io_apdu_buffer, replyLen, APDU_CODE_OK);
+        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, replyLen + 2);
+    }
+}
+
 __Z_INLINE void app_sign_eip191() {
     const uint8_t *message = tx_get_buffer();
     const uint16_t messageLength = tx_get_buffer_length();
@@ -17,6 +17,7 @@
 #include <os_io_seproxyhal.h>
 
 #include "app_main.h"
+#include "crypto_cache.h"
 #include "view.h"
 
 __attribute__((section(".boot"))) int main(void) {
@@ -28,11 +29,12 @@ __attribute__((section(".boot"))) int main(void) {
 
     BEGIN_TRY {
         TRY {
+            crypto_cache_reset();
             app_init();
             app_main();
         }
         CATCH_OTHER(e) { UNUSED(e); }
-        FINALLY {}
+        FINALLY { crypto_cache_reset(); }
     }
     END_TRY;
 }
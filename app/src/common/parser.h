@@ -27,17 +27,17 @@ const char *parser_getMsgPackTypeDescription(uint8_t type);
 
 parser_error_t parser_init_context(parser_context_t *ctx, const uint8_t *buffer, uint16_t bufferSize);
 
-//// parses a tx buffer
-parser_error_t parser_parse(parser_context_t *ctx, const uint8_t *data, size_t dataLen);
+//// parses a tx buffer into tx_obj, which must outlive every later call made with ctx
+parser_error_t parser_parse(parser_context_t *ctx, const uint8_t *data, size_t dataLen, parser_tx_t *tx_obj);
 
 //// verifies tx fields
 parser_error_t parser_validate(const parser_context_t *ctx);
 
 //// returns the number of items in the current parsing context
-parser_error_t parser_getNumItems(const parser_context_t *ctx, uint8_t *num_items);
+parser_error_t parser_getNumItems(const parser_context_t *ctx, uint16_t *num_items);
 
 // retrieves a readable output for each field / page
-parser_error_t parser_getItem(const parser_context_t *ctx, uint8_t displayIdx, char *outKey, uint16_t outKeyLen,
+parser_error_t parser_getItem(const parser_context_t *ctx, uint16_t displayIdx, char *outKey, uint16_t outKeyLen,
                               char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount);
 
 #ifdef __cplusplus
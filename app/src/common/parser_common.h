@@ -29,6 +29,10 @@ extern "C" {
         if (__err != parser_ok) return __err; \
     }
 
+// Key and value sizes the validators render every item into to check it can be shown
+#define VALIDATE_KEY_SIZE 40
+#define VALIDATE_VALUE_SIZE 40
+
 typedef enum {
     // Generic errors
     parser_ok = 0,
@@ -73,6 +77,14 @@ typedef enum {
     parser_invalid_rs_values,
     parser_invalid_chain_id,
     parser_blindsign_mode_required,
+
+    // Batch signing
+    parser_batch_unsupported_tx,
+    parser_batch_mismatch,
+    parser_batch_full,
+
+    // Display
+    parser_display_key_too_long,
 } parser_error_t;
 
 #ifdef __cplusplus
@@ -19,8 +19,14 @@
 #include <string.h>
 
 #include "apdu_codes.h"
+#include "app_mode.h"
 #include "buffering.h"
+#include "item_cache.h"
 #include "parser.h"
+#include "parser_batch.h"
+#include "parser_impl_evm.h"
+#include "parser_impl_pb.h"
+#include "scratch.h"
 #include "zxmacros.h"
 
 #if defined(TARGET_NANOS2) || defined(TARGET_STAX) || defined(TARGET_FLEX)
@@ -32,10 +38,29 @@
 #elif defined(TARGET_NANOS)
 #define RAM_BUFFER_SIZE 256
 #define FLASH_BUFFER_SIZE 8192
+#else
+// Host builds (APDU simulator) use the Nano S+ sizes
+#define RAM_BUFFER_SIZE 8192
+#define FLASH_BUFFER_SIZE 16384
 #endif
 
+// Parser state of the transaction being signed, only one signing mode is active at a time
+typedef union {
+    parser_tx_t cosmos;
+    pb_tx_t pb;
+    eth_tx_t eth;
+} tx_state_storage_t;
+
+// What separate states took on top of the shared storage, the RAM buffer gets it
+#define TX_STATE_RECLAIMED (sizeof(parser_tx_t) + sizeof(pb_tx_t) + sizeof(eth_tx_t) - sizeof(tx_state_storage_t))
+
+static struct {
+    tx_state_e mode;
+    tx_state_storage_t storage;
+} tx_state;
+
 // Ram
-uint8_t ram_buffer[RAM_BUFFER_SIZE];
+uint8_t ram_buffer[RAM_BUFFER_SIZE + TX_STATE_RECLAIMED];
 
 // Flash
 typedef struct {
@@ -45,12 +70,36 @@ typedef struct {
 #if defined(TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2) || defined(TARGET_STAX) || defined(TARGET_FLEX)
 storage_t NV_CONST N_appdata_impl __attribute__((aligned(64)));
 #define N_appdata (*(NV_VOLATILE storage_t *)PIC(&N_appdata_impl))
+#else
+static storage_t N_appdata;
 #endif
 
 static parser_context_t ctx_parsed_tx;
+static parser_batch_t batch_obj;
 
 void tx_initialize() {
     buffering_init(ram_buffer, sizeof(ram_buffer), (uint8_t *)N_appdata.buffer, sizeof(N_appdata.buffer));
+    tx_state.mode = tx_state_none;
+}
+
+void *tx_state_acquire(tx_state_e mode, size_t size) {
+    if (mode == tx_state_none || size > sizeof(tx_state.storage)) {
+        return NULL;
+    }
+    MEMZERO(&tx_state.storage, sizeof(tx_state.storage));
+    tx_state.mode = mode;
+    return &tx_state.storage;
+}
+
+bool tx_state_check(tx_state_e mode) {
+    if (tx_state.mode == mode) {
+        return true;
+    }
+#if defined(APP_TESTING)
+    zemu_log("tx_state: parser state used by another mode\n");
+    THROW(APDU_CODE_EXECUTION_ERROR);
+#endif
+    return false;
 }
 
 void tx_reset() { buffering_reset(); }
@@ -62,7 +111,13 @@ uint32_t tx_get_buffer_length() { return buffering_get_buffer()->pos; }
 uint8_t *tx_get_buffer() { return buffering_get_buffer()->data; }
 
 const char *tx_parse() {
-    uint8_t err = parser_parse(&ctx_parsed_tx, tx_get_buffer(), tx_get_buffer_length());
+    item_cache_reset();
+    scratch_reset();
+    parser_tx_t *parser_tx_obj = tx_state_acquire(tx_state_cosmos, sizeof(parser_tx_t));
+    if (parser_tx_obj == NULL) {
+        return parser_getErrorDescription(parser_unexpected_error);
+    }
+    uint8_t err = parser_parse(&ctx_parsed_tx, tx_get_buffer(), tx_get_buffer_length(), parser_tx_obj);
 
     CHECK_APP_CANARY()
 
@@ -77,10 +132,23 @@ const char *tx_parse() {
         return parser_getErrorDescription(err);
     }
 
+    // Refuse what the review cannot reach instead of letting the view index wrap around
+    uint16_t numItems = 0;
+    err = parser_getNumItems(&ctx_parsed_tx, &numItems);
+    if (err != parser_ok) {
+        return parser_getErrorDescription(err);
+    }
+    if (numItems > TX_VIEW_MAX_ITEMS) {
+        return parser_getErrorDescription(parser_transaction_too_big);
+    }
+
     return NULL;
 }
 
-zxerr_t tx_getNumItems(uint8_t *num_items) {
+zxerr_t tx_getNumItems(uint16_t *num_items) {
+    if (!tx_state_check(tx_state_cosmos)) {
+        return zxerr_unknown;
+    }
     parser_error_t err = parser_getNumItems(&ctx_parsed_tx, num_items);
 
     if (err != parser_ok) {
@@ -90,18 +158,84 @@ zxerr_t tx_getNumItems(uint8_t *num_items) {
     return zxerr_ok;
 }
 
-zxerr_t tx_getItem(int8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal, uint16_t outValLen, uint8_t pageIdx,
+zxerr_t tx_getItem(int16_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal, uint16_t outValLen, uint8_t pageIdx,
                    uint8_t *pageCount) {
-    uint8_t numItems = 0;
+    uint16_t numItems = 0;
 
     CHECK_ZXERR(tx_getNumItems(&numItems))
 
-    if (displayIdx > numItems) {
+    if (displayIdx < 0 || displayIdx > numItems) {
         return zxerr_no_data;
     }
 
+    const bool expert = app_mode_expert();
+    if (item_cache_lookup((uint16_t)displayIdx, expert, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount)) {
+        return zxerr_ok;
+    }
+
+    scratch_reset();
     parser_error_t err =
-        parser_getItem(&ctx_parsed_tx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+        parser_getItem(&ctx_parsed_tx, (uint16_t)displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+
+    // Convert error codes
+    if (err == parser_no_data || err == parser_display_idx_out_of_range || err == parser_display_page_out_of_range)
+        return zxerr_no_data;
+
+    if (err != parser_ok) return zxerr_unknown;
+
+    item_cache_store((uint16_t)displayIdx, expert, outKey, outVal, outValLen, pageIdx, *pageCount);
+    return zxerr_ok;
+}
+
+zxerr_t tx_view_getNumItems(uint8_t *num_items) {
+    uint16_t numItems = 0;
+    CHECK_ZXERR(tx_getNumItems(&numItems))
+    if (numItems > TX_VIEW_MAX_ITEMS) {
+        return zxerr_out_of_bounds;
+    }
+    *num_items = (uint8_t)numItems;
+    return zxerr_ok;
+}
+
+zxerr_t tx_view_getItem(int8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal, uint16_t outValLen,
+                        uint8_t pageIdx, uint8_t *pageCount) {
+    return tx_getItem(displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+}
+
+void tx_batch_init() { parser_batch_init(&batch_obj); }
+
+const char *tx_batch_add() {
+    const char *error_msg = tx_parse();
+    if (error_msg != NULL) {
+        return error_msg;
+    }
+
+    const parser_error_t err = parser_batch_add(&batch_obj, &ctx_parsed_tx);
+    CHECK_APP_CANARY()
+
+    if (err != parser_ok) {
+        return parser_getErrorDescription(err);
+    }
+
+    return NULL;
+}
+
+zxerr_t tx_batch_getNumItems(uint8_t *num_items) {
+    if (parser_batch_getNumItems(&batch_obj, num_items) != parser_ok) {
+        return zxerr_unknown;
+    }
+    return zxerr_ok;
+}
+
+zxerr_t tx_batch_getItem(int8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal, uint16_t outValLen,
+                         uint8_t pageIdx, uint8_t *pageCount) {
+    if (displayIdx < 0) {
+        return zxerr_no_data;
+    }
+
+    scratch_reset();
+    const parser_error_t err =
+        parser_batch_getItem(&batch_obj, (uint8_t)displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
 
     // Convert error codes
     if (err == parser_no_data || err == parser_display_idx_out_of_range || err == parser_display_page_out_of_range)
@@ -15,12 +15,31 @@
  ********************************************************************************/
 #pragma once
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #include "coin.h"
 #include "os.h"
 #include "zxerror.h"
 
+/// Parser states, one storage holds the state of the transaction parsed last
+typedef enum {
+    tx_state_none = 0,
+    tx_state_cosmos,
+    tx_state_pb,
+    tx_state_eth,
+} tx_state_e;
+
+/// Sets up the transaction buffer and releases the parser state for the next transaction
 void tx_initialize();
 
+/// Clears the parser state storage and hands it to mode
+/// \return It returns NULL if a state of size does not fit.
+void *tx_state_acquire(tx_state_e mode, size_t size);
+
+/// Whether the parser state storage holds a state of mode. Debug builds stop when it does not.
+bool tx_state_check(tx_state_e mode);
+
 /// Clears the transaction buffer
 void tx_reset();
 
@@ -45,8 +64,32 @@ uint8_t *tx_get_buffer();
 const char *tx_parse();
 
 /// Return the number of items in the transaction
-zxerr_t tx_getNumItems(uint8_t *num_items);
+zxerr_t tx_getNumItems(uint16_t *num_items);
 
 /// Gets an specific item from the transaction (including paging)
-zxerr_t tx_getItem(int8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outValue, uint16_t outValueLen,
+zxerr_t tx_getItem(int16_t displayIdx, char *outKey, uint16_t outKeyLen, char *outValue, uint16_t outValueLen,
                    uint8_t pageIdx, uint8_t *pageCount);
+
+/// The review addresses items with an int8_t index, tx_parse refuses transactions with more items
+#define TX_VIEW_MAX_ITEMS 128
+
+/// Same as tx_getNumItems with the count type of the review
+zxerr_t tx_view_getNumItems(uint8_t *num_items);
+
+/// Same as tx_getItem with the index type of the review
+zxerr_t tx_view_getItem(int8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outValue, uint16_t outValueLen,
+                        uint8_t pageIdx, uint8_t *pageCount);
+
+/// Starts an empty batch
+void tx_batch_init();
+
+/// Parses the transaction in the buffer and adds it to the batch
+/// \return It returns NULL if the transaction was added or error message otherwise.
+const char *tx_batch_add();
+
+/// Return the number of items in the batch summary
+zxerr_t tx_batch_getNumItems(uint8_t *num_items);
+
+/// Gets an specific item from the batch summary (including paging)
+zxerr_t tx_batch_getItem(int8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outValue, uint16_t outValueLen,
+                         uint8_t pageIdx, uint8_t *pageCount);
@@ -17,6 +17,7 @@
 #include "crypto.h"
 
 #include "coin.h"
+#include "crypto_cache.h"
 #include "crypto_helper.h"
 #include "cx.h"
 #include "tx.h"
@@ -25,30 +26,36 @@
 uint32_t hdPath[HDPATH_LEN_DEFAULT];
 uint32_t hdPath_len;
 
-zxerr_t crypto_sha256(const uint8_t *input, uint16_t inputLen, uint8_t *output, uint16_t outputLen) {
-    if (input == NULL || output == NULL || outputLen < CX_SHA256_SIZE) {
-        return zxerr_encoding_failed;
-    }
-
-    MEMZERO(output, outputLen);
-
-    cx_sha256_t ctx;
-    memset(&ctx, 0, sizeof(ctx));
-    cx_sha256_init_no_throw(&ctx);
-    CHECK_CX_OK(cx_hash_no_throw(&ctx.header, CX_LAST, input, inputLen, output, CX_SHA256_SIZE));
+// Running digest of the transaction being received, fed chunk by chunk
+static cx_sha256_t tx_digest_ctx;
+static uint8_t tx_digest[CX_SHA256_SIZE];
+static bool tx_digest_ready = false;
 
+zxerr_t crypto_txDigestInit() {
+    tx_digest_ready = false;
+    MEMZERO(tx_digest, sizeof(tx_digest));
+    MEMZERO(&tx_digest_ctx, sizeof(tx_digest_ctx));
+    CHECK_CX_OK(cx_sha256_init_no_throw(&tx_digest_ctx));
     return zxerr_ok;
 }
 
-zxerr_t ripemd160_32(uint8_t *out, uint8_t *in) {
-    if (out == NULL || in == NULL) {
+zxerr_t crypto_txDigestUpdate(const uint8_t *input, uint16_t inputLen) {
+    if (input == NULL || tx_digest_ready) {
         return zxerr_invalid_crypto_settings;
     }
+    if (inputLen == 0) {
+        return zxerr_ok;
+    }
+    CHECK_CX_OK(cx_hash_no_throw(&tx_digest_ctx.header, 0, input, inputLen, NULL, 0));
+    return zxerr_ok;
+}
 
-    cx_ripemd160_t rip160 = {0};
-    cx_ripemd160_init(&rip160);
-    CHECK_CX_OK(cx_hash_no_throw(&rip160.header, CX_LAST, in, CX_SHA256_SIZE, out, CX_RIPEMD160_SIZE));
-
+zxerr_t crypto_txDigestFinalize() {
+    if (tx_digest_ready) {
+        return zxerr_invalid_crypto_settings;
+    }
+    CHECK_CX_OK(cx_hash_no_throw(&tx_digest_ctx.header, CX_LAST, NULL, 0, tx_digest, CX_SHA256_SIZE));
+    tx_digest_ready = true;
     return zxerr_ok;
 }
 
@@ -57,19 +64,26 @@ static zxerr_t crypto_extractUncompressedPublicKey(uint8_t *pubKey, uint16_t pub
         return zxerr_invalid_crypto_settings;
     }
 
+    // Public keys already derived in this session are served from the cache
+    if (crypto_cache_lookup(hdPath, HDPATH_LEN_DEFAULT, pubKey, pubKeyLen, NULL, 0)) {
+        return zxerr_ok;
+    }
+
     cx_ecfp_public_key_t cx_publicKey = {0};
     cx_ecfp_private_key_t cx_privateKey = {0};
     uint8_t privateKeyData[64] = {0};
+    uint8_t chainCode[CRYPTO_CACHE_CHAIN_CODE_LEN] = {0};
 
     zxerr_t error = zxerr_unknown;
     // Generate keys
     CATCH_CXERROR(os_derive_bip32_with_seed_no_throw(HDW_NORMAL, CX_CURVE_256K1, hdPath, HDPATH_LEN_DEFAULT, privateKeyData,
-                                                     NULL, NULL, 0));
+                                                     chainCode, NULL, 0));
 
     CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_256K1, privateKeyData, 32, &cx_privateKey));
     CATCH_CXERROR(cx_ecfp_init_public_key_no_throw(CX_CURVE_256K1, NULL, 0, &cx_publicKey));
     CATCH_CXERROR(cx_ecfp_generate_pair_no_throw(CX_CURVE_256K1, &cx_publicKey, &cx_privateKey, 1));
     memcpy(pubKey, cx_publicKey.W, PK_LEN_SECP256K1_UNCOMPRESSED);
+    crypto_cache_store(hdPath, HDPATH_LEN_DEFAULT, pubKey, chainCode);
     error = zxerr_ok;
 
 catch_cx_error:
@@ -104,23 +118,37 @@ typedef struct {
 
 } __attribute__((packed)) signature_t;
 
+// Signs a SHA-256 digest, the signature is written as R, S, V
+static zxerr_t crypto_signDigest(const cx_ecfp_private_key_t *privateKey, const uint8_t *digest, uint8_t *rsv) {
+    signature_t signature_object = {0};
+    size_t signatureLength = sizeof_field(signature_t, der_signature);
+    unsigned int info = 0;
+
+    CHECK_CX_OK(cx_ecdsa_sign_no_throw(privateKey, CX_RND_RFC6979 | CX_LAST, CX_SHA256, digest, CX_SHA256_SIZE,
+                                       signature_object.der_signature, &signatureLength, &info));
+
+    const err_convert_e err_c = convertDERtoRSV(signature_object.der_signature, info, signature_object.r,
+                                                signature_object.s, &signature_object.v);
+    if (err_c != no_error) {
+        return zxerr_unknown;
+    }
+    MEMCPY(rsv, &signature_object, CRYPTO_SIGNATURE_LEN);
+    return zxerr_ok;
+}
+
 zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, uint16_t *sigSize) {
-    if (signature == NULL || sigSize == NULL) {
+    if (signature == NULL || sigSize == NULL || signatureMaxlen < CRYPTO_SIGNATURE_LEN) {
+        return zxerr_invalid_crypto_settings;
+    }
+    // The digest was computed while the chunks were received
+    if (!tx_digest_ready) {
         return zxerr_invalid_crypto_settings;
     }
     uint8_t messageDigest[CX_SHA256_SIZE] = {0};
-    MEMZERO(messageDigest, sizeof(messageDigest));
-
-    // Get Buffer and Hash it
-    const uint8_t *message = tx_get_buffer();
-    const uint16_t messageLen = tx_get_buffer_length();
-    cx_hash_sha256(message, messageLen, messageDigest, CX_SHA256_SIZE);
+    MEMCPY(messageDigest, tx_digest, sizeof(messageDigest));
 
     cx_ecfp_private_key_t cx_privateKey = {0};
     uint8_t privateKeyData[64] = {0};
-    unsigned int info = 0;
-    uint32_t signatureLength = sizeof_field(signature_t, der_signature);
-    signature_t *const signature_object = (signature_t *)(signature);
     *sigSize = 0;
 
     zxerr_t error = zxerr_unknown;
@@ -131,16 +159,9 @@ zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, uint16_t *sigS
     CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_256K1, privateKeyData, 32, &cx_privateKey));
 
     // Sign
-    CATCH_CXERROR(cx_ecdsa_sign_no_throw(&cx_privateKey, CX_RND_RFC6979 | CX_LAST, CX_SHA256, messageDigest, CX_SHA256_SIZE,
-                                         signature_object->der_signature, &signatureLength, &info));
-
-    const err_convert_e err_c = convertDERtoRSV(signature_object->der_signature, info, signature_object->r,
-                                                signature_object->s, &signature_object->v);
-    if (err_c != no_error) {
-        error = zxerr_unknown;
-    } else {
-        *sigSize = sizeof_field(signature_t, r) + sizeof_field(signature_t, s) + sizeof_field(signature_t, v);
-        error = zxerr_ok;
+    error = crypto_signDigest(&cx_privateKey, messageDigest, signature);
+    if (error == zxerr_ok) {
+        *sigSize = CRYPTO_SIGNATURE_LEN;
     }
 
 catch_cx_error:
@@ -152,6 +173,85 @@ catch_cx_error:
     return error;
 }
 
+// Transactions of the current batch. A slot holds the digest of its transaction until the batch is signed, and the
+// signature afterwards
+typedef union {
+    uint8_t digest[CX_SHA256_SIZE];
+    uint8_t signature[CRYPTO_SIGNATURE_LEN];
+} batch_slot_t;
+
+static batch_slot_t batch_slots[BATCH_MAX_TXS];
+static uint8_t batch_count = 0;
+static bool batch_signed = false;
+// Path given when the batch started, other commands may change hdPath before it is signed
+static uint32_t batch_path[HDPATH_LEN_DEFAULT];
+
+zxerr_t crypto_batchInit() {
+    MEMZERO(batch_slots, sizeof(batch_slots));
+    batch_count = 0;
+    batch_signed = false;
+    if (hdPath_len != HDPATH_LEN_DEFAULT) {
+        return zxerr_invalid_crypto_settings;
+    }
+    MEMCPY(batch_path, hdPath, sizeof(batch_path));
+    return zxerr_ok;
+}
+
+zxerr_t crypto_batchAddDigest() {
+    if (!tx_digest_ready || batch_signed || batch_count >= BATCH_MAX_TXS) {
+        return zxerr_invalid_crypto_settings;
+    }
+    MEMCPY(batch_slots[batch_count].digest, tx_digest, CX_SHA256_SIZE);
+    batch_count++;
+    return zxerr_ok;
+}
+
+uint8_t crypto_batchCount() { return batch_count; }
+
+zxerr_t crypto_batchSign() {
+    if (batch_count == 0 || batch_signed) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    cx_ecfp_private_key_t cx_privateKey = {0};
+    uint8_t privateKeyData[64] = {0};
+    uint8_t messageDigest[CX_SHA256_SIZE] = {0};
+
+    zxerr_t error = zxerr_unknown;
+
+    // The key is derived once for the whole batch
+    CATCH_CXERROR(os_derive_bip32_with_seed_no_throw(HDW_NORMAL, CX_CURVE_256K1, batch_path, HDPATH_LEN_DEFAULT,
+                                                     privateKeyData, NULL, NULL, 0));
+    CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_256K1, privateKeyData, 32, &cx_privateKey));
+
+    for (uint8_t i = 0; i < batch_count; i++) {
+        MEMCPY(messageDigest, batch_slots[i].digest, sizeof(messageDigest));
+        error = crypto_signDigest(&cx_privateKey, messageDigest, batch_slots[i].signature);
+        if (error != zxerr_ok) {
+            break;
+        }
+    }
+
+catch_cx_error:
+    MEMZERO(&cx_privateKey, sizeof(cx_privateKey));
+    MEMZERO(privateKeyData, sizeof(privateKeyData));
+    if (error != zxerr_ok) {
+        MEMZERO(batch_slots, sizeof(batch_slots));
+        batch_count = 0;
+        return error;
+    }
+    batch_signed = true;
+    return zxerr_ok;
+}
+
+zxerr_t crypto_batchGetSignature(uint8_t index, uint8_t *signature, uint16_t signatureMaxlen) {
+    if (signature == NULL || signatureMaxlen < CRYPTO_SIGNATURE_LEN || !batch_signed || index >= batch_count) {
+        return zxerr_invalid_crypto_settings;
+    }
+    MEMCPY(signature, batch_slots[index].signature, CRYPTO_SIGNATURE_LEN);
+    return zxerr_ok;
+}
+
 zxerr_t crypto_fillAddress(uint8_t *buffer, uint16_t bufferLen, uint16_t *addrResponseLen) {
     if (bufferLen < PK_LEN_SECP256K1 + SECP256K1_ADDR_MAX_LEN) {
         return zxerr_buffer_too_small;
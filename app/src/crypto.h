@@ -31,8 +31,24 @@ extern uint32_t hdPath_len;
 
 zxerr_t crypto_fillAddress(uint8_t *buffer, uint16_t bufferLen, uint16_t *addrResponseLen);
 
+// Signatures are R (32), S (32) and V (1)
+#define CRYPTO_SIGNATURE_LEN 65u
+
 zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, uint16_t *sigSize);
 
+// Batch signing: the digest of every accepted transaction is kept under the path in hdPath when the batch starts,
+// and all of them are signed in one pass once the batch is approved
+zxerr_t crypto_batchInit();
+zxerr_t crypto_batchAddDigest();
+uint8_t crypto_batchCount();
+zxerr_t crypto_batchSign();
+zxerr_t crypto_batchGetSignature(uint8_t index, uint8_t *signature, uint16_t signatureMaxlen);
+
+// Incremental SHA-256 over the transaction chunks, consumed by crypto_sign
+zxerr_t crypto_txDigestInit();
+zxerr_t crypto_txDigestUpdate(const uint8_t *input, uint16_t inputLen);
+zxerr_t crypto_txDigestFinalize();
+
 zxerr_t crypto_sha256(const uint8_t *input, uint16_t inputLen, uint8_t *output, uint16_t outputLen);
 
 zxerr_t ripemd160_32(uint8_t *out, uint8_t *in);
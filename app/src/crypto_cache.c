@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include "crypto_cache.h"
+
+#include <string.h>
+
+#include "zxmacros.h"
+
+typedef struct {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    uint8_t pathLen;
+    // 0 means the slot is empty, higher values were used more recently
+    uint32_t lastUsed;
+    uint8_t pubKey[PK_LEN_SECP256K1_UNCOMPRESSED];
+    uint8_t chainCode[CRYPTO_CACHE_CHAIN_CODE_LEN];
+} crypto_cache_entry_t;
+
+static crypto_cache_entry_t cache_entries[CRYPTO_CACHE_ENTRIES];
+static uint32_t cache_clock = 0;
+
+void crypto_cache_reset(void) {
+    MEMZERO(cache_entries, sizeof(cache_entries));
+    cache_clock = 0;
+}
+
+static crypto_cache_entry_t *crypto_cache_find(const uint32_t *path, uint8_t pathLen) {
+    if (path == NULL || pathLen == 0 || pathLen > HDPATH_LEN_DEFAULT) {
+        return NULL;
+    }
+
+    for (uint8_t i = 0; i < CRYPTO_CACHE_ENTRIES; i++) {
+        crypto_cache_entry_t *entry = &cache_entries[i];
+        if (entry->lastUsed != 0 && entry->pathLen == pathLen &&
+            memcmp(entry->path, path, pathLen * sizeof(uint32_t)) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static uint32_t crypto_cache_tick(void) {
+    cache_clock++;
+    if (cache_clock == 0) {
+        // The counter wrapped around; start a fresh session rather than
+        // mixing up the eviction order
+        crypto_cache_reset();
+        cache_clock = 1;
+    }
+    return cache_clock;
+}
+
+bool crypto_cache_lookup(const uint32_t *path, uint8_t pathLen, uint8_t *pubKey, uint16_t pubKeyLen, uint8_t *chainCode,
+                         uint16_t chainCodeLen) {
+    if (pubKey == NULL || pubKeyLen < PK_LEN_SECP256K1_UNCOMPRESSED) {
+        return false;
+    }
+    if (chainCode != NULL && chainCodeLen < CRYPTO_CACHE_CHAIN_CODE_LEN) {
+        return false;
+    }
+
+    crypto_cache_entry_t *entry = crypto_cache_find(path, pathLen);
+    if (entry == NULL) {
+        return false;
+    }
+
+    MEMCPY(pubKey, entry->pubKey, PK_LEN_SECP256K1_UNCOMPRESSED);
+    if (chainCode != NULL) {
+        MEMCPY(chainCode, entry->chainCode, CRYPTO_CACHE_CHAIN_CODE_LEN);
+    }
+    entry->lastUsed = crypto_cache_tick();
+    return true;
+}
+
+void crypto_cache_store(const uint32_t *path, uint8_t pathLen, const uint8_t *pubKey, const uint8_t *chainCode) {
+    if (path == NULL || pubKey == NULL || chainCode == NULL || pathLen == 0 || pathLen > HDPATH_LEN_DEFAULT) {
+        return;
+    }
+
+    crypto_cache_entry_t *entry = crypto_cache_find(path, pathLen);
+    if (entry == NULL) {
+        // Pick an empty slot or the least recently used one
+        entry = &cache_entries[0];
+        for (uint8_t i = 1; i < CRYPTO_CACHE_ENTRIES && entry->lastUsed != 0; i++) {
+            if (cache_entries[i].lastUsed < entry->lastUsed) {
+                entry = &cache_entries[i];
+            }
+        }
+    }
+
+    const uint32_t now = crypto_cache_tick();
+    MEMZERO(entry, sizeof(*entry));
+    MEMCPY(entry->path, path, pathLen * sizeof(uint32_t));
+    entry->pathLen = pathLen;
+    MEMCPY(entry->pubKey, pubKey, PK_LEN_SECP256K1_UNCOMPRESSED);
+    MEMCPY(entry->chainCode, chainCode, CRYPTO_CACHE_CHAIN_CODE_LEN);
+    entry->lastUsed = now;
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "coin.h"
+
+// Session cache of derived public material.
+// Entries hold ONLY the uncompressed public key and the BIP32 chain code of a
+// derivation path. Private keys are never stored here.
+#define CRYPTO_CACHE_ENTRIES 4u
+#define CRYPTO_CACHE_CHAIN_CODE_LEN 32u
+
+// Drops every cached entry. Called on app start and whenever the device is
+// found locked, so keys of a previous seed/PIN session are never served.
+void crypto_cache_reset(void);
+
+// Copies the cached public key (and chain code, when requested) for the given path.
+// Returns false on a cache miss, leaving the output buffers untouched.
+bool crypto_cache_lookup(const uint32_t *path, uint8_t pathLen, uint8_t *pubKey, uint16_t pubKeyLen, uint8_t *chainCode,
+                         uint16_t chainCodeLen);
+
+// Stores the public key and chain code derived for the given path, evicting the
+// least recently used entry when the cache is full.
+void crypto_cache_store(const uint32_t *path, uint8_t pathLen, const uint8_t *pubKey, const uint8_t *chainCode);
+
+#ifdef __cplusplus
+}
+#endif
@@ -19,8 +19,69 @@
 #include "coin.h"
 #include "crypto.h"
 #include "zxformat.h"
+#include "zxmacros.h"
+
+#if defined(LEDGER_SPECIFIC)
+#include "cx.h"
+#else
+#include "host_hash.h"
 #define CX_SHA256_SIZE 32
 #define CX_RIPEMD160_SIZE 20
+#endif
+
+zxerr_t crypto_sha256(const uint8_t *input, uint16_t inputLen, uint8_t *output, uint16_t outputLen) {
+    if (input == NULL || output == NULL || outputLen < CX_SHA256_SIZE) {
+        return zxerr_encoding_failed;
+    }
+
+    MEMZERO(output, outputLen);
+
+#if defined(LEDGER_SPECIFIC)
+    cx_sha256_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    cx_sha256_init_no_throw(&ctx);
+    CHECK_CX_OK(cx_hash_no_throw(&ctx.header, CX_LAST, input, inputLen, output, CX_SHA256_SIZE));
+#else
+    host_sha256(input, inputLen, output);
+#endif
+
+    return zxerr_ok;
+}
+
+zxerr_t ripemd160_32(uint8_t *out, uint8_t *in) {
+    if (out == NULL || in == NULL) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+#if defined(LEDGER_SPECIFIC)
+    cx_ripemd160_t rip160 = {0};
+    cx_ripemd160_init(&rip160);
+    CHECK_CX_OK(cx_hash_no_throw(&rip160.header, CX_LAST, in, CX_SHA256_SIZE, out, CX_RIPEMD160_SIZE));
+#else
+    host_ripemd160(in, CX_SHA256_SIZE, out);
+#endif
+
+    return zxerr_ok;
+}
+
+zxerr_t keccak_digest(const unsigned char *in, unsigned int inLen, unsigned char *out, unsigned int outLen) {
+    if (in == NULL || out == NULL || inLen == 0 || outLen == 0) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+#if defined(LEDGER_SPECIFIC)
+    // return actual size using value from signatureLength
+    cx_sha3_t keccak;
+    CHECK_CX_OK(cx_keccak_init_no_throw(&keccak, outLen * 8));
+    CHECK_CX_OK(cx_hash_no_throw((cx_hash_t *)&keccak, CX_LAST, in, inLen, out, outLen));
+#else
+    if (outLen != HOST_KECCAK256_SIZE) {
+        return zxerr_invalid_crypto_settings;
+    }
+    host_keccak256(in, inLen, out);
+#endif
+    return zxerr_ok;
+}
 
 uint8_t crypto_encodePubkey(const uint8_t *pubkey, char *out, uint16_t out_len) {
     if (pubkey == NULL || out == NULL) {
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "denom_registry.h"
+
+#include <string.h>
+#include <zxmacros.h>
+
+#include "coin.h"
+
+#define FNV_OFFSET_BASIS 0x811C9DC5u
+#define FNV_PRIME 0x01000193u
+
+// Generated by scripts/gen_denom_registry.py from the traces IBC denoms arrive through on Sei, an entry for the
+// wrong channel would show another asset under a known symbol
+static const denom_info_t denom_registry[] = {
+#include "denom_registry_entries.h"
+};
+
+uint32_t denom_registry_hash(const char *denom, uint16_t denomLen) {
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (uint16_t i = 0; i < denomLen; i++) {
+        hash ^= (uint8_t)denom[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+const denom_info_t *denom_registry_lookup(const char *denom, uint16_t denomLen) {
+    if (denom == NULL || denomLen == 0 || denomLen >= COIN_DENOM_MAXSIZE) {
+        return NULL;
+    }
+
+    const uint32_t hash = denom_registry_hash(denom, denomLen);
+
+    // Lower bound of hash, entries sharing it are compared by name
+    uint16_t lo = 0;
+    uint16_t hi = array_length(denom_registry);
+    while (lo < hi) {
+        const uint16_t mid = lo + (hi - lo) / 2;
+        if (denom_registry[mid].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    for (; lo < array_length(denom_registry) && denom_registry[lo].hash == hash; lo++) {
+        const denom_info_t *info = &denom_registry[lo];
+        const char *base = (const char *)PIC(info->base);
+        if (strlen(base) == denomLen && memcmp(base, denom, denomLen) == 0) {
+            return info;
+        }
+    }
+    return NULL;
+}
+
+uint16_t denom_registry_size(void) { return array_length(denom_registry); }
+
+const denom_info_t *denom_registry_get(uint16_t idx) {
+    if (idx >= array_length(denom_registry)) {
+        return NULL;
+    }
+    return &denom_registry[idx];
+}
@@ -0,0 +1,46 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// Display metadata of a coin denom: amounts in base are shown divided by 10^exponent and followed by symbol
+typedef struct {
+    // denom_registry_hash of base, the registry is sorted by it
+    uint32_t hash;
+    // Strings are link time addresses, read them through PIC
+    const char *base;
+    const char *symbol;
+    uint8_t exponent;
+} denom_info_t;
+
+// 32-bit FNV-1a of the denom bytes
+uint32_t denom_registry_hash(const char *denom, uint16_t denomLen);
+
+// Returns the metadata of denom[0..denomLen) or NULL when it is not registered
+const denom_info_t *denom_registry_lookup(const char *denom, uint16_t denomLen);
+
+// Registry entries, exposed so their order and hashes can be checked
+uint16_t denom_registry_size(void);
+const denom_info_t *denom_registry_get(uint16_t idx);
+
+#ifdef __cplusplus
+}
+#endif
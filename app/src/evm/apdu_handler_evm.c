@@ -133,7 +133,21 @@ bool process_chunk_eip191(__Z_UNUSED volatile uint32_t *tx, uint32_t rx) {
     THROW(APDU_CODE_INVALIDP1P2);
 }
 
-bool process_chunk_eth(__Z_UNUSED volatile uint32_t *tx, uint32_t rx) {
+// Refuses a transaction as soon as the received part shows it can't be signed,
+// instead of after the last chunk
+static void precheck_chunk_eth(volatile uint32_t *tx, const uint8_t *data, uint32_t len) {
+    const char *error_msg = tx_precheck_eth(data, len);
+    if (error_msg == NULL) {
+        return;
+    }
+    tx_initialized = false;
+    const int error_msg_length = strnlen(error_msg, sizeof(G_io_apdu_buffer));
+    MEMCPY(G_io_apdu_buffer, error_msg, error_msg_length);
+    *tx += (error_msg_length);
+    THROW(APDU_CODE_DATA_INVALID);
+}
+
+bool process_chunk_eth(volatile uint32_t *tx, uint32_t rx) {
     const uint8_t payloadType = G_io_apdu_buffer[OFFSET_PAYLOAD_TYPE];
 
     if (G_io_apdu_buffer[OFFSET_P2] != 0) {
@@ -171,6 +185,7 @@ bool process_chunk_eth(__Z_UNUSED volatile uint32_t *tx, uint32_t rx) {
 
             // now process the chunk
             len -= path_len + 1;
+            precheck_chunk_eth(tx, data, len);
             if (get_tx_rlp_len(data, len, &read, &to_read) != rlp_ok) {
                 THROW(APDU_CODE_DATA_INVALID);
             }
@@ -226,6 +241,7 @@ bool process_chunk_eth(__Z_UNUSED volatile uint32_t *tx, uint32_t rx) {
                 return true;
             }
 
+            precheck_chunk_eth(tx, tx_get_buffer(), tx_get_buffer_length());
             return false;
     }
     THROW(APDU_CODE_INVALIDP1P2);
@@ -17,6 +17,8 @@
 #include "crypto_evm.h"
 
 #include "coin_evm.h"
+#include "crypto_cache.h"
+#include "crypto_helper.h"
 #include "cx.h"
 #include "tx_evm.h"
 #include "zxformat.h"
@@ -50,38 +52,34 @@ typedef struct {
 
 } __attribute__((packed)) answer_eth_t;
 
-zxerr_t keccak_digest(const unsigned char *in, unsigned int inLen, unsigned char *out, unsigned int outLen) {
-    if (in == NULL || out == NULL || inLen == 0 || outLen == 0) {
-        return zxerr_invalid_crypto_settings;
-    }
-
-#if defined(LEDGER_SPECIFIC)
-    // return actual size using value from signatureLength
-    cx_sha3_t keccak;
-    CHECK_CX_OK(cx_keccak_init_no_throw(&keccak, outLen * 8));
-    CHECK_CX_OK(cx_hash_no_throw((cx_hash_t *)&keccak, CX_LAST, in, inLen, out, outLen));
-#endif
-    return zxerr_ok;
-}
-
 zxerr_t crypto_extractUncompressedPublicKey(uint8_t *pubKey, uint16_t pubKeyLen, uint8_t *chainCode) {
     if (pubKey == NULL || pubKeyLen < PK_LEN_SECP256K1_UNCOMPRESSED) {
         return zxerr_invalid_crypto_settings;
     }
+    // Public keys already derived in this session are served from the cache
+    if (crypto_cache_lookup(hdPathEth, hdPathEth_len, pubKey, pubKeyLen, chainCode, CRYPTO_CACHE_CHAIN_CODE_LEN)) {
+        return zxerr_ok;
+    }
+
     cx_ecfp_public_key_t cx_publicKey;
     cx_ecfp_private_key_t cx_privateKey;
     uint8_t privateKeyData[SK_LEN_25519] = {0};
+    uint8_t derivedChainCode[CRYPTO_CACHE_CHAIN_CODE_LEN] = {0};
 
     zxerr_t error = zxerr_unknown;
 
     // Generate keys
     CATCH_CXERROR(os_derive_bip32_with_seed_no_throw(HDW_NORMAL, CX_CURVE_256K1, hdPathEth, hdPathEth_len, privateKeyData,
-                                                     chainCode, NULL, 0));
+                                                     derivedChainCode, NULL, 0));
 
     CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_256K1, privateKeyData, 32, &cx_privateKey));
     CATCH_CXERROR(cx_ecfp_init_public_key_no_throw(CX_CURVE_256K1, NULL, 0, &cx_publicKey));
     CATCH_CXERROR(cx_ecfp_generate_pair_no_throw(CX_CURVE_256K1, &cx_publicKey, &cx_privateKey, 1));
     memcpy(pubKey, cx_publicKey.W, PK_LEN_SECP256K1_UNCOMPRESSED);
+    if (chainCode != NULL) {
+        memcpy(chainCode, derivedChainCode, CRYPTO_CACHE_CHAIN_CODE_LEN);
+    }
+    crypto_cache_store(hdPathEth, hdPathEth_len, pubKey, derivedChainCode);
     error = zxerr_ok;
 
 catch_cx_error:
@@ -181,7 +179,7 @@ zxerr_t crypto_fillEthAddress(uint8_t *buffer, uint16_t buffer_len, uint16_t *ad
     answer_eth_t *const answer = (answer_eth_t *)buffer;
 
     CHECK_ZXERR(crypto_extractUncompressedPublicKey(&answer->publicKey[1], sizeof_field(answer_eth_t, publicKey) - 1,
-                                                    &sei_chain_code))
+                                                    answer->chainCode))
 
     answer->publicKey[0] = SECP256K1_PK_LEN;
 
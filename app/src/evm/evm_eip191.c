@@ -26,8 +26,7 @@
 #if defined(LEDGER_SPECIFIC)
 #include "cx.h"
 #else
-#define CX_SHA256_SIZE 32
-#define CX_RIPEMD160_SIZE 20
+#include "host_hash.h"
 #endif
 
 static const char SIGN_MAGIC[] =
@@ -126,7 +125,18 @@ zxerr_t eip191_hash_message(const uint8_t *message, uint16_t messageLen, uint8_t
 
     CHECK_CX_OK(
         cx_hash_no_throw((cx_hash_t *)&sha3, CX_LAST, message + sizeof(uint32_t), messageLen - sizeof(uint32_t), hash, 32));
+#else
+    host_keccak256_t keccak;
+    host_keccak256_init(&keccak);
+    host_keccak256_update(&keccak, (const uint8_t *)SIGN_MAGIC, sizeof(SIGN_MAGIC) - 1);
+
+    uint32_t msg_len = U4BE(message, 0);
+    char len_str[12] = {0};
+    uint32_to_str(len_str, sizeof(len_str), msg_len);
+    host_keccak256_update(&keccak, (const uint8_t *)len_str, strlen(len_str));
 
+    host_keccak256_update(&keccak, message + sizeof(uint32_t), messageLen - sizeof(uint32_t));
+    host_keccak256_final(&keccak, hash);
 #endif
 
     return zxerr_ok;
@@ -67,25 +67,7 @@ parser_error_t printERC20Value(const eth_tx_t *ethObj, char *outVal, uint16_t ou
     parser_context_t tmpCtx = {.buffer = valuePtr, .bufferLen = BIGINT_LENGTH, .offset = 0};
     CHECK_ERROR(readu256BE(&tmpCtx, &value));
 
-    char bufferUI[100] = {0};
-    if (!tostring256(&value, DECIMAL_BASE, bufferUI, sizeof(bufferUI))) {
-        return parser_unexpected_error;
-    }
-
-    // Add symbol, add decimals, page number
-    if (intstr_to_fpstr_inplace(bufferUI, sizeof(bufferUI), decimals) == 0) {
-        return parser_unexpected_value;
-    }
-
-    number_inplace_trimming(bufferUI, 1);
-
-    if (z_str3join(bufferUI, sizeof(bufferUI), NULL, tokenSymbol) != zxerr_ok) {
-        return parser_unexpected_buffer_end;
-    }
-
-    pageString(outVal, outValLen, bufferUI, pageIdx, pageCount);
-
-    return parser_ok;
+    return printUint256FixedPoint(&value, decimals, tokenSymbol, outVal, outValLen, pageIdx, pageCount);
 }
 
 bool validateERC20(eth_tx_t *ethObj) {
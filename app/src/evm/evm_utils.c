@@ -21,6 +21,7 @@
 #include "bignum.h"
 #include "coin_evm.h"
 #include "rlp.h"
+#include "scratch.h"
 #include "zxerror.h"
 #include "zxformat.h"
 
@@ -128,15 +129,21 @@ parser_error_t printRLPNumber(const rlp_t *num, char *outVal, uint16_t outValLen
     }
 
     uint256_t tmpUint256 = {0};
-    char tmpBuffer[100] = {0};
-
     CHECK_ERROR(rlp_readUInt256(num, &tmpUint256));
-    if (!tostring256(&tmpUint256, 10, tmpBuffer, sizeof(tmpBuffer))) {
+
+    const scratch_mark_t mark = scratch_mark();
+    char *tmpBuffer = scratch_alloc(EVM_UI_BUFFER_SIZE);
+    if (tmpBuffer == NULL) {
         return parser_unexpected_error;
     }
-    pageString(outVal, outValLen, tmpBuffer, pageIdx, pageCount);
 
-    return parser_ok;
+    parser_error_t err = parser_unexpected_error;
+    if (tostring256(&tmpUint256, 10, tmpBuffer, EVM_UI_BUFFER_SIZE)) {
+        pageString(outVal, outValLen, tmpBuffer, pageIdx, pageCount);
+        err = parser_ok;
+    }
+    scratch_release(mark);
+    return err;
 }
 
 #define LESS_THAN_64_DIGIT(num_digit) \
@@ -148,6 +155,38 @@ __Z_INLINE bool format_quantity(const uint8_t *num, uint16_t num_len, uint8_t *b
     return bignumBigEndian_bcdprint(bignum, bignumSize, bcd, bcdSize);
 }
 
+// Buffers printBigIntFixedPoint takes from the scratch arena
+typedef struct {
+    char bignum[160];
+    union {
+        // overlapping arrays, do not use at the same time
+        uint8_t bcd[80];
+        char output[160];
+    } overlapped;
+} fixed_point_scratch_t;
+
+static parser_error_t print_fixed_point(fixed_point_scratch_t *tmp, const uint8_t *number, uint16_t number_len,
+                                        char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount,
+                                        uint16_t decimals) {
+    if (!format_quantity(number, number_len, tmp->overlapped.bcd, sizeof(tmp->overlapped.bcd), tmp->bignum,
+                         sizeof(tmp->bignum))) {
+        return parser_unexpected_value;
+    }
+
+    if (fpstr_to_str(tmp->overlapped.output, sizeof(tmp->overlapped.output), tmp->bignum, decimals)) {
+        return parser_unexpected_value;
+    }
+
+    number_inplace_trimming(tmp->overlapped.output, 1);
+
+    if (z_str3join(tmp->overlapped.output, sizeof(tmp->overlapped.output), NULL, SEI_TOKEN_SYMBOL) != zxerr_ok) {
+        return parser_unexpected_buffer_end;
+    }
+
+    pageString(outVal, outValLen, tmp->overlapped.output, pageIdx, pageCount);
+    return parser_ok;
+}
+
 parser_error_t printBigIntFixedPoint(const uint8_t *number, uint16_t number_len, char *outVal, uint16_t outValLen,
                                      uint8_t pageIdx, uint8_t *pageCount, uint16_t decimals) {
     if (number == NULL || outVal == NULL || pageCount == NULL) {
@@ -156,33 +195,54 @@ parser_error_t printBigIntFixedPoint(const uint8_t *number, uint16_t number_len,
 
     LESS_THAN_64_DIGIT(number_len);
 
-    char bignum[160] = {0};
-    union {
-        // overlapping arrays to avoid excessive stack usage. Do not use at the same time
-        uint8_t bcd[80];
-        char output[160];
-    } overlapped;
-
-    MEMZERO(&overlapped, sizeof(overlapped));
+    const scratch_mark_t mark = scratch_mark();
+    fixed_point_scratch_t *tmp = scratch_alloc(sizeof(fixed_point_scratch_t));
+    if (tmp == NULL) {
+        return parser_unexpected_error;
+    }
+    const parser_error_t err = print_fixed_point(tmp, number, number_len, outVal, outValLen, pageIdx, pageCount, decimals);
+    scratch_release(mark);
+    return err;
+}
 
-    if (!format_quantity(number, number_len, overlapped.bcd, sizeof(overlapped.bcd), bignum, sizeof(bignum))) {
-        return parser_unexpected_value;
+static parser_error_t print_uint256_fixed_point(char *bufferUI, uint256_t *value, uint8_t decimals, const char *symbol,
+                                                char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    if (!tostring256(value, DECIMAL_BASE, bufferUI, EVM_UI_BUFFER_SIZE)) {
+        return parser_unexpected_error;
     }
 
-    if (fpstr_to_str(overlapped.output, sizeof(overlapped.output), bignum, decimals)) {
+    // Add symbol, add decimals, page number
+    if (intstr_to_fpstr_inplace(bufferUI, EVM_UI_BUFFER_SIZE, decimals) == 0) {
         return parser_unexpected_value;
     }
 
-    number_inplace_trimming(overlapped.output, 1);
+    number_inplace_trimming(bufferUI, 1);
 
-    if (z_str3join(overlapped.output, sizeof(overlapped.output), NULL, SEI_TOKEN_SYMBOL) != zxerr_ok) {
+    if (z_str3join(bufferUI, EVM_UI_BUFFER_SIZE, NULL, symbol) != zxerr_ok) {
         return parser_unexpected_buffer_end;
     }
 
-    pageString(outVal, outValLen, overlapped.output, pageIdx, pageCount);
+    pageString(outVal, outValLen, bufferUI, pageIdx, pageCount);
     return parser_ok;
 }
 
+parser_error_t printUint256FixedPoint(uint256_t *value, uint8_t decimals, const char *symbol, char *outVal,
+                                      uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    if (value == NULL || symbol == NULL || outVal == NULL || pageCount == NULL) {
+        return parser_unexpected_error;
+    }
+
+    const scratch_mark_t mark = scratch_mark();
+    char *bufferUI = scratch_alloc(EVM_UI_BUFFER_SIZE);
+    if (bufferUI == NULL) {
+        return parser_unexpected_error;
+    }
+    const parser_error_t err =
+        print_uint256_fixed_point(bufferUI, value, decimals, symbol, outVal, outValLen, pageIdx, pageCount);
+    scratch_release(mark);
+    return err;
+}
+
 parser_error_t printEVMAddress(const rlp_t *address, char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
     if (address == NULL || outVal == NULL || address->ptr == NULL || pageCount == NULL || address->rlpLen != ETH_ADDR_LEN) {
         return parser_unexpected_error;
@@ -216,23 +276,5 @@ parser_error_t printEVMMaxFees(const eth_tx_t *ethObj, char *outVal, uint16_t ou
     uint256_t max_fees = {0};
     mul256(&gas_limit, &gas_price, &max_fees);
 
-    char bufferUI[100] = {0};
-    if (!tostring256(&max_fees, DECIMAL_BASE, bufferUI, sizeof(bufferUI))) {
-        return parser_unexpected_error;
-    }
-
-    // Add symbol, add decimals, page number
-    if (intstr_to_fpstr_inplace(bufferUI, sizeof(bufferUI), COIN_DECIMALS) == 0) {
-        return parser_unexpected_value;
-    }
-
-    number_inplace_trimming(bufferUI, 1);
-
-    if (z_str3join(bufferUI, sizeof(bufferUI), NULL, SEI_TOKEN_SYMBOL) != zxerr_ok) {
-        return parser_unexpected_buffer_end;
-    }
-
-    pageString(outVal, outValLen, bufferUI, pageIdx, pageCount);
-
-    return parser_ok;
+    return printUint256FixedPoint(&max_fees, COIN_DECIMALS, SEI_TOKEN_SYMBOL, outVal, outValLen, pageIdx, pageCount);
 }
@@ -36,6 +36,9 @@ typedef enum RlpError {
 
 #define SEI_TOKEN_SYMBOL " SEI"
 
+// Text of a 256-bit number with its decimal point and symbol
+#define EVM_UI_BUFFER_SIZE 100
+
 // Add two numbers returning UINT64_MAX if overflows
 uint64_t saturating_add(uint64_t a, uint64_t b);
 
@@ -64,6 +67,10 @@ parser_error_t printEVMAddress(const rlp_t *address, char *outVal, uint16_t outV
 parser_error_t printBigIntFixedPoint(const uint8_t *number, uint16_t number_len, char *outVal, uint16_t outValLen,
                                      uint8_t pageIdx, uint8_t *pageCount, uint16_t decimals);
 
+// Prints value with decimals fractional digits followed by symbol
+parser_error_t printUint256FixedPoint(uint256_t *value, uint8_t decimals, const char *symbol, char *outVal,
+                                      uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount);
+
 parser_error_t printEVMMaxFees(const eth_tx_t *ethObj, char *outVal, uint16_t outValLen, uint8_t pageIdx,
                                uint8_t *pageCount);
 #ifdef __cplusplus
@@ -25,32 +25,52 @@
 #include "parser.h"
 #include "parser_common.h"
 #include "parser_impl_evm.h"
+#include "scratch.h"
 
-parser_error_t parser_parse_eth(parser_context_t *ctx, const uint8_t *data, size_t dataLen) {
+parser_error_t parser_parse_eth(parser_context_t *ctx, const uint8_t *data, size_t dataLen, eth_tx_t *tx_obj) {
+    if (ctx == NULL || tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
     CHECK_ERROR(parser_init_context(ctx, data, dataLen))
-    return _readEth(ctx, &eth_tx_obj);
+    ctx->eth_tx_obj = tx_obj;
+    return _readEth(ctx, tx_obj);
+}
+
+parser_error_t parser_precheck_eth(const uint8_t *data, size_t dataLen) {
+    if (data == NULL) {
+        return parser_unexpected_error;
+    }
+    return _precheckEth(data, (uint32_t)MIN(dataLen, UINT32_MAX));
 }
 
 parser_error_t parser_validate_eth(parser_context_t *ctx) {
-    CHECK_ERROR(_validateTxEth())
+    if (ctx == NULL || ctx->eth_tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
+    CHECK_ERROR(_validateTxEth(ctx->eth_tx_obj))
 
     // Iterate through all items to check that all can be shown and are valid
     uint8_t numItems = 0;
-    CHECK_ERROR(_getNumItemsEth(&numItems));
+    CHECK_ERROR(_getNumItemsEth(ctx->eth_tx_obj, &numItems));
 
-    char tmpKey[40] = {0};
-    char tmpVal[40] = {0};
+    const scratch_mark_t mark = scratch_mark();
+    char *tmpKey = scratch_alloc(VALIDATE_KEY_SIZE);
+    char *tmpVal = scratch_alloc(VALIDATE_VALUE_SIZE);
+    parser_error_t err = tmpKey != NULL && tmpVal != NULL ? parser_ok : parser_unexpected_error;
 
-    for (uint8_t idx = 0; idx < numItems; idx++) {
+    for (uint8_t idx = 0; idx < numItems && err == parser_ok; idx++) {
         uint8_t pageCount = 0;
-        CHECK_ERROR(parser_getItemEth(ctx, idx, tmpKey, sizeof(tmpKey), tmpVal, sizeof(tmpVal), 0, &pageCount))
+        err = parser_getItemEth(ctx, idx, tmpKey, VALIDATE_KEY_SIZE, tmpVal, VALIDATE_VALUE_SIZE, 0, &pageCount);
     }
-    return parser_ok;
+    scratch_release(mark);
+    return err;
 }
 
 parser_error_t parser_getNumItemsEth(const parser_context_t *ctx, uint8_t *num_items) {
-    UNUSED(ctx);
-    CHECK_ERROR(_getNumItemsEth(num_items));
+    if (ctx == NULL) {
+        return parser_unexpected_error;
+    }
+    CHECK_ERROR(_getNumItemsEth(ctx->eth_tx_obj, num_items));
     if (*num_items == 0) {
         return parser_unexpected_buffer_end;
     }
@@ -84,5 +104,8 @@ parser_error_t parser_getItemEth(const parser_context_t *ctx, uint8_t displayIdx
 }
 
 parser_error_t parser_compute_eth_v(parser_context_t *ctx, unsigned int info, uint8_t *v, bool is_personal_message) {
-    return _computeV(ctx, &eth_tx_obj, info, v, is_personal_message);
+    if (ctx == NULL) {
+        return parser_unexpected_error;
+    }
+    return _computeV(ctx, ctx->eth_tx_obj, info, v, is_personal_message);
 }
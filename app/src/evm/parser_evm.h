@@ -21,12 +21,16 @@ extern "C" {
 #endif
 
 #include "parser_impl.h"
+#include "parser_impl_evm.h"
 
 const char *parser_getErrorDescription(parser_error_t err);
 const char *parser_getMsgPackTypeDescription(uint8_t type);
 
-//// parses a tx buffer
-parser_error_t parser_parse_eth(parser_context_t *ctx, const uint8_t *data, size_t dataLen);
+//// parses a tx buffer into tx_obj, which must outlive every later call made with ctx
+parser_error_t parser_parse_eth(parser_context_t *ctx, const uint8_t *data, size_t dataLen, eth_tx_t *tx_obj);
+
+//// checks the prefix of a transaction that is still being received
+parser_error_t parser_precheck_eth(const uint8_t *data, size_t dataLen);
 
 //// verifies tx fields
 parser_error_t parser_validate_eth(parser_context_t *ctx);
@@ -27,10 +27,10 @@
 #include "parser_common.h"
 #include "parser_txdef.h"
 #include "rlp.h"
+#include "scratch.h"
 #include "uint256.h"
 #include "zxformat.h"
 
-eth_tx_t eth_tx_obj;
 #define SUPPORTED_NETWORKS_EVM_LEN 2
 #define SEI_MAINNET_CHAINID 1329
 #define SEI_DEVNET_CHAINID 713715
@@ -38,6 +38,9 @@ eth_tx_t eth_tx_obj;
 #define ETHEREUM_RECOVERY_OFFSET 27
 #define EIP155_V_BASE 35
 
+// Hex of the first DATA_BYTES_TO_PRINT bytes of the data and "..." when there are more
+#define DATA_TEXT_SIZE (2 * DATA_BYTES_TO_PRINT + 4)
+
 const uint64_t supported_networks_evm[2] = {
     SEI_MAINNET_CHAINID,
     SEI_DEVNET_CHAINID,
@@ -70,6 +73,15 @@ static parser_error_t readChainID(parser_context_t *ctx, rlp_t *chainId) {
     return parser_invalid_chain_id;
 }
 
+static parser_error_t checkEmptyRS(const rlp_t *sig_r, const rlp_t *sig_s) {
+    // R and S values should be either 0 or 0x80
+    if ((sig_r->rlpLen == 0 && sig_s->rlpLen == 0) ||
+        ((sig_r->rlpLen == 1 && sig_s->rlpLen == 1) && !(*sig_r->ptr | *sig_s->ptr))) {
+        return parser_ok;
+    }
+    return parser_invalid_rs_values;
+}
+
 static parser_error_t parse_legacy_tx(parser_context_t *ctx, eth_tx_t *tx_obj) {
     if (ctx == NULL || tx_obj == NULL) {
         return parser_unexpected_error;
@@ -102,12 +114,7 @@ static parser_error_t parse_legacy_tx(parser_context_t *ctx, eth_tx_t *tx_obj) {
     rlp_t sig_s = {0};
     CHECK_ERROR(rlp_read(ctx, &sig_s));
 
-    // R and S values should be either 0 or 0x80
-    if ((sig_r.rlpLen == 0 && sig_s.rlpLen == 0) ||
-        ((sig_r.rlpLen == 1 && sig_s.rlpLen == 1) && !(*sig_r.ptr | *sig_s.ptr))) {
-        return parser_ok;
-    }
-    return parser_invalid_rs_values;
+    return checkEmptyRS(&sig_r, &sig_s);
 }
 
 static parser_error_t parse_2930(parser_context_t *ctx, eth_tx_t *tx_obj) {
@@ -184,7 +191,7 @@ parser_error_t _readEth(parser_context_t *ctx, eth_tx_t *tx_obj) {
         return parser_unexpected_value;
     }
 
-    MEMZERO(&eth_tx_obj, sizeof(eth_tx_obj));
+    MEMZERO(tx_obj, sizeof(eth_tx_t));
     CHECK_ERROR(readTxnType(ctx, &tx_obj->tx_type))
     // We expect a list with all the fields from the transaction
     rlp_t list = {0};
@@ -217,11 +224,92 @@ parser_error_t _readEth(parser_context_t *ctx, eth_tx_t *tx_obj) {
     return parser_unexpected_error;
 }
 
-parser_error_t _validateTxEth() {
-    eth_tx_obj.is_blindsign = true;
-    if (eth_tx_obj.tx.data.rlpLen == 0 || validateERC20(&eth_tx_obj)) {
+// A field that is not fully buffered yet leaves the decision to a later chunk
+#define CHECK_PREFIX(__CALL)                                \
+    {                                                       \
+        const parser_error_t __prefix_err = __CALL;         \
+        if (__prefix_err == parser_unexpected_buffer_end) { \
+            return parser_ok;                               \
+        }                                                   \
+        CHECK_ERROR(__prefix_err)                           \
+    }
+
+parser_error_t _precheckEth(const uint8_t *data, uint32_t dataLen) {
+    if (data == NULL) {
+        return parser_unexpected_error;
+    }
+    if (dataLen == 0) {
+        return parser_ok;
+    }
+
+    parser_context_t ctx = {.buffer = data, .bufferLen = (uint16_t)MIN(dataLen, UINT16_MAX), .offset = 0};
+    eth_tx_type_e txType = legacy;
+    CHECK_ERROR(readTxnType(&ctx, &txType))
+
+    // List header, the payload is bounded by it even when more bytes follow
+    if (ctx.offset >= ctx.bufferLen) {
+        return parser_ok;
+    }
+    const uint8_t prefix = ctx.buffer[ctx.offset++];
+    if (prefix < RLP_KIND_LIST_SHORT_MIN) {
+        return parser_unexpected_value;
+    }
+    uint64_t payloadLen = 0;
+    if (prefix <= RLP_KIND_LIST_SHORT_MAX) {
+        payloadLen = prefix - RLP_KIND_LIST_SHORT_MIN;
+    } else {
+        const uint8_t bytesLen = prefix - RLP_KIND_LIST_SHORT_MAX;
+        if (ctx.bufferLen - ctx.offset < bytesLen) {
+            return parser_ok;
+        }
+        for (uint8_t i = 0; i < bytesLen; i++) {
+            payloadLen = (payloadLen << 8u) | ctx.buffer[ctx.offset++];
+        }
+    }
+
+    const uint16_t buffered = ctx.bufferLen - ctx.offset;
+    parser_context_t listCtx = {
+        .buffer = ctx.buffer + ctx.offset, .bufferLen = (uint16_t)MIN(payloadLen, buffered), .offset = 0};
+    rlp_t field = {0};
+
+    if (txType == legacy) {
+        // nonce, gasPrice, gasLimit, to, value, data
+        for (uint8_t i = 0; i < 6; i++) {
+            CHECK_PREFIX(rlp_read(&listCtx, &field))
+        }
+        // Either not buffered yet or a pre EIP-155 transaction
+        if (listCtx.offset == listCtx.bufferLen) {
+            return parser_ok;
+        }
+        CHECK_PREFIX(readChainID(&listCtx, &field))
+        rlp_t sig_r = {0};
+        rlp_t sig_s = {0};
+        CHECK_PREFIX(rlp_read(&listCtx, &sig_r))
+        CHECK_PREFIX(rlp_read(&listCtx, &sig_s))
+        return checkEmptyRS(&sig_r, &sig_s);
+    }
+
+    CHECK_PREFIX(readChainID(&listCtx, &field))
+    // nonce, fees, gasLimit, to, value, data and access list
+    const uint8_t fieldsLeft = txType == eip1559 ? 8 : 7;
+    for (uint8_t i = 0; i < fieldsLeft; i++) {
+        CHECK_PREFIX(rlp_read(&listCtx, &field))
+    }
+    // A signature (y, r, s) after the access list
+    if (listCtx.offset < listCtx.bufferLen) {
+        return parser_unsupported_tx;
+    }
+    return parser_ok;
+}
+
+parser_error_t _validateTxEth(eth_tx_t *tx_obj) {
+    if (tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
+    tx_obj->is_blindsign = true;
+    if (tx_obj->tx.data.rlpLen == 0 || validateERC20(tx_obj)) {
         app_mode_skip_blindsign_ui();
-        eth_tx_obj.is_blindsign = false;
+        tx_obj->is_blindsign = false;
     } else if (!app_mode_blindsign()) {
         return parser_blindsign_mode_required;
     }
@@ -236,9 +324,9 @@ static parser_error_t printEthHash(const parser_context_t *ctx, char *outKey, ui
     }
     // we need to get keccak hash of the transaction data
     uint8_t hash[32] = {0};
-#if defined(TARGET_NANOS) || defined(TARGET_NANOS2) || defined(TARGET_NANOX) || defined(TARGET_STAX) || defined(TARGET_FLEX)
-    keccak_digest(ctx->buffer, ctx->bufferLen, hash, 32);
-#endif
+    if (keccak_digest(ctx->buffer, ctx->bufferLen, hash, sizeof(hash)) != zxerr_ok) {
+        return parser_unexpected_error;
+    }
 
     // now get the hex string of the hash
     char hex[65] = {0};
@@ -251,41 +339,61 @@ static parser_error_t printEthHash(const parser_context_t *ctx, char *outKey, ui
     return parser_ok;
 }
 
-static parser_error_t printERC20Transfer(__Z_UNUSED const parser_context_t *ctx, uint8_t displayIdx, char *outKey,
+static parser_error_t printEVMData(const rlp_t *data, char *outVal, uint16_t outValLen, uint8_t pageIdx,
+                                   uint8_t *pageCount) {
+    const scratch_mark_t mark = scratch_mark();
+    char *dataText = scratch_alloc(DATA_TEXT_SIZE);
+    if (dataText == NULL) {
+        return parser_unexpected_error;
+    }
+
+    array_to_hexstr(dataText, DATA_TEXT_SIZE, data->ptr,
+                    data->rlpLen > DATA_BYTES_TO_PRINT ? DATA_BYTES_TO_PRINT : data->rlpLen);
+
+    if (data->rlpLen > DATA_BYTES_TO_PRINT) {
+        snprintf(dataText + (2 * DATA_BYTES_TO_PRINT), 4, "...");
+    }
+
+    pageString(outVal, outValLen, dataText, pageIdx, pageCount);
+    scratch_release(mark);
+    return parser_ok;
+}
+
+static parser_error_t printERC20Transfer(const parser_context_t *ctx, uint8_t displayIdx, char *outKey,
                                          uint16_t outKeyLen, char *outVal, uint16_t outValLen, uint8_t pageIdx,
                                          uint8_t *pageCount) {
-    if (outKey == NULL || outVal == NULL || pageCount == NULL) {
+    if (ctx == NULL || ctx->eth_tx_obj == NULL || outKey == NULL || outVal == NULL || pageCount == NULL) {
         return parser_unexpected_error;
     }
+    const eth_tx_t *eth_tx_obj = ctx->eth_tx_obj;
     MEMZERO(outKey, outKeyLen);
     MEMZERO(outVal, outValLen);
     *pageCount = 1;
 
-    if (eth_tx_obj.tx_type == eip1559 && displayIdx >= 8) {
+    if (eth_tx_obj->tx_type == eip1559 && displayIdx >= 8) {
         displayIdx++;
     }
 
-    if ((eth_tx_obj.tx_type == legacy || eth_tx_obj.tx_type == eip2930) && displayIdx >= 5) {
+    if ((eth_tx_obj->tx_type == legacy || eth_tx_obj->tx_type == eip2930) && displayIdx >= 5) {
         displayIdx += 3;
     }
 
-    char data_array[40] = {0};
     switch (displayIdx) {
         case 0:
             snprintf(outKey, outKeyLen, "Receiver");
-            rlp_t to = {.kind = RLP_KIND_STRING, .ptr = (eth_tx_obj.tx.data.ptr + 4 + 12), .rlpLen = ETH_ADDRESS_LEN};
+            rlp_t to = {.kind = RLP_KIND_STRING, .ptr = (eth_tx_obj->tx.data.ptr + 4 + 12), .rlpLen = ETH_ADDRESS_LEN};
             CHECK_ERROR(printEVMAddress(&to, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 1:
             snprintf(outKey, outKeyLen, "Contract");
-            rlp_t contractAddress = {.kind = RLP_KIND_STRING, .ptr = eth_tx_obj.tx.to.ptr, .rlpLen = ETH_ADDRESS_LEN};
+            rlp_t contractAddress = {.kind = RLP_KIND_STRING, .ptr = eth_tx_obj->tx.to.ptr, .rlpLen = ETH_ADDRESS_LEN};
             CHECK_ERROR(printEVMAddress(&contractAddress, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 2:
             snprintf(outKey, outKeyLen, "Network");
-            switch (eth_tx_obj.chainId.chain_id_decoded) {
+            switch (eth_tx_obj->chainId.chain_id_decoded) {
                 case SEI_MAINNET_CHAINID:
                     snprintf(outVal, outValLen, "Sei Mainnet");
                     break;
@@ -299,50 +407,42 @@ static parser_error_t printERC20Transfer(__Z_UNUSED const parser_context_t *ctx,
 
         case 3:
             snprintf(outKey, outKeyLen, "Amount");
-            CHECK_ERROR(printERC20Value(&eth_tx_obj, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printERC20Value(eth_tx_obj, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 4:
             snprintf(outKey, outKeyLen, "Nonce");
-            CHECK_ERROR(printRLPNumber(&eth_tx_obj.tx.nonce, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printRLPNumber(&eth_tx_obj->tx.nonce, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 5:
             snprintf(outKey, outKeyLen, "Max Priority Fee");
-            CHECK_ERROR(printRLPNumber(&eth_tx_obj.tx.max_priority_fee_per_gas, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printRLPNumber(&eth_tx_obj->tx.max_priority_fee_per_gas, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 6:
             snprintf(outKey, outKeyLen, "Max Fee");
-            CHECK_ERROR(printRLPNumber(&eth_tx_obj.tx.max_fee_per_gas, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printRLPNumber(&eth_tx_obj->tx.max_fee_per_gas, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 7:
             snprintf(outKey, outKeyLen, "Gas limit");
-            CHECK_ERROR(printRLPNumber(&eth_tx_obj.tx.gasLimit, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printRLPNumber(&eth_tx_obj->tx.gasLimit, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 8:
             snprintf(outKey, outKeyLen, "Max Fees");
-            CHECK_ERROR(printEVMMaxFees(&eth_tx_obj, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printEVMMaxFees(eth_tx_obj, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 9:
             snprintf(outKey, outKeyLen, "Value");
-            CHECK_ERROR(printRLPNumber(&eth_tx_obj.tx.value, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printRLPNumber(&eth_tx_obj->tx.value, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 10:
             snprintf(outKey, outKeyLen, "Data");
-            array_to_hexstr(
-                data_array, sizeof(data_array), eth_tx_obj.tx.data.ptr,
-                eth_tx_obj.tx.data.rlpLen > DATA_BYTES_TO_PRINT ? DATA_BYTES_TO_PRINT : eth_tx_obj.tx.data.rlpLen);
-
-            if (eth_tx_obj.tx.data.rlpLen > DATA_BYTES_TO_PRINT) {
-                snprintf(data_array + (2 * DATA_BYTES_TO_PRINT), 4, "...");
-            }
-
-            pageString(outVal, outValLen, data_array, pageIdx, pageCount);
+            CHECK_ERROR(printEVMData(&eth_tx_obj->tx.data, outVal, outValLen, pageIdx, pageCount));
             break;
 
         default:
@@ -354,76 +454,67 @@ static parser_error_t printERC20Transfer(__Z_UNUSED const parser_context_t *ctx,
 
 static parser_error_t printGeneric(const parser_context_t *ctx, uint8_t displayIdx, char *outKey, uint16_t outKeyLen,
                                    char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
-    if (outKey == NULL || outVal == NULL || pageCount == NULL) {
+    if (ctx == NULL || ctx->eth_tx_obj == NULL || outKey == NULL || outVal == NULL || pageCount == NULL) {
         return parser_unexpected_error;
     }
+    const eth_tx_t *eth_tx_obj = ctx->eth_tx_obj;
     MEMZERO(outKey, outKeyLen);
     MEMZERO(outVal, outValLen);
     *pageCount = 1;
 
-    char data_array[40] = {0};
-
-    if ((displayIdx >= 2 && eth_tx_obj.tx.data.rlpLen == 0) || eth_tx_obj.tx.to.rlpLen == 0) {
+    if ((displayIdx >= 2 && eth_tx_obj->tx.data.rlpLen == 0) || eth_tx_obj->tx.to.rlpLen == 0) {
         displayIdx += 1;
     }
 
-    if (eth_tx_obj.tx_type == eip1559 && displayIdx >= 6) {
+    if (eth_tx_obj->tx_type == eip1559 && displayIdx >= 6) {
         displayIdx++;
     }
 
-    if ((eth_tx_obj.tx_type == legacy || eth_tx_obj.tx_type == eip2930) && displayIdx >= 3) {
+    if ((eth_tx_obj->tx_type == legacy || eth_tx_obj->tx_type == eip2930) && displayIdx >= 3) {
         displayIdx += 3;
     }
 
     switch (displayIdx) {
         case 0:
             snprintf(outKey, outKeyLen, "To");
-            rlp_t contractAddress = {.kind = RLP_KIND_STRING, .ptr = eth_tx_obj.tx.to.ptr, .rlpLen = ETH_ADDRESS_LEN};
+            rlp_t contractAddress = {.kind = RLP_KIND_STRING, .ptr = eth_tx_obj->tx.to.ptr, .rlpLen = ETH_ADDRESS_LEN};
             CHECK_ERROR(printEVMAddress(&contractAddress, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 1:
             snprintf(outKey, outKeyLen, "Amount");
-            printBigIntFixedPoint(eth_tx_obj.tx.value.ptr, eth_tx_obj.tx.value.rlpLen, outVal, outValLen, pageIdx, pageCount,
-                                  COIN_DECIMALS);
+            printBigIntFixedPoint(eth_tx_obj->tx.value.ptr, eth_tx_obj->tx.value.rlpLen, outVal, outValLen, pageIdx,
+                                  pageCount, COIN_DECIMALS);
             break;
 
         case 2:
             snprintf(outKey, outKeyLen, "Data");
-            array_to_hexstr(
-                data_array, sizeof(data_array), eth_tx_obj.tx.data.ptr,
-                eth_tx_obj.tx.data.rlpLen > DATA_BYTES_TO_PRINT ? DATA_BYTES_TO_PRINT : eth_tx_obj.tx.data.rlpLen);
-
-            if (eth_tx_obj.tx.data.rlpLen > DATA_BYTES_TO_PRINT) {
-                snprintf(data_array + (2 * DATA_BYTES_TO_PRINT), 4, "...");
-            }
-
-            pageString(outVal, outValLen, data_array, pageIdx, pageCount);
+            CHECK_ERROR(printEVMData(&eth_tx_obj->tx.data, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 3:
             snprintf(outKey, outKeyLen, "Max Priority Fee");
-            CHECK_ERROR(printRLPNumber(&eth_tx_obj.tx.max_priority_fee_per_gas, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printRLPNumber(&eth_tx_obj->tx.max_priority_fee_per_gas, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 4:
             snprintf(outKey, outKeyLen, "Max Fee");
-            CHECK_ERROR(printRLPNumber(&eth_tx_obj.tx.max_fee_per_gas, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printRLPNumber(&eth_tx_obj->tx.max_fee_per_gas, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 5:
             snprintf(outKey, outKeyLen, "Gas limit");
-            CHECK_ERROR(printRLPNumber(&eth_tx_obj.tx.gasLimit, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printRLPNumber(&eth_tx_obj->tx.gasLimit, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 6:
             snprintf(outKey, outKeyLen, "Max Fees");
-            CHECK_ERROR(printEVMMaxFees(&eth_tx_obj, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printEVMMaxFees(eth_tx_obj, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 7:
             snprintf(outKey, outKeyLen, "Nonce");
-            CHECK_ERROR(printRLPNumber(&eth_tx_obj.tx.nonce, outVal, outValLen, pageIdx, pageCount));
+            CHECK_ERROR(printRLPNumber(&eth_tx_obj->tx.nonce, outVal, outValLen, pageIdx, pageCount));
             break;
 
         case 8:
@@ -439,8 +530,11 @@ static parser_error_t printGeneric(const parser_context_t *ctx, uint8_t displayI
 
 parser_error_t _getItemEth(const parser_context_t *ctx, uint8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal,
                            uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    if (ctx == NULL || ctx->eth_tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
     // At the moment, clear signing is available only for ERC20 transfer
-    if (eth_tx_obj.is_erc20_transfer) {
+    if (ctx->eth_tx_obj->is_erc20_transfer) {
         return printERC20Transfer(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
     }
 
@@ -448,15 +542,13 @@ parser_error_t _getItemEth(const parser_context_t *ctx, uint8_t displayIdx, char
 }
 
 // returns the number of items to display on the screen.
-// Note: we might need to add a transaction state object,
-// Defined with one parameter for now.
-parser_error_t _getNumItemsEth(uint8_t *numItems) {
-    if (numItems == NULL) {
+parser_error_t _getNumItemsEth(eth_tx_t *tx_obj, uint8_t *numItems) {
+    if (tx_obj == NULL || numItems == NULL) {
         return parser_unexpected_error;
     }
     // Verify that tx is ERC20
-    if (validateERC20(&eth_tx_obj)) {
-        if (eth_tx_obj.tx_type == legacy || eth_tx_obj.tx_type == eip2930) {
+    if (validateERC20(tx_obj)) {
+        if (tx_obj->tx_type == legacy || tx_obj->tx_type == eip2930) {
             *numItems = 8;
         } else {
             *numItems = 10;
@@ -465,24 +557,24 @@ parser_error_t _getNumItemsEth(uint8_t *numItems) {
     }
 
     // Common items
-    if (eth_tx_obj.tx_type == legacy || eth_tx_obj.tx_type == eip2930) {
+    if (tx_obj->tx_type == legacy || tx_obj->tx_type == eip2930) {
         *numItems = 4;
     } else {
         *numItems = 6;
     }
 
     // Check if the transaction is blindsigned if so show EVM hash
-    *numItems -= (eth_tx_obj.is_blindsign ? 0 : 1);
+    *numItems -= (tx_obj->is_blindsign ? 0 : 1);
 
     // Check if the transaction has data or to address to show
-    *numItems += ((eth_tx_obj.tx.data.rlpLen != 0) ? 1 : 0) + ((eth_tx_obj.tx.to.rlpLen != 0) ? 1 : 0);
+    *numItems += ((tx_obj->tx.data.rlpLen != 0) ? 1 : 0) + ((tx_obj->tx.to.rlpLen != 0) ? 1 : 0);
 
     return parser_ok;
 }
 
 // https://github.com/LedgerHQ/ledger-live/commit/b93a421866519b80fdd8a029caea97323eceae93
 parser_error_t _computeV(parser_context_t *ctx, eth_tx_t *tx_obj, unsigned int info, uint8_t *v, bool is_personal_message) {
-    if (ctx == NULL || tx_obj == NULL || v == NULL) {
+    if (ctx == NULL || v == NULL) {
         return parser_unexpected_error;
     }
 
@@ -493,14 +585,19 @@ parser_error_t _computeV(parser_context_t *ctx, eth_tx_t *tx_obj, unsigned int i
         return parser_ok;
     }
 
-    uint8_t type = eth_tx_obj.tx_type;
+    // Personal messages are not parsed, every other case needs the transaction
+    if (tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
+
+    uint8_t type = tx_obj->tx_type;
 
     if (type == eip2930 || type == eip1559) {
         *v = parity;
         return parser_ok;
     }
 
-    uint32_t chainId = (uint32_t)eth_tx_obj.chainId.chain_id_decoded;
+    uint32_t chainId = (uint32_t)tx_obj->chainId.chain_id_decoded;
     *v = (uint8_t)saturating_add_u32(EIP155_V_BASE + parity, chainId * 2);
 
     return parser_ok;
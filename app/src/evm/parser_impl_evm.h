@@ -55,7 +55,7 @@ typedef enum {
     legacy = 0xc0
 } eth_tx_type_e;
 
-typedef struct {
+typedef struct eth_tx_s {
     eth_tx_type_e tx_type;
     rlp_t chainId;
     eth_base_t tx;
@@ -63,19 +63,19 @@ typedef struct {
     bool is_blindsign;
 } eth_tx_t;
 
-extern eth_tx_t eth_tx_obj;
-
 parser_error_t _readEth(parser_context_t *ctx, eth_tx_t *eth_tx_obj);
 
+// Checks the part of a transaction received so far: type, list header, chain ID and the signature fields.
+// Only rejects what _readEth would reject once the rest arrives.
+parser_error_t _precheckEth(const uint8_t *data, uint32_t dataLen);
+
 parser_error_t _getItemEth(const parser_context_t *ctx, uint8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal,
                            uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount);
 
 // returns the number of items to display on the screen.
-// Note: we might need to add a transaction state object,
-// Defined with one parameter for now.
-parser_error_t _getNumItemsEth(uint8_t *numItems);
+parser_error_t _getNumItemsEth(eth_tx_t *tx_obj, uint8_t *numItems);
 
-parser_error_t _validateTxEth();
+parser_error_t _validateTxEth(eth_tx_t *tx_obj);
 
 parser_error_t _computeV(parser_context_t *ctx, eth_tx_t *tx_obj, unsigned int info, uint8_t *v, bool is_personal_message);
 
@@ -19,15 +19,24 @@
 #include <string.h>
 
 #include "apdu_codes.h"
+#include "app_mode.h"
 #include "buffering.h"
+#include "item_cache.h"
 #include "parser_evm.h"
+#include "scratch.h"
 #include "tx.h"
 #include "zxmacros.h"
 
 static parser_context_t ctx_parsed_tx;
 
 const char *tx_parse_eth(uint8_t *error_code) {
-    uint8_t err = parser_parse_eth(&ctx_parsed_tx, tx_get_buffer(), tx_get_buffer_length());
+    item_cache_reset();
+    scratch_reset();
+    eth_tx_t *eth_tx_obj = tx_state_acquire(tx_state_eth, sizeof(eth_tx_t));
+    if (eth_tx_obj == NULL) {
+        return parser_getErrorDescription(parser_unexpected_error);
+    }
+    uint8_t err = parser_parse_eth(&ctx_parsed_tx, tx_get_buffer(), tx_get_buffer_length(), eth_tx_obj);
 
     CHECK_APP_CANARY()
 
@@ -46,7 +55,18 @@ const char *tx_parse_eth(uint8_t *error_code) {
     return NULL;
 }
 
+const char *tx_precheck_eth(const uint8_t *data, uint32_t dataLen) {
+    const parser_error_t err = parser_precheck_eth(data, dataLen);
+    if (err != parser_ok) {
+        return parser_getErrorDescription(err);
+    }
+    return NULL;
+}
+
 zxerr_t tx_compute_eth_v(unsigned int info, uint8_t *v, bool is_personal_message) {
+    if (!is_personal_message && !tx_state_check(tx_state_eth)) {
+        return zxerr_unknown;
+    }
     parser_error_t err = parser_compute_eth_v(&ctx_parsed_tx, info, v, is_personal_message);
 
     if (err != parser_ok) return zxerr_unknown;
@@ -55,6 +75,9 @@ zxerr_t tx_compute_eth_v(unsigned int info, uint8_t *v, bool is_personal_message
 }
 
 zxerr_t tx_getNumItemsEth(uint8_t *num_items) {
+    if (!tx_state_check(tx_state_eth)) {
+        return zxerr_unknown;
+    }
     parser_error_t err = parser_getNumItemsEth(&ctx_parsed_tx, num_items);
 
     if (err != parser_ok) {
@@ -74,6 +97,13 @@ zxerr_t tx_getItemEth(int8_t displayIdx, char *outKey, uint16_t outKeyLen, char
         return zxerr_no_data;
     }
 
+    const bool expert = app_mode_expert();
+    if (displayIdx >= 0 &&
+        item_cache_lookup((uint16_t)displayIdx, expert, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount)) {
+        return zxerr_ok;
+    }
+
+    scratch_reset();
     parser_error_t err =
         parser_getItemEth(&ctx_parsed_tx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
 
@@ -83,5 +113,8 @@ zxerr_t tx_getItemEth(int8_t displayIdx, char *outKey, uint16_t outKeyLen, char
 
     if (err != parser_ok) return zxerr_unknown;
 
+    if (displayIdx >= 0) {
+        item_cache_store((uint16_t)displayIdx, expert, outKey, outVal, outValLen, pageIdx, *pageCount);
+    }
     return zxerr_ok;
 }
@@ -24,6 +24,10 @@
 /// \return It returns NULL if data is valid or error message otherwise.
 const char *tx_parse_eth(uint8_t *error_code);
 
+/// Checks the start of a transaction while the rest is still being received
+/// \return It returns NULL if nothing received so far is invalid or error message otherwise.
+const char *tx_precheck_eth(const uint8_t *data, uint32_t dataLen);
+
 /// Return the number of items in the transaction
 zxerr_t tx_getNumItemsEth(uint8_t *num_items);
 
@@ -408,7 +408,7 @@ void mul256(uint256_t *number1, uint256_t *number2, uint256_t *target) {
     clear256(&target1);
     shiftl128(&first64, 64, &UPPER(target1));
     clear256(&target2);
-    UPPER(UPPER(target2)) = UPPER(third64);
+    LOWER(UPPER(target2)) = UPPER(third64);
     shiftl128(&third64, 64, &LOWER(target2));
     add256(&target1, &target2, target);
     clear256(&target1);
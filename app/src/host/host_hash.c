@@ -0,0 +1,533 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#if !defined(LEDGER_SPECIFIC)
+
+#include "host_hash.h"
+
+#include <string.h>
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+#define ROTL64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+///////////////////////////////////////////////////////////////////////////////
+// SHA-256 (FIPS 180-4)
+
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01,
+    0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08,
+    0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+static void sha256_compress(uint32_t state[8], const uint8_t block[64]) {
+    uint32_t w[64];
+    for (uint8_t i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)block[4 * i] << 24) | ((uint32_t)block[4 * i + 1] << 16) | ((uint32_t)block[4 * i + 2] << 8) |
+               (uint32_t)block[4 * i + 3];
+    }
+    for (uint8_t i = 16; i < 64; i++) {
+        const uint32_t s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        const uint32_t s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (uint8_t i = 0; i < 64; i++) {
+        const uint32_t S1 = ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25);
+        const uint32_t ch = (e & f) ^ (~e & g);
+        const uint32_t t1 = h + S1 + ch + SHA256_K[i] + w[i];
+        const uint32_t S0 = ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22);
+        const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        const uint32_t t2 = S0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void host_sha256_init(host_sha256_t *ctx) {
+    static const uint32_t IV[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    memset(ctx, 0, sizeof(*ctx));
+    memcpy(ctx->state, IV, sizeof(IV));
+}
+
+void host_sha256_update(host_sha256_t *ctx, const uint8_t *data, size_t len) {
+    ctx->length += len;
+    while (len > 0) {
+        const size_t n = (len < (size_t)(64 - ctx->blockLen)) ? len : (size_t)(64 - ctx->blockLen);
+        memcpy(ctx->block + ctx->blockLen, data, n);
+        ctx->blockLen += (uint8_t)n;
+        data += n;
+        len -= n;
+        if (ctx->blockLen == 64) {
+            sha256_compress(ctx->state, ctx->block);
+            ctx->blockLen = 0;
+        }
+    }
+}
+
+void host_sha256_final(host_sha256_t *ctx, uint8_t out[HOST_SHA256_SIZE]) {
+    const uint64_t bits = ctx->length * 8;
+    const uint8_t pad = 0x80;
+    const uint8_t zero = 0x00;
+    host_sha256_update(ctx, &pad, 1);
+    while (ctx->blockLen != 56) {
+        host_sha256_update(ctx, &zero, 1);
+    }
+    uint8_t lenBytes[8];
+    for (uint8_t i = 0; i < 8; i++) {
+        lenBytes[i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+    host_sha256_update(ctx, lenBytes, sizeof(lenBytes));
+    for (uint8_t i = 0; i < 8; i++) {
+        out[4 * i] = (uint8_t)(ctx->state[i] >> 24);
+        out[4 * i + 1] = (uint8_t)(ctx->state[i] >> 16);
+        out[4 * i + 2] = (uint8_t)(ctx->state[i] >> 8);
+        out[4 * i + 3] = (uint8_t)ctx->state[i];
+    }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void host_sha256(const uint8_t *data, size_t len, uint8_t out[HOST_SHA256_SIZE]) {
+    host_sha256_t ctx;
+    host_sha256_init(&ctx);
+    host_sha256_update(&ctx, data, len);
+    host_sha256_final(&ctx, out);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// SHA-512 (FIPS 180-4)
+
+static const uint64_t SHA512_K[80] = {
+    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc, 0x3956c25bf348b538,
+    0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242, 0x12835b0145706fbe,
+    0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2, 0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
+    0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+    0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5, 0x983e5152ee66dfab,
+    0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
+    0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed,
+    0x53380d139d95b3df, 0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+    0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
+    0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8, 0x19a4c116b8d2d0c8, 0x1e376c085141ab53,
+    0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373,
+    0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b, 0xca273eceea26619c,
+    0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba, 0x0a637dc5a2c898a6,
+    0x113f9804bef90dae, 0x1b710b35131c471b, 0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
+    0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
+
+static void sha512_compress(uint64_t state[8], const uint8_t block[128]) {
+    uint64_t w[80];
+    for (uint8_t i = 0; i < 16; i++) {
+        w[i] = 0;
+        for (uint8_t j = 0; j < 8; j++) {
+            w[i] = (w[i] << 8) | block[8 * i + j];
+        }
+    }
+    for (uint8_t i = 16; i < 80; i++) {
+        const uint64_t s0 = ROTR64(w[i - 15], 1) ^ ROTR64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+        const uint64_t s1 = ROTR64(w[i - 2], 19) ^ ROTR64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (uint8_t i = 0; i < 80; i++) {
+        const uint64_t S1 = ROTR64(e, 14) ^ ROTR64(e, 18) ^ ROTR64(e, 41);
+        const uint64_t ch = (e & f) ^ (~e & g);
+        const uint64_t t1 = h + S1 + ch + SHA512_K[i] + w[i];
+        const uint64_t S0 = ROTR64(a, 28) ^ ROTR64(a, 34) ^ ROTR64(a, 39);
+        const uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+        const uint64_t t2 = S0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void host_sha512_init(host_sha512_t *ctx) {
+    static const uint64_t IV[8] = {0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+                                   0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179};
+    memset(ctx, 0, sizeof(*ctx));
+    memcpy(ctx->state, IV, sizeof(IV));
+}
+
+void host_sha512_update(host_sha512_t *ctx, const uint8_t *data, size_t len) {
+    ctx->length += len;
+    while (len > 0) {
+        const size_t n = (len < (size_t)(128 - ctx->blockLen)) ? len : (size_t)(128 - ctx->blockLen);
+        memcpy(ctx->block + ctx->blockLen, data, n);
+        ctx->blockLen += (uint8_t)n;
+        data += n;
+        len -= n;
+        if (ctx->blockLen == 128) {
+            sha512_compress(ctx->state, ctx->block);
+            ctx->blockLen = 0;
+        }
+    }
+}
+
+void host_sha512_final(host_sha512_t *ctx, uint8_t out[HOST_SHA512_SIZE]) {
+    const uint64_t bits = ctx->length * 8;
+    const uint8_t pad = 0x80;
+    const uint8_t zero = 0x00;
+    host_sha512_update(ctx, &pad, 1);
+    while (ctx->blockLen != 112) {
+        host_sha512_update(ctx, &zero, 1);
+    }
+    // 128-bit big endian length, the upper half is always zero here
+    uint8_t lenBytes[16] = {0};
+    for (uint8_t i = 0; i < 8; i++) {
+        lenBytes[8 + i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+    host_sha512_update(ctx, lenBytes, sizeof(lenBytes));
+    for (uint8_t i = 0; i < 8; i++) {
+        for (uint8_t j = 0; j < 8; j++) {
+            out[8 * i + j] = (uint8_t)(ctx->state[i] >> (56 - 8 * j));
+        }
+    }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Keccak-256, original padding as used by Ethereum (not FIPS-202 SHA3-256)
+
+#define KECCAK256_RATE 136u
+
+static const uint64_t KECCAK_RC[24] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000, 0x000000000000808b,
+    0x0000000080000001, 0x8000000080008081, 0x8000000000008009, 0x000000000000008a, 0x0000000000000088,
+    0x0000000080008009, 0x000000008000000a, 0x000000008000808b, 0x800000000000008b, 0x8000000000008089,
+    0x8000000000008003, 0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008};
+
+static const uint8_t KECCAK_ROTC[24] = {1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44};
+static const uint8_t KECCAK_PILN[24] = {10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
+
+static void keccak_f1600(uint64_t st[25]) {
+    uint64_t bc[5];
+    for (uint8_t round = 0; round < 24; round++) {
+        // Theta
+        for (uint8_t i = 0; i < 5; i++) {
+            bc[i] = st[i] ^ st[i + 5] ^ st[i + 10] ^ st[i + 15] ^ st[i + 20];
+        }
+        for (uint8_t i = 0; i < 5; i++) {
+            const uint64_t t = bc[(i + 4) % 5] ^ ROTL64(bc[(i + 1) % 5], 1);
+            for (uint8_t j = 0; j < 25; j += 5) {
+                st[j + i] ^= t;
+            }
+        }
+        // Rho and Pi
+        uint64_t t = st[1];
+        for (uint8_t i = 0; i < 24; i++) {
+            const uint8_t j = KECCAK_PILN[i];
+            const uint64_t tmp = st[j];
+            st[j] = ROTL64(t, KECCAK_ROTC[i]);
+            t = tmp;
+        }
+        // Chi
+        for (uint8_t j = 0; j < 25; j += 5) {
+            for (uint8_t i = 0; i < 5; i++) {
+                bc[i] = st[j + i];
+            }
+            for (uint8_t i = 0; i < 5; i++) {
+                st[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+            }
+        }
+        // Iota
+        st[0] ^= KECCAK_RC[round];
+    }
+}
+
+void host_keccak256_init(host_keccak256_t *ctx) { memset(ctx, 0, sizeof(*ctx)); }
+
+void host_keccak256_update(host_keccak256_t *ctx, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        ctx->state[ctx->offset / 8] ^= (uint64_t)data[i] << (8 * (ctx->offset % 8));
+        ctx->offset++;
+        if (ctx->offset == KECCAK256_RATE) {
+            keccak_f1600(ctx->state);
+            ctx->offset = 0;
+        }
+    }
+}
+
+void host_keccak256_final(host_keccak256_t *ctx, uint8_t out[HOST_KECCAK256_SIZE]) {
+    ctx->state[ctx->offset / 8] ^= (uint64_t)0x01 << (8 * (ctx->offset % 8));
+    ctx->state[(KECCAK256_RATE - 1) / 8] ^= (uint64_t)0x80 << (8 * ((KECCAK256_RATE - 1) % 8));
+    keccak_f1600(ctx->state);
+    for (uint8_t i = 0; i < HOST_KECCAK256_SIZE; i++) {
+        out[i] = (uint8_t)(ctx->state[i / 8] >> (8 * (i % 8)));
+    }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void host_keccak256(const uint8_t *data, size_t len, uint8_t out[HOST_KECCAK256_SIZE]) {
+    host_keccak256_t ctx;
+    host_keccak256_init(&ctx);
+    host_keccak256_update(&ctx, data, len);
+    host_keccak256_final(&ctx, out);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// RIPEMD-160
+
+static const uint8_t RIPEMD_RL[80] = {0, 1,  2,  3,  4,  5,  6,  7, 8,  9,  10, 11, 12, 13, 14, 15, 7,  4,  13, 1,
+                                      10, 6, 15, 3,  12, 0,  9,  5, 2,  14, 11, 8,  3,  10, 14, 4,  9,  15, 8,  1,
+                                      2,  7, 0,  6,  13, 11, 5,  12, 1, 9,  11, 10, 0,  8,  12, 4,  13, 3,  7,  15,
+                                      14, 5, 6,  2,  4,  0,  5,  9, 7,  12, 2,  10, 14, 1,  3,  8,  11, 6,  15, 13};
+static const uint8_t RIPEMD_RR[80] = {5,  14, 7,  0,  9,  2,  11, 4,  13, 6,  15, 8,  1,  10, 3,  12, 6,  11, 3,  7,
+                                      0,  13, 5,  10, 14, 15, 8,  12, 4,  9,  1,  2,  15, 5,  1,  3,  7,  14, 6,  9,
+                                      11, 8,  12, 2,  10, 0,  4,  13, 8,  6,  4,  1,  3,  11, 15, 0,  5,  12, 2,  13,
+                                      9,  7,  10, 14, 12, 15, 10, 4,  1,  5,  8,  7,  6,  2,  13, 14, 0,  3,  9,  11};
+static const uint8_t RIPEMD_SL[80] = {11, 14, 15, 12, 5,  8,  7,  9,  11, 13, 14, 15, 6,  7,  9,  8,  7,  6,  8,  13,
+                                      11, 9,  7,  15, 7,  12, 15, 9,  11, 7,  13, 12, 11, 13, 6,  7,  14, 9,  13, 15,
+                                      14, 8,  13, 6,  5,  12, 7,  5,  11, 12, 14, 15, 14, 15, 9,  8,  9,  14, 5,  6,
+                                      8,  6,  5,  12, 9,  15, 5,  11, 6,  8,  13, 12, 5,  12, 13, 14, 11, 8,  5,  6};
+static const uint8_t RIPEMD_SR[80] = {8,  9,  9,  11, 13, 15, 15, 5,  7,  7,  8,  11, 14, 14, 12, 6,  9,  13, 15, 7,
+                                      12, 8,  9,  11, 7,  7,  12, 7,  6,  15, 13, 11, 9,  7,  15, 11, 8,  6,  6,  14,
+                                      12, 13, 5,  14, 13, 13, 7,  5,  15, 5,  8,  11, 14, 14, 6,  14, 6,  9,  12, 9,
+                                      12, 5,  15, 8,  8,  5,  12, 9,  12, 5,  14, 6,  8,  13, 6,  5,  15, 13, 11, 11};
+static const uint32_t RIPEMD_KL[5] = {0x00000000, 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xA953FD4E};
+static const uint32_t RIPEMD_KR[5] = {0x50A28BE6, 0x5C4DD124, 0x6D703EF3, 0x7A6D76E9, 0x00000000};
+
+static uint32_t ripemd_f(uint8_t j, uint32_t x, uint32_t y, uint32_t z) {
+    switch (j / 16) {
+        case 0:
+            return x ^ y ^ z;
+        case 1:
+            return (x & y) | (~x & z);
+        case 2:
+            return (x | ~y) ^ z;
+        case 3:
+            return (x & z) | (y & ~z);
+        default:
+            return x ^ (y | ~z);
+    }
+}
+
+static void ripemd160_compress(uint32_t state[5], const uint8_t block[64]) {
+    uint32_t x[16];
+    for (uint8_t i = 0; i < 16; i++) {
+        x[i] = (uint32_t)block[4 * i] | ((uint32_t)block[4 * i + 1] << 8) | ((uint32_t)block[4 * i + 2] << 16) |
+               ((uint32_t)block[4 * i + 3] << 24);
+    }
+
+    uint32_t al = state[0], bl = state[1], cl = state[2], dl = state[3], el = state[4];
+    uint32_t ar = state[0], br = state[1], cr = state[2], dr = state[3], er = state[4];
+    for (uint8_t j = 0; j < 80; j++) {
+        uint32_t t = ROTL32(al + ripemd_f(j, bl, cl, dl) + x[RIPEMD_RL[j]] + RIPEMD_KL[j / 16], RIPEMD_SL[j]) + el;
+        al = el;
+        el = dl;
+        dl = ROTL32(cl, 10);
+        cl = bl;
+        bl = t;
+
+        t = ROTL32(ar + ripemd_f(79 - j, br, cr, dr) + x[RIPEMD_RR[j]] + RIPEMD_KR[j / 16], RIPEMD_SR[j]) + er;
+        ar = er;
+        er = dr;
+        dr = ROTL32(cr, 10);
+        cr = br;
+        br = t;
+    }
+
+    const uint32_t t = state[1] + cl + dr;
+    state[1] = state[2] + dl + er;
+    state[2] = state[3] + el + ar;
+    state[3] = state[4] + al + br;
+    state[4] = state[0] + bl + cr;
+    state[0] = t;
+}
+
+void host_ripemd160_init(host_ripemd160_t *ctx) {
+    static const uint32_t IV[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    memset(ctx, 0, sizeof(*ctx));
+    memcpy(ctx->state, IV, sizeof(IV));
+}
+
+void host_ripemd160_update(host_ripemd160_t *ctx, const uint8_t *data, size_t len) {
+    ctx->length += len;
+    while (len > 0) {
+        const size_t n = (len < (size_t)(64 - ctx->blockLen)) ? len : (size_t)(64 - ctx->blockLen);
+        memcpy(ctx->block + ctx->blockLen, data, n);
+        ctx->blockLen += (uint8_t)n;
+        data += n;
+        len -= n;
+        if (ctx->blockLen == 64) {
+            ripemd160_compress(ctx->state, ctx->block);
+            ctx->blockLen = 0;
+        }
+    }
+}
+
+void host_ripemd160_final(host_ripemd160_t *ctx, uint8_t out[HOST_RIPEMD160_SIZE]) {
+    const uint64_t bits = ctx->length * 8;
+    const uint8_t pad = 0x80;
+    const uint8_t zero = 0x00;
+    host_ripemd160_update(ctx, &pad, 1);
+    while (ctx->blockLen != 56) {
+        host_ripemd160_update(ctx, &zero, 1);
+    }
+    uint8_t lenBytes[8];
+    for (uint8_t i = 0; i < 8; i++) {
+        lenBytes[i] = (uint8_t)(bits >> (8 * i));
+    }
+    host_ripemd160_update(ctx, lenBytes, sizeof(lenBytes));
+    for (uint8_t i = 0; i < 5; i++) {
+        out[4 * i] = (uint8_t)ctx->state[i];
+        out[4 * i + 1] = (uint8_t)(ctx->state[i] >> 8);
+        out[4 * i + 2] = (uint8_t)(ctx->state[i] >> 16);
+        out[4 * i + 3] = (uint8_t)(ctx->state[i] >> 24);
+    }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void host_ripemd160(const uint8_t *data, size_t len, uint8_t out[HOST_RIPEMD160_SIZE]) {
+    host_ripemd160_t ctx;
+    host_ripemd160_init(&ctx);
+    host_ripemd160_update(&ctx, data, len);
+    host_ripemd160_final(&ctx, out);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// HMAC and PBKDF2
+
+void host_hmac_sha256(const uint8_t *key, size_t keyLen, const uint8_t *data, size_t dataLen,
+                      uint8_t out[HOST_SHA256_SIZE]) {
+    uint8_t k[64] = {0};
+    if (keyLen > sizeof(k)) {
+        host_sha256(key, keyLen, k);
+    } else if (keyLen > 0) {
+        memcpy(k, key, keyLen);
+    }
+
+    uint8_t pad[64];
+    host_sha256_t ctx;
+
+    for (uint8_t i = 0; i < sizeof(pad); i++) pad[i] = k[i] ^ 0x36;
+    host_sha256_init(&ctx);
+    host_sha256_update(&ctx, pad, sizeof(pad));
+    host_sha256_update(&ctx, data, dataLen);
+    uint8_t inner[HOST_SHA256_SIZE];
+    host_sha256_final(&ctx, inner);
+
+    for (uint8_t i = 0; i < sizeof(pad); i++) pad[i] = k[i] ^ 0x5c;
+    host_sha256_init(&ctx);
+    host_sha256_update(&ctx, pad, sizeof(pad));
+    host_sha256_update(&ctx, inner, sizeof(inner));
+    host_sha256_final(&ctx, out);
+
+    memset(k, 0, sizeof(k));
+    memset(pad, 0, sizeof(pad));
+}
+
+void host_hmac_sha512(const uint8_t *key, size_t keyLen, const uint8_t *data, size_t dataLen,
+                      uint8_t out[HOST_SHA512_SIZE]) {
+    uint8_t k[128] = {0};
+    host_sha512_t ctx;
+    if (keyLen > sizeof(k)) {
+        host_sha512_init(&ctx);
+        host_sha512_update(&ctx, key, keyLen);
+        host_sha512_final(&ctx, k);
+    } else if (keyLen > 0) {
+        memcpy(k, key, keyLen);
+    }
+
+    uint8_t pad[128];
+
+    for (uint8_t i = 0; i < sizeof(pad); i++) pad[i] = k[i] ^ 0x36;
+    host_sha512_init(&ctx);
+    host_sha512_update(&ctx, pad, sizeof(pad));
+    host_sha512_update(&ctx, data, dataLen);
+    uint8_t inner[HOST_SHA512_SIZE];
+    host_sha512_final(&ctx, inner);
+
+    for (uint8_t i = 0; i < sizeof(pad); i++) pad[i] = k[i] ^ 0x5c;
+    host_sha512_init(&ctx);
+    host_sha512_update(&ctx, pad, sizeof(pad));
+    host_sha512_update(&ctx, inner, sizeof(inner));
+    host_sha512_final(&ctx, out);
+
+    memset(k, 0, sizeof(k));
+    memset(pad, 0, sizeof(pad));
+}
+
+void host_pbkdf2_sha512(const uint8_t *password, size_t passwordLen, const uint8_t *salt, size_t saltLen,
+                        uint32_t iterations, uint8_t *out, size_t outLen) {
+    uint8_t saltBlock[256];
+    if (saltLen > sizeof(saltBlock) - 4) {
+        memset(out, 0, outLen);
+        return;
+    }
+    memcpy(saltBlock, salt, saltLen);
+
+    for (uint32_t block = 1; outLen > 0; block++) {
+        saltBlock[saltLen] = (uint8_t)(block >> 24);
+        saltBlock[saltLen + 1] = (uint8_t)(block >> 16);
+        saltBlock[saltLen + 2] = (uint8_t)(block >> 8);
+        saltBlock[saltLen + 3] = (uint8_t)block;
+
+        uint8_t u[HOST_SHA512_SIZE];
+        uint8_t t[HOST_SHA512_SIZE];
+        host_hmac_sha512(password, passwordLen, saltBlock, saltLen + 4, u);
+        memcpy(t, u, sizeof(t));
+        for (uint32_t i = 1; i < iterations; i++) {
+            host_hmac_sha512(password, passwordLen, u, sizeof(u), u);
+            for (uint8_t j = 0; j < sizeof(t); j++) {
+                t[j] ^= u[j];
+            }
+        }
+
+        const size_t n = outLen < sizeof(t) ? outLen : sizeof(t);
+        memcpy(out, t, n);
+        out += n;
+        outLen -= n;
+    }
+}
+
+#endif
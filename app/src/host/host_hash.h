@@ -0,0 +1,90 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Portable hash functions used when the app code runs on a host (unit tests,
+// fuzzers, benchmarks, simulator). Device builds use the cx_* implementations
+// from the secure SDK instead; nothing in here is compiled for LEDGER_SPECIFIC.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define HOST_SHA256_SIZE 32u
+#define HOST_SHA512_SIZE 64u
+#define HOST_KECCAK256_SIZE 32u
+#define HOST_RIPEMD160_SIZE 20u
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t length;
+    uint8_t block[64];
+    uint8_t blockLen;
+} host_sha256_t;
+
+typedef struct {
+    uint64_t state[8];
+    uint64_t length;
+    uint8_t block[128];
+    uint8_t blockLen;
+} host_sha512_t;
+
+typedef struct {
+    uint64_t state[25];
+    uint8_t offset;
+} host_keccak256_t;
+
+typedef struct {
+    uint32_t state[5];
+    uint64_t length;
+    uint8_t block[64];
+    uint8_t blockLen;
+} host_ripemd160_t;
+
+void host_sha256_init(host_sha256_t *ctx);
+void host_sha256_update(host_sha256_t *ctx, const uint8_t *data, size_t len);
+void host_sha256_final(host_sha256_t *ctx, uint8_t out[HOST_SHA256_SIZE]);
+void host_sha256(const uint8_t *data, size_t len, uint8_t out[HOST_SHA256_SIZE]);
+
+void host_sha512_init(host_sha512_t *ctx);
+void host_sha512_update(host_sha512_t *ctx, const uint8_t *data, size_t len);
+void host_sha512_final(host_sha512_t *ctx, uint8_t out[HOST_SHA512_SIZE]);
+
+void host_keccak256_init(host_keccak256_t *ctx);
+void host_keccak256_update(host_keccak256_t *ctx, const uint8_t *data, size_t len);
+void host_keccak256_final(host_keccak256_t *ctx, uint8_t out[HOST_KECCAK256_SIZE]);
+void host_keccak256(const uint8_t *data, size_t len, uint8_t out[HOST_KECCAK256_SIZE]);
+
+void host_ripemd160_init(host_ripemd160_t *ctx);
+void host_ripemd160_update(host_ripemd160_t *ctx, const uint8_t *data, size_t len);
+void host_ripemd160_final(host_ripemd160_t *ctx, uint8_t out[HOST_RIPEMD160_SIZE]);
+void host_ripemd160(const uint8_t *data, size_t len, uint8_t out[HOST_RIPEMD160_SIZE]);
+
+void host_hmac_sha256(const uint8_t *key, size_t keyLen, const uint8_t *data, size_t dataLen,
+                      uint8_t out[HOST_SHA256_SIZE]);
+void host_hmac_sha512(const uint8_t *key, size_t keyLen, const uint8_t *data, size_t dataLen,
+                      uint8_t out[HOST_SHA512_SIZE]);
+
+// PBKDF2-HMAC-SHA512, as used by BIP39 to turn a mnemonic into a seed
+void host_pbkdf2_sha512(const uint8_t *password, size_t passwordLen, const uint8_t *salt, size_t saltLen,
+                        uint32_t iterations, uint8_t *out, size_t outLen);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,519 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#if !defined(LEDGER_SPECIFIC)
+
+#include "host_secp256k1.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "host_hash.h"
+
+// 256-bit numbers are stored as 4 little endian 64-bit limbs
+typedef struct {
+    uint64_t v[4];
+} u256_t;
+
+typedef struct {
+    u256_t m;
+    // 2^256 - m, used to fold the upper half of products
+    u256_t c;
+} modulus_t;
+
+typedef struct {
+    u256_t x;
+    u256_t y;
+    u256_t z;  // z == 0 is the point at infinity
+} jpoint_t;
+
+static const modulus_t FIELD_P = {
+    {{0xFFFFFFFEFFFFFC2F, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF}},
+    {{0x00000001000003D1, 0, 0, 0}},
+};
+
+static const modulus_t ORDER_N = {
+    {{0xBFD25E8CD0364141, 0xBAAEDCE6AF48A03B, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF}},
+    {{0x402DA1732FC9BEBF, 0x4551231950B75FC4, 0x0000000000000001, 0}},
+};
+
+static const u256_t HALF_N = {{0xDFE92F46681B20A0, 0x5D576E7357A4501D, 0xFFFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF}};
+
+static const jpoint_t GENERATOR = {
+    {{0x59F2815B16F81798, 0x029BFCDB2DCE28D9, 0x55A06295CE870B07, 0x79BE667EF9DCBBAC}},
+    {{0x9C47D08FFB10D4B8, 0xFD17B448A6855419, 0x5DA4FBFC0E1108A8, 0x483ADA7726A3C465}},
+    {{1, 0, 0, 0}},
+};
+
+static void u256_from_be(u256_t *r, const uint8_t in[32]) {
+    for (uint8_t i = 0; i < 4; i++) {
+        uint64_t limb = 0;
+        for (uint8_t j = 0; j < 8; j++) {
+            limb = (limb << 8) | in[(3 - i) * 8 + j];
+        }
+        r->v[i] = limb;
+    }
+}
+
+static void u256_to_be(uint8_t out[32], const u256_t *a) {
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = 0; j < 8; j++) {
+            out[(3 - i) * 8 + j] = (uint8_t)(a->v[i] >> (56 - 8 * j));
+        }
+    }
+}
+
+static bool u256_is_zero(const u256_t *a) { return (a->v[0] | a->v[1] | a->v[2] | a->v[3]) == 0; }
+
+static int u256_cmp(const u256_t *a, const u256_t *b) {
+    for (int8_t i = 3; i >= 0; i--) {
+        if (a->v[i] != b->v[i]) {
+            return a->v[i] > b->v[i] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+static uint64_t u256_add(u256_t *r, const u256_t *a, const u256_t *b) {
+    unsigned __int128 carry = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        carry += (unsigned __int128)a->v[i] + b->v[i];
+        r->v[i] = (uint64_t)carry;
+        carry >>= 64;
+    }
+    return (uint64_t)carry;
+}
+
+static uint64_t u256_sub(u256_t *r, const u256_t *a, const u256_t *b) {
+    uint64_t borrow = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        const uint64_t ai = a->v[i];
+        const uint64_t bi = b->v[i];
+        r->v[i] = ai - bi - borrow;
+        borrow = (ai < bi) || (ai == bi && borrow) ? 1 : 0;
+    }
+    return borrow;
+}
+
+// Reduces an 8 limb number modulo mod
+static void reduce512(u256_t *r, const uint64_t in[8], const modulus_t *mod) {
+    uint64_t x[8];
+    memcpy(x, in, sizeof(x));
+
+    while ((x[4] | x[5] | x[6] | x[7]) != 0) {
+        // x = low + high * c
+        uint64_t t[8] = {x[0], x[1], x[2], x[3], 0, 0, 0, 0};
+        for (uint8_t i = 0; i < 4; i++) {
+            unsigned __int128 carry = 0;
+            for (uint8_t j = 0; j < 4; j++) {
+                carry += (unsigned __int128)x[4 + i] * mod->c.v[j] + t[i + j];
+                t[i + j] = (uint64_t)carry;
+                carry >>= 64;
+            }
+            for (uint8_t k = i + 4; k < 8 && carry != 0; k++) {
+                carry += t[k];
+                t[k] = (uint64_t)carry;
+                carry >>= 64;
+            }
+        }
+        memcpy(x, t, sizeof(x));
+    }
+
+    memcpy(r->v, x, sizeof(r->v));
+    while (u256_cmp(r, &mod->m) >= 0) {
+        u256_sub(r, r, &mod->m);
+    }
+}
+
+static void mod_mul(u256_t *r, const u256_t *a, const u256_t *b, const modulus_t *mod) {
+    uint64_t t[8] = {0};
+    for (uint8_t i = 0; i < 4; i++) {
+        unsigned __int128 carry = 0;
+        for (uint8_t j = 0; j < 4; j++) {
+            carry += (unsigned __int128)a->v[i] * b->v[j] + t[i + j];
+            t[i + j] = (uint64_t)carry;
+            carry >>= 64;
+        }
+        t[i + 4] = (uint64_t)carry;
+    }
+    reduce512(r, t, mod);
+}
+
+static void mod_add(u256_t *r, const u256_t *a, const u256_t *b, const modulus_t *mod) {
+    const uint64_t carry = u256_add(r, a, b);
+    if (carry || u256_cmp(r, &mod->m) >= 0) {
+        u256_sub(r, r, &mod->m);
+    }
+}
+
+static void mod_sub(u256_t *r, const u256_t *a, const u256_t *b, const modulus_t *mod) {
+    if (u256_sub(r, a, b)) {
+        u256_add(r, r, &mod->m);
+    }
+}
+
+static void mod_reduce(u256_t *r, const u256_t *a, const modulus_t *mod) {
+    const uint64_t t[8] = {a->v[0], a->v[1], a->v[2], a->v[3], 0, 0, 0, 0};
+    reduce512(r, t, mod);
+}
+
+// Inverse through Fermat's little theorem, a^(m-2)
+static void mod_inv(u256_t *r, const u256_t *a, const modulus_t *mod) {
+    u256_t exp = mod->m;
+    const u256_t two = {{2, 0, 0, 0}};
+    u256_sub(&exp, &exp, &two);
+
+    u256_t result = {{1, 0, 0, 0}};
+    for (int16_t bit = 255; bit >= 0; bit--) {
+        mod_mul(&result, &result, &result, mod);
+        if ((exp.v[bit / 64] >> (bit % 64)) & 1) {
+            mod_mul(&result, &result, a, mod);
+        }
+    }
+    *r = result;
+}
+
+static void point_double(jpoint_t *r, const jpoint_t *p) {
+    if (u256_is_zero(&p->z) || u256_is_zero(&p->y)) {
+        memset(r, 0, sizeof(*r));
+        return;
+    }
+    const modulus_t *F = &FIELD_P;
+    u256_t yy, s, m, t, x3, y3, z3;
+
+    mod_mul(&yy, &p->y, &p->y, F);
+    // s = 4 * x * y^2
+    mod_mul(&s, &p->x, &yy, F);
+    mod_add(&s, &s, &s, F);
+    mod_add(&s, &s, &s, F);
+    // m = 3 * x^2
+    mod_mul(&m, &p->x, &p->x, F);
+    mod_add(&t, &m, &m, F);
+    mod_add(&m, &t, &m, F);
+    // x3 = m^2 - 2s
+    mod_mul(&x3, &m, &m, F);
+    mod_sub(&x3, &x3, &s, F);
+    mod_sub(&x3, &x3, &s, F);
+    // y3 = m * (s - x3) - 8 * y^4
+    mod_sub(&t, &s, &x3, F);
+    mod_mul(&y3, &m, &t, F);
+    mod_mul(&t, &yy, &yy, F);
+    mod_add(&t, &t, &t, F);
+    mod_add(&t, &t, &t, F);
+    mod_add(&t, &t, &t, F);
+    mod_sub(&y3, &y3, &t, F);
+    // z3 = 2 * y * z
+    mod_mul(&z3, &p->y, &p->z, F);
+    mod_add(&z3, &z3, &z3, F);
+
+    r->x = x3;
+    r->y = y3;
+    r->z = z3;
+}
+
+static void point_add(jpoint_t *r, const jpoint_t *p, const jpoint_t *q) {
+    if (u256_is_zero(&p->z)) {
+        *r = *q;
+        return;
+    }
+    if (u256_is_zero(&q->z)) {
+        *r = *p;
+        return;
+    }
+    const modulus_t *F = &FIELD_P;
+    u256_t z1z1, z2z2, u1, u2, s1, s2, h, rr, hh, hhh, v, x3, y3, z3;
+
+    mod_mul(&z1z1, &p->z, &p->z, F);
+    mod_mul(&z2z2, &q->z, &q->z, F);
+    mod_mul(&u1, &p->x, &z2z2, F);
+    mod_mul(&u2, &q->x, &z1z1, F);
+    mod_mul(&s1, &p->y, &q->z, F);
+    mod_mul(&s1, &s1, &z2z2, F);
+    mod_mul(&s2, &q->y, &p->z, F);
+    mod_mul(&s2, &s2, &z1z1, F);
+
+    if (u256_cmp(&u1, &u2) == 0) {
+        if (u256_cmp(&s1, &s2) == 0) {
+            point_double(r, p);
+        } else {
+            memset(r, 0, sizeof(*r));
+        }
+        return;
+    }
+
+    mod_sub(&h, &u2, &u1, F);
+    mod_sub(&rr, &s2, &s1, F);
+    mod_mul(&hh, &h, &h, F);
+    mod_mul(&hhh, &hh, &h, F);
+    mod_mul(&v, &u1, &hh, F);
+
+    // x3 = r^2 - h^3 - 2 * u1 * h^2
+    mod_mul(&x3, &rr, &rr, F);
+    mod_sub(&x3, &x3, &hhh, F);
+    mod_sub(&x3, &x3, &v, F);
+    mod_sub(&x3, &x3, &v, F);
+    // y3 = r * (u1 * h^2 - x3) - s1 * h^3
+    mod_sub(&y3, &v, &x3, F);
+    mod_mul(&y3, &y3, &rr, F);
+    mod_mul(&s1, &s1, &hhh, F);
+    mod_sub(&y3, &y3, &s1, F);
+    // z3 = h * z1 * z2
+    mod_mul(&z3, &p->z, &q->z, F);
+    mod_mul(&z3, &z3, &h, F);
+
+    r->x = x3;
+    r->y = y3;
+    r->z = z3;
+}
+
+static void point_mul(jpoint_t *r, const u256_t *k, const jpoint_t *p) {
+    jpoint_t acc;
+    memset(&acc, 0, sizeof(acc));
+    for (int16_t bit = 255; bit >= 0; bit--) {
+        point_double(&acc, &acc);
+        if ((k->v[bit / 64] >> (bit % 64)) & 1) {
+            point_add(&acc, &acc, p);
+        }
+    }
+    *r = acc;
+}
+
+static void point_to_affine(u256_t *x, u256_t *y, const jpoint_t *p) {
+    u256_t zinv, zinv2, zinv3;
+    mod_inv(&zinv, &p->z, &FIELD_P);
+    mod_mul(&zinv2, &zinv, &zinv, &FIELD_P);
+    mod_mul(&zinv3, &zinv2, &zinv, &FIELD_P);
+    mod_mul(x, &p->x, &zinv2, &FIELD_P);
+    mod_mul(y, &p->y, &zinv3, &FIELD_P);
+}
+
+static bool scalar_is_valid(const u256_t *k) { return !u256_is_zero(k) && u256_cmp(k, &ORDER_N.m) < 0; }
+
+zxerr_t host_secp256k1_get_pubkey(const uint8_t sk[HOST_SECP256K1_SK_LEN], uint8_t pk[HOST_SECP256K1_PK_LEN]) {
+    if (sk == NULL || pk == NULL) {
+        return zxerr_invalid_crypto_settings;
+    }
+    u256_t k;
+    u256_from_be(&k, sk);
+    if (!scalar_is_valid(&k)) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    jpoint_t point;
+    point_mul(&point, &k, &GENERATOR);
+    u256_t x, y;
+    point_to_affine(&x, &y, &point);
+
+    pk[0] = 0x04;
+    u256_to_be(pk + 1, &x);
+    u256_to_be(pk + 33, &y);
+    return zxerr_ok;
+}
+
+static uint8_t der_write_integer(uint8_t *out, const uint8_t value[32]) {
+    uint8_t start = 0;
+    while (start < 31 && value[start] == 0) {
+        start++;
+    }
+    const uint8_t pad = (value[start] & 0x80) ? 1 : 0;
+    const uint8_t len = (uint8_t)(32 - start + pad);
+    out[0] = 0x02;
+    out[1] = len;
+    if (pad) {
+        out[2] = 0x00;
+    }
+    memcpy(out + 2 + pad, value + start, 32 - start);
+    return (uint8_t)(2 + len);
+}
+
+zxerr_t host_secp256k1_sign(const uint8_t sk[HOST_SECP256K1_SK_LEN], const uint8_t *hash, uint16_t hashLen,
+                            uint8_t *der, uint16_t *derLen, uint32_t *info) {
+    if (sk == NULL || hash == NULL || hashLen != 32 || der == NULL || derLen == NULL ||
+        *derLen < HOST_SECP256K1_DER_MAX_LEN) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    u256_t d, z;
+    u256_from_be(&d, sk);
+    if (!scalar_is_valid(&d)) {
+        return zxerr_invalid_crypto_settings;
+    }
+    u256_from_be(&z, hash);
+    mod_reduce(&z, &z, &ORDER_N);
+
+    // RFC6979 nonce generation with HMAC-SHA256
+    uint8_t V[32], K[32], zBytes[32];
+    u256_to_be(zBytes, &z);
+    memset(V, 0x01, sizeof(V));
+    memset(K, 0x00, sizeof(K));
+
+    uint8_t buf[32 + 1 + 32 + 32];
+    for (uint8_t round = 0; round < 2; round++) {
+        memcpy(buf, V, 32);
+        buf[32] = round;
+        memcpy(buf + 33, sk, 32);
+        memcpy(buf + 65, zBytes, 32);
+        host_hmac_sha256(K, sizeof(K), buf, sizeof(buf), K);
+        host_hmac_sha256(K, sizeof(K), V, sizeof(V), V);
+    }
+
+    zxerr_t err = zxerr_unknown;
+    for (uint8_t attempt = 0; attempt < 16; attempt++) {
+        host_hmac_sha256(K, sizeof(K), V, sizeof(V), V);
+
+        u256_t k;
+        u256_from_be(&k, V);
+        if (scalar_is_valid(&k)) {
+            jpoint_t R;
+            u256_t rx, ry, r, s;
+            point_mul(&R, &k, &GENERATOR);
+            point_to_affine(&rx, &ry, &R);
+
+            uint32_t tmpInfo = (ry.v[0] & 1) ? HOST_SECP256K1_INFO_PARITY_ODD : 0;
+            if (u256_cmp(&rx, &ORDER_N.m) >= 0) {
+                tmpInfo |= HOST_SECP256K1_INFO_X_GT_N;
+            }
+            mod_reduce(&r, &rx, &ORDER_N);
+
+            // s = k^-1 * (z + r * d)
+            u256_t kinv;
+            mod_mul(&s, &r, &d, &ORDER_N);
+            mod_add(&s, &s, &z, &ORDER_N);
+            mod_inv(&kinv, &k, &ORDER_N);
+            mod_mul(&s, &s, &kinv, &ORDER_N);
+
+            if (!u256_is_zero(&r) && !u256_is_zero(&s)) {
+                // Keep s in the lower half of the order
+                if (u256_cmp(&s, &HALF_N) > 0) {
+                    u256_sub(&s, &ORDER_N.m, &s);
+                    tmpInfo ^= HOST_SECP256K1_INFO_PARITY_ODD;
+                }
+
+                uint8_t rBytes[32], sBytes[32];
+                u256_to_be(rBytes, &r);
+                u256_to_be(sBytes, &s);
+
+                uint8_t offset = 2;
+                offset += der_write_integer(der + offset, rBytes);
+                offset += der_write_integer(der + offset, sBytes);
+                der[0] = 0x30;
+                der[1] = (uint8_t)(offset - 2);
+                *derLen = offset;
+                if (info != NULL) {
+                    *info = tmpInfo;
+                }
+                err = zxerr_ok;
+                break;
+            }
+        }
+
+        memcpy(buf, V, 32);
+        buf[32] = 0x00;
+        host_hmac_sha256(K, sizeof(K), buf, 33, K);
+        host_hmac_sha256(K, sizeof(K), V, sizeof(V), V);
+    }
+
+    memset(K, 0, sizeof(K));
+    memset(V, 0, sizeof(V));
+    memset(buf, 0, sizeof(buf));
+    memset(&d, 0, sizeof(d));
+    return err;
+}
+
+void host_bip39_seed(const char *mnemonic, const char *passphrase, uint8_t seed[HOST_BIP39_SEED_LEN]) {
+    char salt[128] = "mnemonic";
+    const size_t passLen = passphrase != NULL ? strlen(passphrase) : 0;
+    if (passLen > sizeof(salt) - strlen("mnemonic") - 1) {
+        memset(seed, 0, HOST_BIP39_SEED_LEN);
+        return;
+    }
+    if (passLen > 0) {
+        memcpy(salt + strlen("mnemonic"), passphrase, passLen + 1);
+    }
+    host_pbkdf2_sha512((const uint8_t *)mnemonic, strlen(mnemonic), (const uint8_t *)salt, strlen(salt), 2048, seed,
+                       HOST_BIP39_SEED_LEN);
+}
+
+zxerr_t host_bip32_derive(const uint8_t *seed, uint16_t seedLen, const uint32_t *path, uint8_t pathLen,
+                          uint8_t sk[HOST_SECP256K1_SK_LEN], uint8_t *chainCode) {
+    if (seed == NULL || sk == NULL || (path == NULL && pathLen > 0)) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    static const char BIP32_KEY[] = "Bitcoin seed";
+    uint8_t I[HOST_SHA512_SIZE];
+    host_hmac_sha512((const uint8_t *)BIP32_KEY, sizeof(BIP32_KEY) - 1, seed, seedLen, I);
+
+    u256_t k;
+    u256_from_be(&k, I);
+    if (!scalar_is_valid(&k)) {
+        memset(I, 0, sizeof(I));
+        return zxerr_invalid_crypto_settings;
+    }
+    uint8_t key[32], chain[32];
+    memcpy(key, I, 32);
+    memcpy(chain, I + 32, 32);
+
+    zxerr_t err = zxerr_ok;
+    for (uint8_t i = 0; i < pathLen && err == zxerr_ok; i++) {
+        uint8_t data[37];
+        if (path[i] & 0x80000000u) {
+            data[0] = 0x00;
+            memcpy(data + 1, key, 32);
+        } else {
+            uint8_t pk[HOST_SECP256K1_PK_LEN];
+            err = host_secp256k1_get_pubkey(key, pk);
+            data[0] = (pk[64] & 1) ? 0x03 : 0x02;
+            memcpy(data + 1, pk + 1, 32);
+        }
+        data[33] = (uint8_t)(path[i] >> 24);
+        data[34] = (uint8_t)(path[i] >> 16);
+        data[35] = (uint8_t)(path[i] >> 8);
+        data[36] = (uint8_t)path[i];
+
+        host_hmac_sha512(chain, sizeof(chain), data, sizeof(data), I);
+        memset(data, 0, sizeof(data));
+
+        u256_t il;
+        u256_from_be(&il, I);
+        u256_from_be(&k, key);
+        if (u256_cmp(&il, &ORDER_N.m) >= 0) {
+            err = zxerr_invalid_crypto_settings;
+            break;
+        }
+        mod_add(&k, &k, &il, &ORDER_N);
+        if (u256_is_zero(&k)) {
+            err = zxerr_invalid_crypto_settings;
+            break;
+        }
+        u256_to_be(key, &k);
+        memcpy(chain, I + 32, 32);
+    }
+
+    if (err == zxerr_ok) {
+        memcpy(sk, key, 32);
+        if (chainCode != NULL) {
+            memcpy(chainCode, chain, 32);
+        }
+    }
+
+    memset(I, 0, sizeof(I));
+    memset(key, 0, sizeof(key));
+    memset(chain, 0, sizeof(chain));
+    memset(&k, 0, sizeof(k));
+    return err;
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Software secp256k1, BIP32 and BIP39 for host builds.
+// This code is NOT constant time and must never be used to handle real keys;
+// it only exists so tests, benchmarks and the simulator can exercise the
+// signing paths with the well known test mnemonic.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zxerror.h"
+
+#define HOST_SECP256K1_SK_LEN 32u
+#define HOST_SECP256K1_PK_LEN 65u
+#define HOST_SECP256K1_DER_MAX_LEN 72u
+#define HOST_BIP32_CHAIN_CODE_LEN 32u
+#define HOST_BIP39_SEED_LEN 64u
+
+// Same meaning as CX_ECCINFO_PARITY_ODD / CX_ECCINFO_xGTn in the SDK
+#define HOST_SECP256K1_INFO_PARITY_ODD 1u
+#define HOST_SECP256K1_INFO_X_GT_N 2u
+
+// Mnemonic loaded on the emulator by the zemu tests
+#define HOST_TEST_MNEMONIC "equip will roof matter pink blind book anxiety banner elbow sun young"
+
+// Uncompressed (0x04 || X || Y) public key of a private key
+zxerr_t host_secp256k1_get_pubkey(const uint8_t sk[HOST_SECP256K1_SK_LEN], uint8_t pk[HOST_SECP256K1_PK_LEN]);
+
+// Deterministic (RFC6979, HMAC-SHA256) ECDSA signature with low-S normalization.
+// Writes a DER signature and the recovery information bits.
+zxerr_t host_secp256k1_sign(const uint8_t sk[HOST_SECP256K1_SK_LEN], const uint8_t *hash, uint16_t hashLen,
+                            uint8_t *der, uint16_t *derLen, uint32_t *info);
+
+// BIP39 mnemonic (already normalized) to 64 byte seed
+void host_bip39_seed(const char *mnemonic, const char *passphrase, uint8_t seed[HOST_BIP39_SEED_LEN]);
+
+// BIP32 private derivation from a seed. chainCode may be NULL.
+zxerr_t host_bip32_derive(const uint8_t *seed, uint16_t seedLen, const uint32_t *path, uint8_t pathLen,
+                          uint8_t sk[HOST_SECP256K1_SK_LEN], uint8_t *chainCode);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#if !defined(LEDGER_SPECIFIC)
+
+#include "host_stack.h"
+
+#include <stddef.h>
+
+#define HOST_STACK_PATTERN 0xA5u
+#define HOST_STACK_SHADOW_DEPTH 256u
+
+// The probes must not show up in what they measure
+#define STACK_PROBE __attribute__((noinline, no_instrument_function, no_sanitize_address))
+
+typedef struct {
+    const void *fn;
+    uintptr_t frame;
+} shadow_frame_t;
+
+static uintptr_t stack_window = 0;
+
+static shadow_frame_t shadow[HOST_STACK_SHADOW_DEPTH];
+static uint16_t shadow_len = 0;
+static uintptr_t trace_top = 0;
+static host_stack_path_t trace_worst;
+
+STACK_PROBE void host_stack_paint(void) {
+    volatile uint8_t window[HOST_STACK_WINDOW];
+    for (uint32_t i = 0; i < sizeof(window); i++) {
+        window[i] = HOST_STACK_PATTERN;
+    }
+    stack_window = (uintptr_t)window;
+}
+
+STACK_PROBE uint32_t host_stack_peak(uintptr_t top) {
+    const volatile uint8_t *window = (const volatile uint8_t *)stack_window;
+    uint32_t i = 0;
+    while (i < HOST_STACK_WINDOW && window[i] == HOST_STACK_PATTERN) {
+        i++;
+    }
+    const uintptr_t deepest = stack_window + i;
+    return deepest < top ? (uint32_t)(top - deepest) : 0;
+}
+
+STACK_PROBE void host_stack_trace_start(uintptr_t top) {
+    trace_top = top;
+    trace_worst.depth = 0;
+    trace_worst.pathLen = 0;
+    trace_worst.truncated = false;
+}
+
+STACK_PROBE const host_stack_path_t *host_stack_trace_worst(void) { return &trace_worst; }
+
+// Entries below frame belong to calls that were left by a longjmp. Inlined
+// callees share their caller's frame, so equal frames are kept.
+STACK_PROBE static void shadow_unwind(uintptr_t frame) {
+    while (shadow_len > 0 && shadow[shadow_len - 1].frame < frame) {
+        shadow_len--;
+    }
+}
+
+STACK_PROBE static void trace_record(uintptr_t frame) {
+    if (trace_top == 0 || frame >= trace_top || trace_top - frame <= trace_worst.depth) {
+        return;
+    }
+    trace_worst.depth = (uint32_t)(trace_top - frame);
+    trace_worst.pathLen = 0;
+    trace_worst.truncated = false;
+    for (uint16_t i = 0; i < shadow_len; i++) {
+        if (shadow[i].frame >= trace_top) {
+            continue;
+        }
+        if (trace_worst.pathLen == HOST_STACK_MAX_PATH) {
+            trace_worst.truncated = true;
+            break;
+        }
+        trace_worst.path[trace_worst.pathLen++] = shadow[i].fn;
+    }
+}
+
+void __cyg_profile_func_enter(void *fn, void *callSite);
+void __cyg_profile_func_exit(void *fn, void *callSite);
+
+// -finstrument-functions calls these after the prologue of every instrumented
+// function, so the hook's frame sits right below the caller's locals.
+STACK_PROBE void __cyg_profile_func_enter(void *fn, void *callSite) {
+    (void)callSite;
+    const uintptr_t frame = (uintptr_t)__builtin_frame_address(0);
+    shadow_unwind(frame);
+    if (shadow_len < HOST_STACK_SHADOW_DEPTH) {
+        shadow[shadow_len].fn = fn;
+        shadow[shadow_len].frame = frame;
+        shadow_len++;
+    }
+    trace_record(frame);
+}
+
+STACK_PROBE void __cyg_profile_func_exit(void *fn, void *callSite) {
+    (void)callSite;
+    shadow_unwind((uintptr_t)__builtin_frame_address(0));
+    if (shadow_len > 0 && shadow[shadow_len - 1].fn == fn) {
+        shadow_len--;
+    }
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Stack measurement for host builds (simulator, stack report).
+//
+// Painting fills a window below the caller with a pattern; after the code
+// under test ran, the deepest overwritten byte gives its peak stack use. When
+// the app code is also compiled with -finstrument-functions (ENABLE_STACK_USAGE)
+// the entry hooks keep a shadow call stack and remember the call path that
+// reached the deepest frame. Neither is meaningful with ASAN, which moves
+// frames off the real stack. Nothing in here is compiled for LEDGER_SPECIFIC.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Bytes painted below the caller. Anything deeper is reported as the full window.
+#define HOST_STACK_WINDOW (64u * 1024u)
+#define HOST_STACK_MAX_PATH 64u
+
+typedef struct {
+    // Stack used below the trace top when the deepest function was entered, its own frame included
+    uint32_t depth;
+    // Functions from the outermost instrumented caller down to the deepest one
+    const void *path[HOST_STACK_MAX_PATH];
+    uint8_t pathLen;
+    // The call chain was deeper than HOST_STACK_MAX_PATH; the outermost entries are kept
+    bool truncated;
+} host_stack_path_t;
+
+// Paints the window below the caller's frame
+void host_stack_paint(void);
+
+// Peak stack use since the last host_stack_paint, measured from top (an address in the caller's frame)
+uint32_t host_stack_peak(uintptr_t top);
+
+// Starts recording the deepest call path below top. Only records with -finstrument-functions.
+void host_stack_trace_start(uintptr_t top);
+
+// Deepest path since host_stack_trace_start. pathLen is 0 without instrumentation.
+const host_stack_path_t *host_stack_trace_worst(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include "item_cache.h"
+
+#include <string.h>
+
+#include "zxmacros.h"
+
+typedef struct {
+    // 0 means the slot is empty, higher values were used more recently
+    uint32_t lastUsed;
+    uint16_t displayIdx;
+    bool expert;
+    // Page boundaries depend on the size of the buffer the pages were rendered into
+    uint16_t outValLen;
+    uint8_t pageCount;
+    uint8_t pagesStored;
+    // value[pageEnd[i - 1]..pageEnd[i]) is page i
+    uint16_t pageEnd[ITEM_CACHE_MAX_PAGES];
+    char key[ITEM_CACHE_KEY_SIZE];
+    char value[ITEM_CACHE_VALUE_SIZE];
+} item_cache_entry_t;
+
+static item_cache_entry_t cache_entries[ITEM_CACHE_ENTRIES];
+static uint32_t cache_clock = 0;
+
+void item_cache_reset(void) {
+    MEMZERO(cache_entries, sizeof(cache_entries));
+    cache_clock = 0;
+}
+
+static item_cache_entry_t *item_cache_find(uint16_t displayIdx, bool expert, uint16_t outValLen) {
+    for (uint8_t i = 0; i < ITEM_CACHE_ENTRIES; i++) {
+        item_cache_entry_t *entry = &cache_entries[i];
+        if (entry->lastUsed != 0 && entry->displayIdx == displayIdx && entry->expert == expert &&
+            entry->outValLen == outValLen) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static uint32_t item_cache_tick(void) {
+    cache_clock++;
+    if (cache_clock == 0) {
+        // The counter wrapped around; start over rather than mixing up the eviction order
+        item_cache_reset();
+        cache_clock = 1;
+    }
+    return cache_clock;
+}
+
+bool item_cache_lookup(uint16_t displayIdx, bool expert, char *outKey, uint16_t outKeyLen, char *outVal, uint16_t outValLen,
+                       uint8_t pageIdx, uint8_t *pageCount) {
+    if (outKey == NULL || outVal == NULL || pageCount == NULL || outKeyLen == 0 || outValLen == 0) {
+        return false;
+    }
+
+    item_cache_entry_t *entry = item_cache_find(displayIdx, expert, outValLen);
+    if (entry == NULL || pageIdx >= entry->pagesStored || strlen(entry->key) >= outKeyLen) {
+        return false;
+    }
+
+    const uint16_t pageStart = pageIdx == 0 ? 0 : entry->pageEnd[pageIdx - 1];
+    const uint16_t pageLen = entry->pageEnd[pageIdx] - pageStart;
+
+    MEMZERO(outKey, outKeyLen);
+    MEMZERO(outVal, outValLen);
+    MEMCPY(outKey, entry->key, strlen(entry->key));
+    MEMCPY(outVal, entry->value + pageStart, pageLen);
+    *pageCount = entry->pageCount;
+
+    entry->lastUsed = item_cache_tick();
+    return true;
+}
+
+void item_cache_store(uint16_t displayIdx, bool expert, const char *key, const char *val, uint16_t outValLen,
+                      uint8_t pageIdx, uint8_t pageCount) {
+    if (key == NULL || val == NULL || pageIdx >= ITEM_CACHE_MAX_PAGES || pageIdx >= pageCount) {
+        return;
+    }
+    const size_t keyLen = strlen(key);
+    const size_t valLen = strlen(val);
+    if (keyLen >= ITEM_CACHE_KEY_SIZE) {
+        return;
+    }
+
+    item_cache_entry_t *entry = item_cache_find(displayIdx, expert, outValLen);
+    if (entry == NULL) {
+        if (pageIdx != 0) {
+            return;
+        }
+
+        // Pick an empty slot or the least recently used one
+        entry = &cache_entries[0];
+        for (uint8_t i = 1; i < ITEM_CACHE_ENTRIES && entry->lastUsed != 0; i++) {
+            if (cache_entries[i].lastUsed < entry->lastUsed) {
+                entry = &cache_entries[i];
+            }
+        }
+
+        MEMZERO(entry, sizeof(*entry));
+        entry->displayIdx = displayIdx;
+        entry->expert = expert;
+        entry->outValLen = outValLen;
+        entry->pageCount = pageCount;
+        MEMCPY(entry->key, key, keyLen);
+    }
+
+    if (pageIdx != entry->pagesStored || pageCount != entry->pageCount) {
+        // Not the next page, or the item changed under us
+        return;
+    }
+
+    const uint16_t pageStart = pageIdx == 0 ? 0 : entry->pageEnd[pageIdx - 1];
+    if (valLen > ITEM_CACHE_VALUE_SIZE - pageStart) {
+        return;
+    }
+
+    MEMCPY(entry->value + pageStart, val, valLen);
+    entry->pageEnd[pageIdx] = pageStart + (uint16_t)valLen;
+    entry->pagesStored++;
+    entry->lastUsed = item_cache_tick();
+}
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Pages of recently shown review items.
+// Each entry holds the key of one display item and the pages of its value
+// rendered so far, in order, so scrolling back and forth through a long value
+// copies them instead of formatting the item again. Entries are only valid for
+// the transaction being reviewed.
+#if defined(TARGET_NANOS)
+#define ITEM_CACHE_ENTRIES 1u
+#define ITEM_CACHE_VALUE_SIZE 128u
+#else
+#define ITEM_CACHE_ENTRIES 4u
+#define ITEM_CACHE_VALUE_SIZE 384u
+#endif
+#define ITEM_CACHE_KEY_SIZE 40u
+#define ITEM_CACHE_MAX_PAGES 16u
+
+// Drops every entry. Called whenever a new transaction is parsed.
+void item_cache_reset(void);
+
+// Copies the cached key and value page for the item.
+// Returns false on a cache miss, leaving the output buffers untouched.
+bool item_cache_lookup(uint16_t displayIdx, bool expert, char *outKey, uint16_t outKeyLen, char *outVal, uint16_t outValLen,
+                       uint8_t pageIdx, uint8_t *pageCount);
+
+// Stores a page rendered for the item. Pages are kept only when they follow the
+// ones already stored and fit, evicting the least recently used entry when the
+// item is not cached yet.
+void item_cache_store(uint16_t displayIdx, bool expert, const char *key, const char *val, uint16_t outValLen,
+                      uint8_t pageIdx, uint8_t pageCount);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "json_pages.h"
+
+#include <zxmacros.h>
+
+#define JSON_PAGES_IN_STRING 0x01u
+// The previous character was a backslash inside a string
+#define JSON_PAGES_ESCAPE 0x02u
+
+static bool json_pages_isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+// Walks the source from pos until n characters were printed or the span ends, and stores them in out when given.
+// Returns the number of characters printed.
+static uint16_t json_pages_emit(const char *span, uint16_t spanLen, json_pages_pos_t *pos, char *out, uint16_t n) {
+    uint16_t printed = 0;
+    while (pos->offset < spanLen && printed < n) {
+        const char c = span[pos->offset];
+        bool print = true;
+
+        if (!(pos->state & JSON_PAGES_IN_STRING)) {
+            if (json_pages_isSpace(c)) {
+                print = false;
+            } else if (c == '"') {
+                pos->state = JSON_PAGES_IN_STRING;
+            }
+        } else if (pos->state & JSON_PAGES_ESCAPE) {
+            pos->state &= ~JSON_PAGES_ESCAPE;
+        } else if (c == '\\') {
+            pos->state |= JSON_PAGES_ESCAPE;
+        } else if (c == '"') {
+            pos->state = 0;
+        }
+
+        if (print) {
+            if (out != NULL) {
+                out[printed] = c;
+            }
+            printed++;
+        }
+        pos->offset++;
+    }
+    return printed;
+}
+
+static uint16_t json_pages_pack(const json_pages_pos_t *pos) {
+    return (uint16_t)(pos->offset | ((uint16_t)pos->state << JSON_PAGES_OFFSET_BITS));
+}
+
+static json_pages_pos_t json_pages_unpack(uint16_t start) {
+    const json_pages_pos_t pos = {
+        .offset = (uint16_t)(start & ((1u << JSON_PAGES_OFFSET_BITS) - 1)),
+        .state = (uint8_t)(start >> JSON_PAGES_OFFSET_BITS),
+    };
+    return pos;
+}
+
+static parser_error_t json_pages_index(json_pages_t *pages, const char *span, uint16_t spanLen, uint16_t pageLen) {
+    if (spanLen >= (1u << JSON_PAGES_OFFSET_BITS)) {
+        return parser_value_out_of_range;
+    }
+
+    MEMZERO(pages, sizeof(*pages));
+    pages->span = span;
+    pages->span_len = spanLen;
+    pages->page_len = pageLen;
+
+    json_pages_pos_t pos = {0};
+    uint16_t page = 0;
+    while (true) {
+        const uint16_t start = json_pages_pack(&pos);
+        const uint16_t printed = json_pages_emit(span, spanLen, &pos, NULL, pageLen);
+        if (printed == 0) {
+            break;
+        }
+        if (page == JSON_PAGES_MAX) {
+            return parser_value_out_of_range;
+        }
+        pages->starts[page++] = start;
+        if (printed < pageLen) {
+            break;
+        }
+    }
+
+    // Like an empty string, nothing to print is still one page
+    pages->page_count = page == 0 ? 1 : (uint8_t)page;
+    pages->valid = true;
+    return parser_ok;
+}
+
+parser_error_t json_pages_render(json_pages_t *pages, const char *span, uint16_t spanLen, char *outVal,
+                                 uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    if (pages == NULL || span == NULL || outVal == NULL || outValLen < 2 || pageCount == NULL) {
+        return parser_unexpected_value;
+    }
+    MEMZERO(outVal, outValLen);
+    *pageCount = 0;
+
+    const uint16_t pageLen = outValLen - 1;
+    if (!pages->valid || pages->span != span || pages->span_len != spanLen || pages->page_len != pageLen) {
+        const parser_error_t err = json_pages_index(pages, span, spanLen, pageLen);
+        if (err != parser_ok) {
+            pages->valid = false;
+            return err;
+        }
+    }
+
+    *pageCount = pages->page_count;
+    if (pageIdx >= pages->page_count) {
+        return parser_display_page_out_of_range;
+    }
+
+    json_pages_pos_t pos = json_pages_unpack(pages->starts[pageIdx]);
+    json_pages_emit(span, spanLen, &pos, outVal, pageLen);
+    return parser_ok;
+}
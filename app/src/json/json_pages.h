@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "parser_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Most pages a span can have, page counts are 8 bits
+#define JSON_PAGES_MAX 255u
+// Page starts keep the source offset below this bit and the string state above it, spans have to be shorter
+#define JSON_PAGES_OFFSET_BITS 14u
+
+// Where a page starts in the source text, with the string state the walk had there
+typedef struct {
+    uint16_t offset;
+    uint8_t state;
+} json_pages_pos_t;
+
+// Page boundaries of the last span rendered
+typedef struct {
+    bool valid;
+    const char *span;
+    uint16_t span_len;
+    uint16_t page_len;
+    uint8_t page_count;
+    // Start of each page, packed as described at JSON_PAGES_OFFSET_BITS
+    uint16_t starts[JSON_PAGES_MAX];
+} json_pages_t;
+
+// Renders page pageIdx of the JSON text span[0..spanLen) printed compactly: whitespace outside strings is left out,
+// everything else, quotes included, is shown as signed. The pages of a span are counted once, for each page size, and
+// the start of every page is kept, so rendering a page only walks the source text of that page. Text that needs more
+// than 255 pages is refused.
+parser_error_t json_pages_render(json_pages_t *pages, const char *span, uint16_t spanLen, char *outVal,
+                                 uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount);
+
+#ifdef __cplusplus
+}
+#endif
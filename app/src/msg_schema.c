@@ -0,0 +1,59 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "msg_schema.h"
+
+#include <string.h>
+#include <zxmacros.h>
+
+// MultiSend shows each input and output on its own. MsgExec spends what the granter allowed, not coins of the
+// signer, so the amounts of the messages it wraps are not totaled.
+static const msg_schema_t msg_schemas[] = {
+    [MSG_SCHEMA_UNKNOWN] = {NULL, MSG_SCHEMA_DEFAULT_LEVEL, NULL, NULL},
+    {"cosmos-sdk/MsgSend", MSG_SCHEMA_DEFAULT_LEVEL, "amount", NULL},
+    {"cosmos-sdk/MsgMultiSend", 3, "inputs/coins", NULL},
+    {"cosmos-sdk/MsgDelegate", MSG_SCHEMA_DEFAULT_LEVEL, "amount", NULL},
+    {"cosmos-sdk/MsgExecuteContract", MSG_SCHEMA_DEFAULT_LEVEL, "funds", NULL},
+    {"wasm/MsgExecuteContract", MSG_SCHEMA_DEFAULT_LEVEL, "funds", NULL},
+    {"cosmos-sdk/MsgExec", MSG_SCHEMA_DEFAULT_LEVEL, NULL, "msgs"},
+};
+
+uint8_t msg_schema_find(const char *type, uint16_t typeLen) {
+    if (type == NULL) {
+        return MSG_SCHEMA_UNKNOWN;
+    }
+
+    for (uint8_t i = MSG_SCHEMA_UNKNOWN + 1; i < array_length(msg_schemas); i++) {
+        const char *schemaType = (const char *)PIC(msg_schemas[i].type);
+        if (strlen(schemaType) == typeLen && memcmp(schemaType, type, typeLen) == 0) {
+            return i;
+        }
+    }
+    return MSG_SCHEMA_UNKNOWN;
+}
+
+const msg_schema_t *msg_schema_get(uint8_t idx) {
+    if (idx >= array_length(msg_schemas)) {
+        idx = MSG_SCHEMA_UNKNOWN;
+    }
+    return &msg_schemas[idx];
+}
+
+bool msg_schema_isAmountField(const msg_schema_t *schema, const char *field) {
+    if (schema == NULL || schema->amount_field == NULL || field == NULL) {
+        return false;
+    }
+    return strcmp(field, (const char *)PIC(schema->amount_field)) == 0;
+}
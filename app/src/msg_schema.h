@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Levels of a message flattened into item keys (msgs/type, msgs/value/<field>), deeper values are shown as JSON
+#define MSG_SCHEMA_DEFAULT_LEVEL 2
+// Schema of the message types that are not in the table
+#define MSG_SCHEMA_UNKNOWN 0
+
+// How the messages of one amino type are shown
+typedef struct {
+    // Strings are link time addresses, read them through PIC
+    const char *type;
+    // Levels flattened into item keys
+    uint8_t display_level;
+    // Field of value with the coins the signer spends, NULL when the message spends nothing of the signer
+    const char *amount_field;
+    // Field of value with the messages this one wraps. They are flattened too, with the deepest level among them,
+    // so display_level has to reach down to this field.
+    const char *nested_field;
+} msg_schema_t;
+
+// Returns the index of the schema of type[0..typeLen), MSG_SCHEMA_UNKNOWN when it has none
+uint8_t msg_schema_find(const char *type, uint16_t typeLen);
+
+// Returns the schema at idx, the one of unknown types when idx is out of range
+const msg_schema_t *msg_schema_get(uint8_t idx);
+
+// Whether field, the path of a value item below msgs/value (e.g. "inputs/coins"), holds the coins schema spends
+bool msg_schema_isAmountField(const msg_schema_t *schema, const char *field);
+
+#ifdef __cplusplus
+}
+#endif
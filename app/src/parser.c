@@ -27,7 +27,9 @@
 #include "parser_common.h"
 #include "parser_impl.h"
 #include "parser_print.h"
+#include "parser_totals.h"
 #include "parser_validate.h"
+#include "scratch.h"
 
 parser_error_t parser_init_context(parser_context_t *ctx, const uint8_t *buffer, uint16_t bufferSize) {
     if (ctx == NULL || buffer == NULL) {
@@ -49,61 +51,72 @@ parser_error_t parser_init_context(parser_context_t *ctx, const uint8_t *buffer,
     return parser_ok;
 }
 
-parser_error_t parser_parse(parser_context_t *ctx, const uint8_t *data, size_t dataLen) {
-    if (ctx == NULL || data == NULL) {
+parser_error_t parser_parse(parser_context_t *ctx, const uint8_t *data, size_t dataLen, parser_tx_t *tx_obj) {
+    if (ctx == NULL || data == NULL || tx_obj == NULL) {
         return parser_unexpected_error;
     }
     CHECK_ERROR(parser_init_context(ctx, data, dataLen))
+    ctx->tx_obj = tx_obj;
     app_mode_skip_blindsign_ui();
     return _read(ctx);
 }
 
 parser_error_t parser_validate(const parser_context_t *ctx) {
+    if (ctx == NULL || ctx->tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
     if (ctx->buffer == NULL || ctx->bufferLen == 0) {
         return parser_init_context_empty;
     }
 
-    CHECK_ERROR(parser_json_validate(&parser_tx_obj.json))
+    CHECK_ERROR(parser_json_validate(&ctx->tx_obj->json))
 
     // Iterate through all items to check that all can be shown and are valid
-    uint8_t numItems = 0;
+    uint16_t numItems = 0;
     CHECK_ERROR(parser_getNumItems(ctx, &numItems))
 
-    char tmpKey[40] = {0};
-    char tmpVal[40] = {0};
+    const scratch_mark_t mark = scratch_mark();
+    char *tmpKey = scratch_alloc(VALIDATE_KEY_SIZE);
+    char *tmpVal = scratch_alloc(VALIDATE_VALUE_SIZE);
+    parser_error_t err = tmpKey != NULL && tmpVal != NULL ? parser_ok : parser_unexpected_error;
+
     uint8_t pageCount = 0;
-    for (uint8_t idx = 0; idx < numItems; idx++) {
-        CHECK_ERROR(parser_getItem(ctx, idx, tmpKey, sizeof(tmpKey), tmpVal, sizeof(tmpVal), 0, &pageCount))
+    for (uint16_t idx = 0; idx < numItems && err == parser_ok; idx++) {
+        err = parser_getItem(ctx, idx, tmpKey, VALIDATE_KEY_SIZE, tmpVal, VALIDATE_VALUE_SIZE, 0, &pageCount);
     }
-    return parser_ok;
+    scratch_release(mark);
+    return err;
 }
 
-parser_error_t parser_getNumItems(const parser_context_t *ctx, uint8_t *num_items) {
-    if (ctx == NULL || num_items == NULL) {
+parser_error_t parser_getNumItems(const parser_context_t *ctx, uint16_t *num_items) {
+    if (ctx == NULL || ctx->tx_obj == NULL || num_items == NULL) {
         return parser_unexpected_error;
     }
-    UNUSED(ctx);
     *num_items = 1;
     if (*num_items == 0) {
         return parser_unexpected_number_items;
     }
 
-    return parser_display_numItems(num_items);
+    return parser_display_numItems(ctx->tx_obj, num_items);
 }
 
-parser_error_t parser_getItem(const parser_context_t *ctx, uint8_t displayIdx, char *outKey, uint16_t outKeyLen,
-                              char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
-    if (ctx == NULL || outKey == NULL || outVal == NULL || pageCount == NULL) {
-        return parser_unexpected_error;
-    }
-    *pageCount = 0;
-    char tmpKey[35] = {0};
-    char tmpVal[2] = {0};
+// Key and value the display query fills, taken from the scratch arena. The key holds the raw path, sized like the
+// one used while indexing so the deepest path the message schemas flatten (four levels through MsgExec) fits.
+typedef struct {
+    char key[INDEXING_TMP_KEYSIZE];
+    char val[2];
+} item_query_scratch_t;
+
+static parser_error_t get_item(const parser_context_t *ctx, item_query_scratch_t *tmp, uint16_t displayIdx, char *outKey,
+                               uint16_t outKeyLen, char *outVal, uint16_t outValLen, uint8_t pageIdx,
+                               uint8_t *pageCount) {
+    parser_tx_t *tx_obj = ctx->tx_obj;
+    char *tmpKey = tmp->key;
 
     MEMZERO(outKey, outKeyLen);
     MEMZERO(outVal, outValLen);
 
-    uint8_t numItems = 0;
+    uint16_t numItems = 0;
     CHECK_ERROR(parser_getNumItems(ctx, &numItems))
     CHECK_APP_CANARY()
 
@@ -116,23 +129,48 @@ parser_error_t parser_getItem(const parser_context_t *ctx, uint8_t displayIdx, c
     }
 
     uint16_t ret_value_token_index = 0;
-    CHECK_ERROR_CLEAN_QUERY(
-        parser_display_query(displayIdx, tmpKey, sizeof(tmpKey), tmpVal, sizeof(tmpVal), &ret_value_token_index))
+    CHECK_ERROR_CLEAN_QUERY(tx_obj, parser_display_query(tx_obj, displayIdx, tmpKey, sizeof(tmp->key), tmp->val,
+                                                         sizeof(tmp->val), &ret_value_token_index))
     CHECK_APP_CANARY()
     snprintf(outKey, outKeyLen, "%s", tmpKey);
 
-    if (parser_isAmount(tmpKey)) {
-        CHECK_ERROR_CLEAN_QUERY(parser_formatAmount(ret_value_token_index, outVal, outValLen, pageIdx, pageCount))
+    if (strcmp(tmpKey, get_required_root_item(root_item_total)) == 0) {
+        CHECK_ERROR_CLEAN_QUERY(tx_obj, parser_totals_format(&tx_obj->display_cache.totals, &tx_obj->json,
+                                                             ret_value_token_index, outVal, outValLen, pageIdx, pageCount))
+    } else if (parser_isAmount(tmpKey)) {
+        CHECK_ERROR_CLEAN_QUERY(tx_obj,
+                                parser_formatAmount(tx_obj, ret_value_token_index, outVal, outValLen, pageIdx, pageCount))
+    } else if (parser_isContractMsg(tmpKey)) {
+        CHECK_ERROR_CLEAN_QUERY(
+            tx_obj, parser_formatContractMsg(tx_obj, ret_value_token_index, outVal, outValLen, pageIdx, pageCount))
     } else {
-        CHECK_ERROR_CLEAN_QUERY(parser_getToken(ret_value_token_index, outVal, outValLen, pageIdx, pageCount))
+        CHECK_ERROR_CLEAN_QUERY(tx_obj,
+                                parser_getToken(tx_obj, ret_value_token_index, outVal, outValLen, pageIdx, pageCount))
     }
     CHECK_APP_CANARY()
 
-    CHECK_ERROR_CLEAN_QUERY(parser_display_make_friendly())
+    CHECK_ERROR_CLEAN_QUERY(tx_obj, parser_display_make_friendly(tx_obj))
     CHECK_APP_CANARY()
 
     snprintf(outKey, outKeyLen, "%s", tmpKey);
     CHECK_APP_CANARY()
-    CLEAN_QUERY()
+    CLEAN_QUERY(tx_obj)
     return parser_ok;
 }
+
+parser_error_t parser_getItem(const parser_context_t *ctx, uint16_t displayIdx, char *outKey, uint16_t outKeyLen,
+                              char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    if (ctx == NULL || ctx->tx_obj == NULL || outKey == NULL || outVal == NULL || pageCount == NULL) {
+        return parser_unexpected_error;
+    }
+    *pageCount = 0;
+
+    const scratch_mark_t mark = scratch_mark();
+    item_query_scratch_t *tmp = scratch_alloc(sizeof(item_query_scratch_t));
+    if (tmp == NULL) {
+        return parser_unexpected_error;
+    }
+    const parser_error_t err = get_item(ctx, tmp, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+    scratch_release(mark);
+    return err;
+}
@@ -0,0 +1,310 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include "parser_batch.h"
+
+#include <zxformat.h>
+#include <zxmacros.h>
+
+#include "parser_print.h"
+
+#define BATCH_MSG_TYPE "cosmos-sdk/MsgSend"
+
+// Every field of a batch transaction is either summarized or deliberately left out of the review (account number,
+// sequence and gas). Objects with more fields than these are refused instead of being signed unseen.
+#define BATCH_ROOT_FIELDS 6u  // account_number, chain_id, fee, memo, msgs, sequence
+#define BATCH_FEE_FIELDS 2u   // amount, gas
+#define BATCH_MSG_FIELDS 2u   // type, value
+#define BATCH_SEND_FIELDS 3u  // amount, from_address, to_address
+#define BATCH_COIN_FIELDS 2u  // amount, denom
+
+static bool batch_tokenEquals(const parsed_json_t *json, uint16_t token, const char *expected) {
+    if (json->tokens[token].type != JSMN_STRING) {
+        return false;
+    }
+    const int32_t len = json->tokens[token].end - json->tokens[token].start;
+    if (len < 0 || strlen(expected) != (size_t)len) {
+        return false;
+    }
+    return memcmp(json->buffer + json->tokens[token].start, expected, len) == 0;
+}
+
+static parser_error_t batch_getString(const parsed_json_t *json, uint16_t token, char *out, uint16_t outLen) {
+    if (json->tokens[token].type != JSMN_STRING) {
+        return parser_unexpected_type;
+    }
+    const int32_t len = json->tokens[token].end - json->tokens[token].start;
+    if (len < 0 || (uint32_t)len >= outLen) {
+        return parser_value_out_of_range;
+    }
+    MEMZERO(out, outLen);
+    MEMCPY(out, json->buffer + json->tokens[token].start, len);
+    return parser_ok;
+}
+
+static parser_error_t batch_expectObject(const parsed_json_t *json, uint16_t token, uint16_t numFields) {
+    if (json->tokens[token].type != JSMN_OBJECT) {
+        return parser_unexpected_type;
+    }
+    uint16_t count = 0;
+    CHECK_ERROR(object_get_element_count(json, token, &count))
+    if (count != numFields) {
+        return parser_batch_unsupported_tx;
+    }
+    return parser_ok;
+}
+
+static parser_error_t batch_add(uint64_t *total, uint64_t amount) {
+    if (*total > UINT64_MAX - amount) {
+        return parser_value_out_of_range;
+    }
+    *total += amount;
+    return parser_ok;
+}
+
+// Coin amounts are unsigned integers written as decimal strings
+static parser_error_t batch_getAmount(const parsed_json_t *json, uint16_t token, uint64_t *amount) {
+    if (json->tokens[token].type != JSMN_STRING) {
+        return parser_unexpected_type;
+    }
+    const int32_t len = json->tokens[token].end - json->tokens[token].start;
+    if (len <= 0) {
+        return parser_unexpected_value;
+    }
+
+    const char *digits = json->buffer + json->tokens[token].start;
+    *amount = 0;
+    for (int32_t i = 0; i < len; i++) {
+        if (digits[i] < '0' || digits[i] > '9') {
+            return parser_unexpected_characters;
+        }
+        const uint8_t digit = (uint8_t)(digits[i] - '0');
+        if (*amount > (UINT64_MAX - digit) / 10) {
+            return parser_value_out_of_range;
+        }
+        *amount = *amount * 10 + digit;
+    }
+    return parser_ok;
+}
+
+// Sums a list of coins, all of them in the default denom
+static parser_error_t batch_sumCoins(const parsed_json_t *json, uint16_t coinsToken, uint64_t *total) {
+    if (json->tokens[coinsToken].type != JSMN_ARRAY) {
+        return parser_unexpected_type;
+    }
+    uint16_t numCoins = 0;
+    CHECK_ERROR(array_get_element_count(json, coinsToken, &numCoins))
+
+    *total = 0;
+    for (uint16_t i = 0; i < numCoins; i++) {
+        uint16_t coinToken = 0;
+        uint16_t token = 0;
+        uint64_t amount = 0;
+        CHECK_ERROR(array_get_nth_element(json, coinsToken, i, &coinToken))
+        CHECK_ERROR(batch_expectObject(json, coinToken, BATCH_COIN_FIELDS))
+
+        CHECK_ERROR(object_get_value(json, coinToken, "denom", &token))
+        if (!batch_tokenEquals(json, token, COIN_DEFAULT_DENOM_BASE)) {
+            return parser_batch_unsupported_tx;
+        }
+        CHECK_ERROR(object_get_value(json, coinToken, "amount", &token))
+        CHECK_ERROR(batch_getAmount(json, token, &amount))
+        CHECK_ERROR(batch_add(total, amount))
+    }
+    return parser_ok;
+}
+
+static parser_error_t batch_addRecipient(parser_batch_t *batch, const char *address, uint64_t amount) {
+    for (uint8_t i = 0; i < batch->numRecipients; i++) {
+        if (strcmp(batch->recipients[i].address, address) == 0) {
+            return batch_add(&batch->recipients[i].amount, amount);
+        }
+    }
+
+    if (batch->numRecipients >= BATCH_MAX_RECIPIENTS) {
+        return parser_batch_full;
+    }
+    parser_batch_recipient_t *recipient = &batch->recipients[batch->numRecipients];
+    snprintf(recipient->address, sizeof(recipient->address), "%s", address);
+    recipient->amount = amount;
+    batch->numRecipients++;
+    return parser_ok;
+}
+
+static parser_error_t batch_addMsg(parser_batch_t *batch, const parsed_json_t *json, uint16_t msgToken) {
+    uint16_t token = 0;
+    uint16_t valueToken = 0;
+    CHECK_ERROR(batch_expectObject(json, msgToken, BATCH_MSG_FIELDS))
+    CHECK_ERROR(object_get_value(json, msgToken, "type", &token))
+    if (!batch_tokenEquals(json, token, BATCH_MSG_TYPE)) {
+        return parser_batch_unsupported_tx;
+    }
+    CHECK_ERROR(object_get_value(json, msgToken, "value", &valueToken))
+    CHECK_ERROR(batch_expectObject(json, valueToken, BATCH_SEND_FIELDS))
+
+    // All transactions are signed with the same key
+    char address[BATCH_ADDR_MAXLEN + 1];
+    CHECK_ERROR(object_get_value(json, valueToken, "from_address", &token))
+    CHECK_ERROR(batch_getString(json, token, address, sizeof(address)))
+    if (batch->from_address[0] == '\0') {
+        snprintf(batch->from_address, sizeof(batch->from_address), "%s", address);
+    } else if (strcmp(batch->from_address, address) != 0) {
+        return parser_batch_mismatch;
+    }
+
+    uint64_t amount = 0;
+    CHECK_ERROR(object_get_value(json, valueToken, "amount", &token))
+    CHECK_ERROR(batch_sumCoins(json, token, &amount))
+
+    CHECK_ERROR(object_get_value(json, valueToken, "to_address", &token))
+    CHECK_ERROR(batch_getString(json, token, address, sizeof(address)))
+    if (address[0] == '\0') {
+        return parser_invalid_address;
+    }
+    return batch_addRecipient(batch, address, amount);
+}
+
+void parser_batch_init(parser_batch_t *batch) {
+    if (batch != NULL) {
+        MEMZERO(batch, sizeof(*batch));
+    }
+}
+
+parser_error_t parser_batch_add(parser_batch_t *batch, const parser_context_t *ctx) {
+    if (batch == NULL || ctx == NULL || ctx->tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
+    if (batch->numTxs >= BATCH_MAX_TXS) {
+        return parser_batch_full;
+    }
+    const parsed_json_t *json = &ctx->tx_obj->json;
+    uint16_t token = 0;
+
+    CHECK_ERROR(batch_expectObject(json, ROOT_TOKEN_INDEX, BATCH_ROOT_FIELDS))
+
+    // The review shows the chain once, for the whole batch
+    char chainId[COIN_MAX_CHAINID_LEN + 1];
+    CHECK_ERROR(object_get_value(json, ROOT_TOKEN_INDEX, "chain_id", &token))
+    CHECK_ERROR(batch_getString(json, token, chainId, sizeof(chainId)))
+    if (batch->numTxs == 0) {
+        snprintf(batch->chain_id, sizeof(batch->chain_id), "%s", chainId);
+    } else if (strcmp(batch->chain_id, chainId) != 0) {
+        return parser_batch_mismatch;
+    }
+
+    // Memos are not part of the summary
+    CHECK_ERROR(object_get_value(json, ROOT_TOKEN_INDEX, "memo", &token))
+    if (!batch_tokenEquals(json, token, "")) {
+        return parser_batch_unsupported_tx;
+    }
+
+    uint16_t feeToken = 0;
+    uint64_t fee = 0;
+    CHECK_ERROR(object_get_value(json, ROOT_TOKEN_INDEX, "fee", &feeToken))
+    CHECK_ERROR(batch_expectObject(json, feeToken, BATCH_FEE_FIELDS))
+    CHECK_ERROR(object_get_value(json, feeToken, "amount", &token))
+    CHECK_ERROR(batch_sumCoins(json, token, &fee))
+    CHECK_ERROR(batch_add(&batch->fees, fee))
+
+    uint16_t msgsToken = 0;
+    uint16_t numMsgs = 0;
+    CHECK_ERROR(object_get_value(json, ROOT_TOKEN_INDEX, "msgs", &msgsToken))
+    if (json->tokens[msgsToken].type != JSMN_ARRAY) {
+        return parser_unexpected_type;
+    }
+    CHECK_ERROR(array_get_element_count(json, msgsToken, &numMsgs))
+    if (numMsgs == 0) {
+        return parser_batch_unsupported_tx;
+    }
+    for (uint16_t i = 0; i < numMsgs; i++) {
+        uint16_t msgToken = 0;
+        CHECK_ERROR(array_get_nth_element(json, msgsToken, i, &msgToken))
+        CHECK_ERROR(batch_addMsg(batch, json, msgToken))
+    }
+
+    batch->numTxs++;
+    return parser_ok;
+}
+
+// Chain ID, number of transactions, sender, a recipient and amount pair per recipient and the total fees
+parser_error_t parser_batch_getNumItems(const parser_batch_t *batch, uint8_t *num_items) {
+    if (batch == NULL || num_items == NULL) {
+        return parser_unexpected_error;
+    }
+    *num_items = 0;
+    if (batch->numTxs == 0) {
+        return parser_no_data;
+    }
+    *num_items = 4 + 2 * batch->numRecipients;
+    return parser_ok;
+}
+
+static parser_error_t batch_formatAmount(uint64_t amount, char *outVal, uint16_t outValLen, uint8_t pageIdx,
+                                         uint8_t *pageCount) {
+    char amountStr[COIN_AMOUNT_MAXSIZE] = {0};
+    if (uint64_to_str(amountStr, sizeof(amountStr), amount) != NULL) {
+        return parser_unexpected_value;
+    }
+    return parser_formatCoin(amountStr, strlen(amountStr), COIN_DEFAULT_DENOM_BASE, strlen(COIN_DEFAULT_DENOM_BASE),
+                             outVal, outValLen, pageIdx, pageCount);
+}
+
+parser_error_t parser_batch_getItem(const parser_batch_t *batch, uint8_t displayIdx, char *outKey, uint16_t outKeyLen,
+                                    char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    if (batch == NULL || outKey == NULL || outVal == NULL || pageCount == NULL) {
+        return parser_unexpected_error;
+    }
+    MEMZERO(outKey, outKeyLen);
+    MEMZERO(outVal, outValLen);
+    *pageCount = 0;
+
+    uint8_t numItems = 0;
+    CHECK_ERROR(parser_batch_getNumItems(batch, &numItems))
+    if (displayIdx >= numItems) {
+        return parser_display_idx_out_of_range;
+    }
+
+    if (displayIdx == 0) {
+        snprintf(outKey, outKeyLen, "Chain ID");
+        pageString(outVal, outValLen, batch->chain_id, pageIdx, pageCount);
+    } else if (displayIdx == 1) {
+        char count[4] = {0};
+        snprintf(outKey, outKeyLen, "Transactions");
+        snprintf(count, sizeof(count), "%d", batch->numTxs);
+        pageString(outVal, outValLen, count, pageIdx, pageCount);
+    } else if (displayIdx == 2) {
+        snprintf(outKey, outKeyLen, "From address");
+        pageString(outVal, outValLen, batch->from_address, pageIdx, pageCount);
+    } else if (displayIdx == numItems - 1) {
+        snprintf(outKey, outKeyLen, "Total fees");
+        CHECK_ERROR(batch_formatAmount(batch->fees, outVal, outValLen, pageIdx, pageCount))
+    } else {
+        const uint8_t recipientIdx = (displayIdx - 3) / 2;
+        const parser_batch_recipient_t *recipient = &batch->recipients[recipientIdx];
+        if ((displayIdx - 3) % 2 == 0) {
+            snprintf(outKey, outKeyLen, "Recipient %d", recipientIdx + 1);
+            pageString(outVal, outValLen, recipient->address, pageIdx, pageCount);
+        } else {
+            snprintf(outKey, outKeyLen, "Amount %d", recipientIdx + 1);
+            CHECK_ERROR(batch_formatAmount(recipient->amount, outVal, outValLen, pageIdx, pageCount))
+        }
+    }
+
+    if (pageIdx >= *pageCount) {
+        return parser_display_page_out_of_range;
+    }
+    return parser_ok;
+}
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "coin.h"
+#include "parser_common.h"
+#include "parser_impl.h"
+
+// Longest account address a batch keeps (bech32 "sei1" account and contract addresses)
+#define BATCH_ADDR_MAXLEN 64u
+// Distinct recipients a batch can total
+#define BATCH_MAX_RECIPIENTS BATCH_MAX_TXS
+
+typedef struct {
+    char address[BATCH_ADDR_MAXLEN + 1];
+    uint64_t amount;
+} parser_batch_recipient_t;
+
+// Summary of the transactions received in an INS_SIGN_BATCH session, amounts in COIN_DEFAULT_DENOM_BASE
+typedef struct {
+    uint8_t numTxs;
+    uint8_t numRecipients;
+    char chain_id[COIN_MAX_CHAINID_LEN + 1];
+    char from_address[BATCH_ADDR_MAXLEN + 1];
+    uint64_t fees;
+    parser_batch_recipient_t recipients[BATCH_MAX_RECIPIENTS];
+} parser_batch_t;
+
+void parser_batch_init(parser_batch_t *batch);
+
+// Folds a parsed and validated amino JSON transaction into the batch. Only MsgSend transfers in the default denom,
+// without memo, from the address and on the chain of the first transaction are accepted. On error the batch is
+// left partially updated and has to be discarded.
+parser_error_t parser_batch_add(parser_batch_t *batch, const parser_context_t *ctx);
+
+parser_error_t parser_batch_getNumItems(const parser_batch_t *batch, uint8_t *num_items);
+
+parser_error_t parser_batch_getItem(const parser_batch_t *batch, uint8_t displayIdx, char *outKey, uint16_t outKeyLen,
+                                    char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount);
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,12 +16,10 @@
 
 #include "parser_impl.h"
 
+#include "msg_schema.h"
 #include "zxformat.h"
 #include "zxmacros.h"
 
-bool extraDepthLevel = false;
-parser_tx_t parser_tx_obj;
-
 const char *parser_getErrorDescription(parser_error_t err) {
     switch (err) {
         case parser_ok:
@@ -46,50 +44,66 @@ const char *parser_getErrorDescription(parser_error_t err) {
             return "Unexpected chain";
         case parser_missing_field:
             return "missing field";
+        case parser_transaction_too_big:
+            return "Too many items to display";
 
         case parser_display_idx_out_of_range:
             return "display index out of range";
         case parser_display_page_out_of_range:
             return "display page out of range";
 
+        case parser_batch_unsupported_tx:
+            return "Not a batch transfer";
+        case parser_batch_mismatch:
+            return "Batch chain or sender differs";
+        case parser_batch_full:
+            return "Batch is full";
+
+        case parser_display_key_too_long:
+            return "Key too long to display";
+
         default:
             return "Unrecognized error code";
     }
 }
 
 parser_error_t _read(parser_context_t *ctx) {
-    extraDepthLevel = false;
-    parser_error_t err = json_parse(&parser_tx_obj.json, (const char *)ctx->buffer, ctx->bufferLen);
+    if (ctx == NULL || ctx->tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
+    parser_tx_t *tx_obj = ctx->tx_obj;
+
+    parser_error_t err = json_parse(&tx_obj->json, (const char *)ctx->buffer, ctx->bufferLen);
     if (err != parser_ok) {
         return err;
     }
 
-    parser_tx_obj.tx = (const char *)ctx->buffer;
-    parser_tx_obj.flags.cache_valid = 0;
-    parser_tx_obj.filter_msg_type_count = 0;
-    parser_tx_obj.filter_msg_from_count = 0;
+    tx_obj->tx = (const char *)ctx->buffer;
+    tx_obj->flags.cache_valid = 0;
+    tx_obj->query_cursor.valid = false;
+    tx_obj->filter_msg_type_count = 0;
+    tx_obj->filter_msg_from_count = 0;
 
     return parser_ok;
 }
 
 static const key_subst_t value_substitutions[] = {
     {"wasm/MsgExecuteContract", "cosmos-sdk/MsgExecuteContract"},
-    {"cosmos-sdk/MsgMultiSend", "cosmos-sdk/MsgMultiSend"},
 };
 
-parser_error_t parser_getToken(uint16_t token_index, char *out_val, uint16_t out_val_len, uint8_t pageIdx,
-                               uint8_t *pageCount) {
+parser_error_t parser_getToken(parser_tx_t *tx_obj, uint16_t token_index, char *out_val, uint16_t out_val_len,
+                               uint8_t pageIdx, uint8_t *pageCount) {
     *pageCount = 0;
     MEMZERO(out_val, out_val_len);
 
-    const int16_t token_start = parser_tx_obj.json.tokens[token_index].start;
-    const int16_t token_end = parser_tx_obj.json.tokens[token_index].end;
+    const int16_t token_start = tx_obj->json.tokens[token_index].start;
+    const int16_t token_end = tx_obj->json.tokens[token_index].end;
 
     if (token_start > token_end) {
         return parser_unexpected_buffer_end;
     }
 
-    const char *inValue = parser_tx_obj.tx + token_start;
+    const char *inValue = tx_obj->tx + token_start;
     uint16_t inLen = token_end - token_start;
 
     // empty strings are considered the first page
@@ -104,12 +118,6 @@ parser_error_t parser_getToken(uint16_t token_index, char *out_val, uint16_t out
             if (inLen == str1Len && strncmp(inValue, str1, str1Len) == 0) {
                 inValue = str2;
                 inLen = str2Len;
-
-                // Extra Depth level for Multisend type
-                extraDepthLevel = false;
-                if (strstr(inValue, "Multi") != NULL) {
-                    extraDepthLevel = true;
-                }
                 break;
             }
         }
@@ -127,143 +135,253 @@ bool is_msg_type_field(char *field_name) { return strcmp(field_name, "msgs/type"
 
 bool is_msg_from_field(char *field_name) { return strcmp(field_name, "msgs/value/delegator_address") == 0; }
 
-// strcat but source does not need to be terminated (a chunk from a bigger string is concatenated)
-// dst_max is measured in bytes including the space for NULL termination
-// src_size does not include NULL termination
-__Z_INLINE void strcat_chunk_s(char *dst, uint16_t dst_max, const char *src_chunk, size_t src_chunk_size) {
-    *(dst + dst_max - 1) = 0;  // last character terminates with zero in case we go beyond bounds
-    const size_t prev_size = strlen(dst);
-
-    size_t space_left = dst_max - prev_size - 1;  // -1 because requires termination
+// Appends "/<key>" to out_key, truncated to out_key_len. key_len is the current length of out_key and the new one is
+// returned, so the key is never measured again while the tree is walked.
+__Z_INLINE uint16_t append_key_item(parser_tx_t *tx_obj, uint16_t key_len, uint16_t token_index) {
+    char *out_key = tx_obj->query.out_key;
+    const uint16_t out_key_len = tx_obj->query.out_key_len;
 
-    if (src_chunk_size > space_left) {
-        src_chunk_size = space_left;
+    if (*out_key > 0 && key_len + 1 < out_key_len) {
+        // There is already something there, add separator
+        out_key[key_len++] = '/';
+        out_key[key_len] = 0;
     }
 
-    // Check bounds
-    if (src_chunk_size > 0) {
-        MEMMOVE(dst + prev_size, src_chunk, src_chunk_size);
-        *(dst + prev_size + src_chunk_size) = 0;
+    const int16_t token_start = tx_obj->json.tokens[token_index].start;
+    const int16_t token_end = tx_obj->json.tokens[token_index].end;
+    const uint16_t space_left = out_key_len - key_len - 1;  // -1 because requires termination
+    uint16_t chunk_size = token_end > token_start ? (uint16_t)(token_end - token_start) : 0;
+    if (chunk_size > space_left) {
+        chunk_size = space_left;
     }
-}
 
-__Z_INLINE void append_key_item(uint16_t token_index) {
-    if (*parser_tx_obj.query.out_key > 0) {
-        // There is already something there, add separator
-        strcat_chunk_s(parser_tx_obj.query.out_key, parser_tx_obj.query.out_key_len, "/", 1);
-    }
+    if (chunk_size > 0) {
+        MEMMOVE(out_key + key_len, tx_obj->tx + token_start, chunk_size);
+        out_key[key_len + chunk_size] = 0;
 
-    const int16_t token_start = parser_tx_obj.json.tokens[token_index].start;
-    const int16_t token_end = parser_tx_obj.json.tokens[token_index].end;
-    const char *address_ptr = parser_tx_obj.tx + token_start;
-    const int32_t new_item_size = token_end - token_start;
+        // A zero byte inside the key ends it
+        const char *end = memchr(out_key + key_len, 0, chunk_size);
+        key_len = end != NULL ? (uint16_t)(end - out_key) : key_len + chunk_size;
+    }
 
-    strcat_chunk_s(parser_tx_obj.query.out_key, parser_tx_obj.query.out_key_len, address_ptr, new_item_size);
+    return key_len;
 }
 
-parser_error_t parser_traverse_find(uint16_t root_token_index, uint16_t *ret_value_token_index) {
-    const jsmntype_t token_type = parser_tx_obj.json.tokens[root_token_index].type;
+// Finds the next child of the container in frame, scanning tokens the same way object_get_nth_key and
+// array_get_nth_element do. When there is none, result is set to what the container yields.
+static bool traverse_next_child(const parser_tx_t *tx_obj, traverse_frame_t *frame, uint16_t *child,
+                                parser_error_t *result) {
+    const parsed_json_t *json = &tx_obj->json;
+    const jsmntok_t *container = &json->tokens[frame->token];
+    *result = parser_query_no_results;
+
+    switch (container->type) {
+        case JSMN_OBJECT:
+            while (frame->next_token < json->numberOfTokens && frame->next_token + 1 < MAX_NUMBER_OF_TOKENS) {
+                const uint16_t key_index = frame->next_token++;
+                const jsmntok_t *key_token = &json->tokens[key_index];
+                if (key_token->start > container->end) {
+                    break;
+                }
+                if (key_token->start <= frame->prev_element_end) {
+                    continue;
+                }
+                frame->prev_element_end = json->tokens[key_index + 1].end;
+                frame->key_token = key_index;
+                *child = key_index + 1;
+                return true;
+            }
+            return false;
 
-    CHECK_APP_CANARY()
+        case JSMN_ARRAY:
+            if (frame->children_left == 0) {
+                return false;
+            }
+            while (frame->next_token < json->numberOfTokens) {
+                const uint16_t element_index = frame->next_token++;
+                const jsmntok_t *element_token = &json->tokens[element_index];
+                if (element_token->start > container->end) {
+                    break;
+                }
+                if (element_token->start <= frame->prev_element_end) {
+                    continue;
+                }
+                frame->prev_element_end = element_token->end;
+                frame->children_left--;
+                *child = element_index;
+                return true;
+            }
+            // Fewer elements than counted
+            *result = parser_no_data;
+            return false;
 
-    if (parser_tx_obj.tx == NULL) {
-        return parser_no_data;
+        default:
+            return false;
     }
+}
 
-    if (parser_tx_obj.query.max_level <= 0 || parser_tx_obj.query.max_depth <= 0 || token_type == JSMN_STRING ||
-        token_type == JSMN_PRIMITIVE) {
-        const bool skipTypeField = parser_tx_obj.flags.cache_valid && parser_tx_obj.flags.msg_type_grouping &&
-                                   is_msg_type_field(parser_tx_obj.query.out_key) &&
-                                   parser_tx_obj.filter_msg_type_valid_idx != parser_tx_obj.query._item_index_current;
-
-        const bool skipFromFieldHidingRule =
-            parser_tx_obj.flags.msg_from_grouping_hide_all ||
-            parser_tx_obj.filter_msg_from_valid_idx != parser_tx_obj.query._item_index_current;
+// Level a message is flattened with, found by parser_indexRootFields
+__Z_INLINE uint8_t msg_level(const parser_tx_t *tx_obj, uint16_t msg_index) {
+    if (msg_index >= tx_obj->display_cache.num_msgs) {
+        return MSG_SCHEMA_DEFAULT_LEVEL;
+    }
+    return tx_obj->display_cache.msgs[msg_index].level;
+}
 
-        const bool skipFromField = parser_tx_obj.flags.cache_valid && parser_tx_obj.flags.msg_from_grouping &&
-                                   is_msg_from_field(parser_tx_obj.query.out_key) && skipFromFieldHidingRule;
+__Z_INLINE bool traverse_can_resume(const parser_tx_t *tx_obj, uint16_t root_token_index, uint16_t root_key_len) {
+    const traverse_cursor_t *cursor = &tx_obj->query_cursor;
+    const tx_query_t *query = &tx_obj->query;
+    return cursor->valid && cursor->tx == tx_obj->tx && cursor->root_token == root_token_index &&
+           cursor->max_level == query->max_level && cursor->max_depth == query->max_depth &&
+           cursor->msg_levels == query->msg_levels &&
+           cursor->out_key_len == query->out_key_len && cursor->root_key_len == root_key_len &&
+           query->_item_index_current == 0 && query->item_index >= cursor->item_index;
+}
 
-        const bool skipField = skipFromField || skipTypeField;
+// Walks the subtree under root_token_index depth first and stops at the leaf number query.item_index, counting only
+// fields that are not hidden by grouping. Keys are flattened into query.out_key below query.max_level, or below the
+// level of each message when the query has msg_levels.
+//
+// The walk keeps its containers in query_cursor instead of recursing, so the stack use does not depend on the
+// input. A query for the same root that asks for the same or a later item continues from the leaf the previous one
+// found, which makes reading all the items of a root one after the other linear in the number of tokens.
+parser_error_t parser_traverse_find(parser_tx_t *tx_obj, uint16_t root_token_index, uint16_t *ret_value_token_index) {
+    CHECK_APP_CANARY()
 
-        CHECK_APP_CANARY()
+    if (tx_obj->tx == NULL) {
+        return parser_no_data;
+    }
+    if (tx_obj->query.max_depth > MAX_RECURSION_DEPTH) {
+        return parser_unexpected_value;
+    }
 
-        // Early bail out
-        if (!skipField && parser_tx_obj.query._item_index_current == parser_tx_obj.query.item_index) {
-            *ret_value_token_index = root_token_index;
-            CHECK_APP_CANARY()
-            return parser_ok;
+    tx_query_t *query = &tx_obj->query;
+    traverse_cursor_t *cursor = &tx_obj->query_cursor;
+    traverse_frame_t *frames = cursor->frames;
+    const int16_t requested_item_index = query->item_index;
+    const uint16_t root_key_len = (uint16_t)strlen(query->out_key);
+
+    uint16_t key_len = root_key_len;
+    uint16_t token = root_token_index;
+    uint8_t max_level = query->max_level;
+    uint8_t max_depth = query->max_depth;
+
+    if (traverse_can_resume(tx_obj, root_token_index, root_key_len)) {
+        // Rebuild the key of the leaf and visit it again
+        for (uint8_t i = 0; i < cursor->depth; i++) {
+            frames[i].key_len = key_len;
+            if (tx_obj->json.tokens[frames[i].token].type == JSMN_OBJECT) {
+                key_len = append_key_item(tx_obj, key_len, frames[i].key_token);
+            }
         }
-
-        if (skipField) {
-            parser_tx_obj.query.item_index++;
+        query->item_index += cursor->skipped;
+        query->_item_index_current = cursor->item_index_current;
+        token = cursor->leaf_token;
+        max_level = cursor->leaf_max_level;
+        max_depth = cursor->leaf_max_depth;
+    } else {
+        cursor->tx = tx_obj->tx;
+        cursor->root_token = root_token_index;
+        cursor->max_level = query->max_level;
+        cursor->max_depth = query->max_depth;
+        cursor->msg_levels = query->msg_levels;
+        cursor->out_key_len = query->out_key_len;
+        cursor->root_key_len = root_key_len;
+        cursor->msg_index = 0;
+        cursor->next_msg = 0;
+        cursor->depth = 0;
+        if (query->msg_levels && tx_obj->json.tokens[token].type == JSMN_OBJECT) {
+            // A single message instead of an array of them
+            max_level = msg_level(tx_obj, 0);
         }
-
-        parser_tx_obj.query._item_index_current++;
-        CHECK_APP_CANARY()
-        return parser_query_no_results;
     }
+    cursor->valid = false;
 
-    uint16_t el_count = 0;
-    parser_error_t err = parser_ok;
+    // Outcome of the last container that was finished, the root one is returned
+    parser_error_t result = parser_query_no_results;
 
-    CHECK_ERROR(object_get_element_count(&parser_tx_obj.json, root_token_index, &el_count))
+    while (true) {
+        const jsmntype_t token_type = tx_obj->json.tokens[token].type;
 
-    switch (token_type) {
-        case JSMN_OBJECT: {
-            const size_t key_len = strlen(parser_tx_obj.query.out_key);
-            for (uint16_t i = 0; i < el_count; ++i) {
-                uint16_t key_index = 0;
-                uint16_t value_index = 0;
+        if (max_level == 0 || max_depth == 0 || token_type == JSMN_STRING || token_type == JSMN_PRIMITIVE) {
+            const bool skipTypeField = tx_obj->flags.cache_valid && tx_obj->flags.msg_type_grouping &&
+                                       is_msg_type_field(query->out_key) &&
+                                       tx_obj->filter_msg_type_valid_idx != query->_item_index_current;
 
-                CHECK_ERROR(object_get_nth_key(&parser_tx_obj.json, root_token_index, i, &key_index))
-                CHECK_ERROR(object_get_nth_value(&parser_tx_obj.json, root_token_index, i, &value_index))
+            const bool skipFromFieldHidingRule =
+                tx_obj->flags.msg_from_grouping_hide_all || tx_obj->filter_msg_from_valid_idx != query->_item_index_current;
 
-                // Skip writing keys if we are actually exploring to count
-                append_key_item(key_index);
-                CHECK_APP_CANARY()
+            const bool skipFromField = tx_obj->flags.cache_valid && tx_obj->flags.msg_from_grouping &&
+                                       is_msg_from_field(query->out_key) && skipFromFieldHidingRule;
 
-                // When traversing objects both level and depth should be considered
-                parser_tx_obj.query.max_level--;
-                parser_tx_obj.query.max_depth--;
+            const bool skipField = skipFromField || skipTypeField;
 
-                // Traverse the value, extracting subkeys
-                err = parser_traverse_find(value_index, ret_value_token_index);
-                CHECK_APP_CANARY()
-                parser_tx_obj.query.max_level++;
-                parser_tx_obj.query.max_depth++;
+            CHECK_APP_CANARY()
 
-                if (err == parser_ok) {
-                    return parser_ok;
-                }
+            if (!skipField && query->_item_index_current == query->item_index) {
+                cursor->item_index = requested_item_index;
+                cursor->skipped = query->item_index - requested_item_index;
+                cursor->item_index_current = query->_item_index_current;
+                cursor->leaf_token = token;
+                cursor->leaf_max_level = max_level;
+                cursor->leaf_max_depth = max_depth;
+                cursor->valid = true;
+
+                *ret_value_token_index = token;
+                return parser_ok;
+            }
 
-                *(parser_tx_obj.query.out_key + key_len) = 0;
-                CHECK_APP_CANARY()
+            if (skipField) {
+                query->item_index++;
+            }
+            query->_item_index_current++;
+            result = parser_query_no_results;
+        } else if (token > tx_obj->json.numberOfTokens) {
+            result = parser_no_data;
+        } else {
+            // max_depth bounds the number of open containers to MAX_RECURSION_DEPTH
+            traverse_frame_t *frame = &frames[cursor->depth++];
+            frame->token = token;
+            frame->next_token = token + 1;
+            frame->prev_element_end = tx_obj->json.tokens[token].start;
+            frame->children_left = 0;
+            frame->key_len = key_len;
+            frame->max_level = max_level;
+            frame->max_depth = max_depth;
+            if (token_type == JSMN_ARRAY) {
+                // Arrays are bounded by object_get_element_count, as they always were
+                CHECK_ERROR(object_get_element_count(&tx_obj->json, token, &frame->children_left))
             }
-            break;
         }
-        case JSMN_ARRAY: {
-            for (uint16_t i = 0; i < el_count; ++i) {
-                uint16_t element_index = 0;
-                CHECK_ERROR(array_get_nth_element(&parser_tx_obj.json, root_token_index, i, &element_index))
-                CHECK_APP_CANARY()
-
-                // When iterating along an array,
-                // the level does not change but we need to count the recursion
-                parser_tx_obj.query.max_depth--;
-                err = parser_traverse_find(element_index, ret_value_token_index);
-                parser_tx_obj.query.max_depth++;
-
-                CHECK_APP_CANARY()
-
-                if (err == parser_ok) {
-                    return parser_ok;
+
+        // Move to the next child of the innermost open container, closing the ones that have no children left
+        while (true) {
+            if (cursor->depth == 0) {
+                return result;
+            }
+
+            traverse_frame_t *frame = &frames[cursor->depth - 1];
+            key_len = frame->key_len;
+            query->out_key[key_len] = 0;
+            CHECK_APP_CANARY()
+
+            if (traverse_next_child(tx_obj, frame, &token, &result)) {
+                // When traversing objects both level and depth should be considered,
+                // when iterating along an array the level does not change
+                if (tx_obj->json.tokens[frame->token].type == JSMN_OBJECT) {
+                    key_len = append_key_item(tx_obj, key_len, frame->key_token);
+                    max_level = frame->max_level - 1;
+                } else if (query->msg_levels && cursor->depth == 1) {
+                    // Entering a message of the msgs array
+                    cursor->msg_index = cursor->next_msg++;
+                    max_level = msg_level(tx_obj, cursor->msg_index);
+                } else {
+                    max_level = frame->max_level;
                 }
+                max_depth = frame->max_depth - 1;
+                break;
             }
-            break;
+            cursor->depth--;
         }
-        default:
-            break;
     }
-
-    return parser_query_no_results;
 }
@@ -25,45 +25,51 @@
 extern "C" {
 #endif
 
-#define MAX_RECURSION_DEPTH 6
-extern bool extraDepthLevel;
-
-#define INIT_QUERY_CONTEXT(_KEY, _KEY_LEN, _VAL, _VAL_LEN, _PAGE_IDX, _MAX_LEVEL) \
-    parser_tx_obj.query._item_index_current = 0;                                  \
-    parser_tx_obj.query.max_depth = MAX_RECURSION_DEPTH;                          \
-    parser_tx_obj.query.max_level = _MAX_LEVEL;                                   \
-                                                                                  \
-    parser_tx_obj.query.item_index = 0;                                           \
-    parser_tx_obj.query.page_index = (_PAGE_IDX);                                 \
-                                                                                  \
-    MEMZERO(_KEY, (_KEY_LEN));                                                    \
-    MEMZERO(_VAL, (_VAL_LEN));                                                    \
-    parser_tx_obj.query.out_key = _KEY;                                           \
-    parser_tx_obj.query.out_val = _VAL;                                           \
-    parser_tx_obj.query.out_key_len = (_KEY_LEN);                                 \
-    parser_tx_obj.query.out_val_len = (_VAL_LEN);
-
-#define CLEAN_QUERY()                    \
-    parser_tx_obj.query.out_key = NULL;  \
-    parser_tx_obj.query.out_val = NULL;  \
-    parser_tx_obj.query.out_key_len = 0; \
-    parser_tx_obj.query.out_val_len = 0;
-
-#define CHECK_ERROR_CLEAN_QUERY(__CALL) \
-    {                                   \
-        parser_error_t __err = __CALL;  \
-        CHECK_APP_CANARY()              \
-        if (__err != parser_ok) {       \
-            CLEAN_QUERY()               \
-            return __err;               \
-        }                               \
+#define INIT_QUERY_CONTEXT(_TX, _KEY, _KEY_LEN, _VAL, _VAL_LEN, _PAGE_IDX, _MAX_LEVEL) \
+    (_TX)->query._item_index_current = 0;                                              \
+    (_TX)->query.max_depth = MAX_RECURSION_DEPTH;                                      \
+    (_TX)->query.max_level = _MAX_LEVEL;                                               \
+    (_TX)->query.msg_levels = false;                                                   \
+                                                                                       \
+    (_TX)->query.item_index = 0;                                                       \
+    (_TX)->query.page_index = (_PAGE_IDX);                                             \
+                                                                                       \
+    MEMZERO(_KEY, (_KEY_LEN));                                                         \
+    MEMZERO(_VAL, (_VAL_LEN));                                                         \
+    (_TX)->query.out_key = _KEY;                                                       \
+    (_TX)->query.out_val = _VAL;                                                       \
+    (_TX)->query.out_key_len = (_KEY_LEN);                                             \
+    (_TX)->query.out_val_len = (_VAL_LEN);
+
+#define CLEAN_QUERY(_TX)          \
+    (_TX)->query.out_key = NULL;  \
+    (_TX)->query.out_val = NULL;  \
+    (_TX)->query.out_key_len = 0; \
+    (_TX)->query.out_val_len = 0;
+
+#define CHECK_ERROR_CLEAN_QUERY(_TX, __CALL) \
+    {                                        \
+        parser_error_t __err = __CALL;       \
+        CHECK_APP_CANARY()                   \
+        if (__err != parser_ok) {            \
+            CLEAN_QUERY(_TX)                 \
+            return __err;                    \
+        }                                    \
     }
 
+// Defined in parser_impl_evm.h and parser_impl_pb.h, only referenced here through a pointer
+struct eth_tx_s;
+struct pb_tx_s;
+
 typedef struct {
     const uint8_t *buffer;
     uint16_t bufferLen;
     uint16_t offset;
+    // State of the transaction being parsed. Set by parser_parse / parser_parse_eth / parser_parse_pb,
+    // the caller owns the storage so several contexts can be used at the same time
     parser_tx_t *tx_obj;
+    struct eth_tx_s *eth_tx_obj;
+    struct pb_tx_s *pb_tx_obj;
 } parser_context_t;
 
 typedef struct {
@@ -76,15 +82,13 @@ typedef struct {
     char str;
 } ascii_subst_t;
 
-extern parser_tx_t parser_tx_obj;
-
 parser_error_t _read(parser_context_t *c);
 
-parser_error_t parser_traverse_find(uint16_t root_token_index, uint16_t *ret_value_token_index);
+parser_error_t parser_traverse_find(parser_tx_t *tx_obj, uint16_t root_token_index, uint16_t *ret_value_token_index);
 
 // Retrieves the value for the corresponding token index. If the value goes beyond val_len, the chunk_idx will be used
-parser_error_t parser_getToken(uint16_t token_index, char *out_val, uint16_t out_val_len, uint8_t pageIdx,
-                               uint8_t *pageCount);
+parser_error_t parser_getToken(parser_tx_t *tx_obj, uint16_t token_index, char *out_val, uint16_t out_val_len,
+                               uint8_t pageIdx, uint8_t *pageCount);
 
 bool is_msg_type_field(char *field_name);
 bool is_msg_from_field(char *field_name);
@@ -21,11 +21,17 @@
 
 #include "app_mode.h"
 #include "coin.h"
+#include "denom_registry.h"
+#include "msg_schema.h"
 #include "parser_common.h"
 #include "parser_impl.h"
+#include "parser_totals.h"
+#include "scratch.h"
 #include "utf8.h"
 
-#define NUM_REQUIRED_ROOT_PAGES 7
+#define NUM_REQUIRED_ROOT_PAGES 8
+// Key of the value fields of a message, its schema names them without it
+#define MSG_VALUE_KEY_PREFIX "msgs/value/"
 
 const char *get_required_root_item(root_item_e i) {
     switch (i) {
@@ -41,6 +47,8 @@ const char *get_required_root_item(root_item_e i) {
             return "memo";
         case root_item_msgs:
             return "msgs";
+        case root_item_total:
+            return "total";
         default:
             return "?";
     }
@@ -59,63 +67,164 @@ __Z_INLINE uint8_t get_root_max_level(root_item_e i) {
         case root_item_memo:
             return 2;
         case root_item_msgs:
-            return extraDepthLevel ? 3 : 2;
+            // Each message is flattened with the level of its schema, see index_msgs
+            return MSG_SCHEMA_DEFAULT_LEVEL;
         default:
             return 0;
     }
 }
 
-display_cache_t display_cache;
+// Moves *element to the next element of the array at array_token, the first one when *element is array_token.
+// Tokens are scanned the same way array_get_nth_element does, but from the current element on.
+static bool next_array_element(const parsed_json_t *json, uint16_t array_token, uint16_t *element) {
+    const jsmntok_t *array = &json->tokens[array_token];
+    const int prev_element_end = *element == array_token ? array->start : json->tokens[*element].end;
 
-__Z_INLINE parser_error_t calculate_is_default_chainid() {
-    display_cache.is_default_chain = false;
+    for (uint16_t i = *element + 1; i < json->numberOfTokens && json->tokens[i].start <= array->end; i++) {
+        if (json->tokens[i].start > prev_element_end) {
+            *element = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+__Z_INLINE uint8_t find_msg_schema(const parser_tx_t *tx_obj, uint16_t msg_token) {
+    uint16_t type_token = 0;
+    if (tx_obj->json.tokens[msg_token].type != JSMN_OBJECT ||
+        object_get_value(&tx_obj->json, msg_token, "type", &type_token) != parser_ok ||
+        tx_obj->json.tokens[type_token].type != JSMN_STRING) {
+        return MSG_SCHEMA_UNKNOWN;
+    }
+    const jsmntok_t *type = &tx_obj->json.tokens[type_token];
+    return msg_schema_find(tx_obj->tx + type->start, type->end - type->start);
+}
+
+// Looks up the schema of the message at msg_token. A message that wraps others is flattened deep enough to show
+// the fields of the deepest of them, messages they wrap in turn are shown as JSON.
+static void find_msg_info(const parser_tx_t *tx_obj, uint16_t msg_token, msg_info_t *info) {
+    info->schema = find_msg_schema(tx_obj, msg_token);
+    const msg_schema_t *schema = msg_schema_get(info->schema);
+    info->level = schema->display_level;
+
+    const char *nested_field = (const char *)PIC(schema->nested_field);
+    uint16_t value_token = 0;
+    uint16_t nested_token = 0;
+    if (nested_field == NULL || object_get_value(&tx_obj->json, msg_token, "value", &value_token) != parser_ok ||
+        tx_obj->json.tokens[value_token].type != JSMN_OBJECT ||
+        object_get_value(&tx_obj->json, value_token, nested_field, &nested_token) != parser_ok ||
+        tx_obj->json.tokens[nested_token].type != JSMN_ARRAY) {
+        return;
+    }
+
+    uint8_t nested_level = 0;
+    uint16_t element = nested_token;
+    while (next_array_element(&tx_obj->json, nested_token, &element)) {
+        const uint8_t level = msg_schema_get(find_msg_schema(tx_obj, element))->display_level;
+        if (level > nested_level) {
+            nested_level = level;
+        }
+    }
+    info->level += nested_level;
+}
+
+// Finds the schema and display level of every message once, walks over msgs then read them from the cache
+static parser_error_t index_msgs(parser_tx_t *tx_obj, uint16_t msgs_token) {
+    display_cache_t *cache = &tx_obj->display_cache;
+    cache->num_msgs = 0;
+
+    switch (tx_obj->json.tokens[msgs_token].type) {
+        case JSMN_OBJECT:
+            find_msg_info(tx_obj, msgs_token, &cache->msgs[cache->num_msgs++]);
+            break;
+        case JSMN_ARRAY: {
+            uint16_t element = msgs_token;
+            while (next_array_element(&tx_obj->json, msgs_token, &element)) {
+                if (cache->num_msgs >= TX_MAX_MSGS) {
+                    return parser_transaction_too_big;
+                }
+                find_msg_info(tx_obj, element, &cache->msgs[cache->num_msgs++]);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return parser_ok;
+}
+
+// Whether key is the field the schema of the message being walked names as the coins it spends
+__Z_INLINE bool is_spent_amount_field(const parser_tx_t *tx_obj, const char *key) {
+    const uint16_t msg_index = tx_obj->query_cursor.msg_index;
+    const size_t prefix_len = strlen(MSG_VALUE_KEY_PREFIX);
+    if (msg_index >= tx_obj->display_cache.num_msgs || strncmp(key, MSG_VALUE_KEY_PREFIX, prefix_len) != 0) {
+        return false;
+    }
+    const msg_schema_t *schema = msg_schema_get(tx_obj->display_cache.msgs[msg_index].schema);
+    return msg_schema_isAmountField(schema, key + prefix_len);
+}
+
+// append_key_item cuts keys at the end of query.out_key, a key that fills it may have been cut and is refused
+// rather than shown shortened
+__Z_INLINE parser_error_t check_key_fits(const parser_tx_t *tx_obj) {
+    if (strlen(tx_obj->query.out_key) + 1 >= tx_obj->query.out_key_len) {
+        return parser_display_key_too_long;
+    }
+    return parser_ok;
+}
+
+__Z_INLINE parser_error_t calculate_is_default_chainid(parser_tx_t *tx_obj) {
+    tx_obj->display_cache.is_default_chain = false;
 
     // get chain_id
     char outKey[2];
     char outVal[COIN_MAX_CHAINID_LEN];
     uint8_t pageCount;
-    INIT_QUERY_CONTEXT(outKey, sizeof(outKey), outVal, sizeof(outVal), 0, get_root_max_level(root_item_chain_id))
-    parser_tx_obj.query.item_index = 0;
-    parser_tx_obj.query._item_index_current = 0;
+    INIT_QUERY_CONTEXT(tx_obj, outKey, sizeof(outKey), outVal, sizeof(outVal), 0,
+                       get_root_max_level(root_item_chain_id))
+    tx_obj->query.item_index = 0;
+    tx_obj->query._item_index_current = 0;
 
     uint16_t ret_value_token_index = 0;
-    CHECK_ERROR_CLEAN_QUERY(
-        parser_traverse_find(display_cache.root_item_start_token_idx[root_item_chain_id], &ret_value_token_index))
+    CHECK_ERROR_CLEAN_QUERY(tx_obj, parser_traverse_find(tx_obj,
+                                                         tx_obj->display_cache.root_item_start_token_idx[root_item_chain_id],
+                                                         &ret_value_token_index))
 
-    CHECK_ERROR_CLEAN_QUERY(parser_getToken(ret_value_token_index, outVal, sizeof(outVal), 0, &pageCount))
+    CHECK_ERROR_CLEAN_QUERY(tx_obj, parser_getToken(tx_obj, ret_value_token_index, outVal, sizeof(outVal), 0, &pageCount))
 
     zemu_log_stack(outVal);
     zemu_log_stack(COIN_DEFAULT_CHAINID);
 
     if (strcmp(outVal, COIN_DEFAULT_CHAINID) == 0) {
         // If we don't match the default chainid, switch to expert mode
-        display_cache.is_default_chain = true;
+        tx_obj->display_cache.is_default_chain = true;
     } else if ((outVal[0] == 0x30 || outVal[0] == 0x31) && strlen(outVal) == 1) {
-        CLEAN_QUERY();
+        CLEAN_QUERY(tx_obj);
         return parser_unexpected_chain;
     }
 
-    CLEAN_QUERY();
+    CLEAN_QUERY(tx_obj);
     return parser_ok;
 }
 
-__Z_INLINE bool address_matches_own(char *addr) {
-    if (parser_tx_obj.own_addr == NULL || addr == NULL) {
+__Z_INLINE bool address_matches_own(const parser_tx_t *tx_obj, char *addr) {
+    if (tx_obj->own_addr == NULL || addr == NULL) {
         return false;
     }
-    if (strcmp(parser_tx_obj.own_addr, addr) != 0) {
+    if (strcmp(tx_obj->own_addr, addr) != 0) {
         return false;
     }
     return true;
 }
 
-parser_error_t parser_indexRootFields() {
-    if (parser_tx_obj.flags.cache_valid) {
+parser_error_t parser_indexRootFields(parser_tx_t *tx_obj) {
+    if (tx_obj->flags.cache_valid) {
         return parser_ok;
     }
 
     // Clear cache
-    MEMZERO(&display_cache, sizeof(display_cache_t));
+    MEMZERO(&tx_obj->display_cache, sizeof(display_cache_t));
+    tx_obj->query_cursor.valid = false;
 
     char tmp_key[INDEXING_TMP_KEYSIZE];
     char tmp_val[INDEXING_TMP_VALUESIZE];
@@ -128,10 +237,14 @@ parser_error_t parser_indexRootFields() {
     MEMZERO(&reference_msg_type, sizeof(reference_msg_type));
     MEMZERO(&reference_msg_from, sizeof(reference_msg_from));
 
-    parser_tx_obj.filter_msg_type_count = 0;
-    parser_tx_obj.filter_msg_from_count = 0;
-    parser_tx_obj.flags.msg_type_grouping = 1;
-    parser_tx_obj.flags.msg_from_grouping = 1;
+    tx_obj->filter_msg_type_count = 0;
+    tx_obj->filter_msg_from_count = 0;
+    tx_obj->flags.msg_type_grouping = 1;
+    tx_obj->flags.msg_from_grouping = 1;
+
+    // Totals are added up in the same pass, the schema of each message tells which of its amounts are spent
+    denom_totals_t *totals = &tx_obj->display_cache.totals;
+    parser_totals_reset(totals);
 
     // Look for all expected root items in the JSON tree
     // mark them as found/valid,
@@ -139,10 +252,13 @@ parser_error_t parser_indexRootFields() {
     for (root_item_e root_item_idx = 0; root_item_idx < NUM_REQUIRED_ROOT_PAGES; root_item_idx++) {
         uint16_t req_root_item_key_token_idx = 0;
 
+        if (root_item_idx == root_item_total) {
+            continue;
+        }
         const char *required_root_item_key = get_required_root_item(root_item_idx);
 
         parser_error_t err =
-            object_get_value(&parser_tx_obj.json, ROOT_TOKEN_INDEX, required_root_item_key, &req_root_item_key_token_idx);
+            object_get_value(&tx_obj->json, ROOT_TOKEN_INDEX, required_root_item_key, &req_root_item_key_token_idx);
 
         if (err == parser_no_data) {
             continue;
@@ -150,30 +266,37 @@ parser_error_t parser_indexRootFields() {
         CHECK_ERROR(err)
 
         // Remember root item start token
-        display_cache.root_item_start_token_valid[root_item_idx] = true;
-        display_cache.root_item_start_token_idx[root_item_idx] = req_root_item_key_token_idx;
+        tx_obj->display_cache.root_item_start_token_valid[root_item_idx] = true;
+        tx_obj->display_cache.root_item_start_token_idx[root_item_idx] = req_root_item_key_token_idx;
+        if (root_item_idx == root_item_msgs) {
+            CHECK_ERROR(index_msgs(tx_obj, req_root_item_key_token_idx))
+        }
 
         // Now count how many items can be found in this root item
         int16_t current_item_idx = 0;
         while (err == parser_ok) {
-            INIT_QUERY_CONTEXT(tmp_key, sizeof(tmp_key), tmp_val, sizeof(tmp_val), 0, get_root_max_level(root_item_idx))
+            INIT_QUERY_CONTEXT(tx_obj, tmp_key, sizeof(tmp_key), tmp_val, sizeof(tmp_val), 0,
+                               get_root_max_level(root_item_idx))
+            tx_obj->query.msg_levels = root_item_idx == root_item_msgs;
 
-            parser_tx_obj.query.item_index = current_item_idx;
-            strncpy_s(parser_tx_obj.query.out_key, required_root_item_key, parser_tx_obj.query.out_key_len);
+            tx_obj->query.item_index = current_item_idx;
+            strncpy_s(tx_obj->query.out_key, required_root_item_key, tx_obj->query.out_key_len);
 
             uint16_t ret_value_token_index;
-            err = parser_traverse_find(display_cache.root_item_start_token_idx[root_item_idx], &ret_value_token_index);
+            err = parser_traverse_find(tx_obj, tx_obj->display_cache.root_item_start_token_idx[root_item_idx],
+                                       &ret_value_token_index);
             if (err != parser_ok) {
                 continue;
             }
+            CHECK_ERROR_CLEAN_QUERY(tx_obj, check_key_fits(tx_obj))
 
             uint8_t pageCount;
-            CHECK_ERROR_CLEAN_QUERY(parser_getToken(ret_value_token_index, parser_tx_obj.query.out_val,
-                                                    parser_tx_obj.query.out_val_len, 0, &pageCount))
+            CHECK_ERROR_CLEAN_QUERY(tx_obj, parser_getToken(tx_obj, ret_value_token_index, tx_obj->query.out_val,
+                                                            tx_obj->query.out_val_len, 0, &pageCount))
 
             switch (root_item_idx) {
                 case root_item_memo: {
-                    if (strlen(parser_tx_obj.query.out_val) == 0) {
+                    if (strlen(tx_obj->query.out_val) == 0) {
                         err = parser_query_no_results;
                         continue;
                     }
@@ -182,120 +305,154 @@ parser_error_t parser_indexRootFields() {
                 case root_item_msgs: {
                     // Note: if we are dealing with the message field, Ledger has requested that we group.
                     // This means that if all messages share the same time, we should only count the type field once
-                    // This is indicated by `parser_tx_obj.flags.msg_type_grouping`
+                    // This is indicated by `tx_obj->flags.msg_type_grouping`
+
+                    if (totals->valid && is_spent_amount_field(tx_obj, tmp_key)) {
+                        totals->valid = parser_totals_add(totals, &tx_obj->json, ret_value_token_index) == parser_ok;
+                        totals->num_msg_amounts++;
+                    }
 
                     // GROUPING: Message Type
-                    if (parser_tx_obj.flags.msg_type_grouping && is_msg_type_field(tmp_key)) {
+                    if (tx_obj->flags.msg_type_grouping && is_msg_type_field(tmp_key)) {
                         // First message, initialize expected type
-                        if (parser_tx_obj.filter_msg_type_count == 0) {
+                        if (tx_obj->filter_msg_type_count == 0) {
                             if (strlen(tmp_val) >= sizeof(reference_msg_type)) {
-                                CLEAN_QUERY()
+                                CLEAN_QUERY(tx_obj)
                                 return parser_unexpected_type;
                             }
 
                             snprintf(reference_msg_type, sizeof(reference_msg_type), "%s", tmp_val);
-                            parser_tx_obj.filter_msg_type_valid_idx = current_item_idx;
+                            tx_obj->filter_msg_type_valid_idx = current_item_idx;
                         }
 
                         if (strcmp(reference_msg_type, tmp_val) != 0) {
                             // different values, so disable grouping
-                            parser_tx_obj.flags.msg_type_grouping = 0;
-                            parser_tx_obj.filter_msg_type_count = 0;
+                            tx_obj->flags.msg_type_grouping = 0;
+                            tx_obj->filter_msg_type_count = 0;
                         }
 
-                        parser_tx_obj.filter_msg_type_count++;
+                        tx_obj->filter_msg_type_count++;
                     }
 
                     // GROUPING: Message From
-                    if (parser_tx_obj.flags.msg_from_grouping && is_msg_from_field(tmp_key)) {
+                    if (tx_obj->flags.msg_from_grouping && is_msg_from_field(tmp_key)) {
                         // First message, initialize expected from
-                        if (parser_tx_obj.filter_msg_from_count == 0) {
+                        if (tx_obj->filter_msg_from_count == 0) {
                             snprintf(reference_msg_from, sizeof(reference_msg_from), "%s", tmp_val);
-                            parser_tx_obj.filter_msg_from_valid_idx = current_item_idx;
+                            tx_obj->filter_msg_from_valid_idx = current_item_idx;
                         }
 
                         if (strcmp(reference_msg_from, tmp_val) != 0) {
                             // different values, so disable grouping
-                            parser_tx_obj.flags.msg_from_grouping = 0;
-                            parser_tx_obj.filter_msg_from_count = 0;
+                            tx_obj->flags.msg_from_grouping = 0;
+                            tx_obj->filter_msg_from_count = 0;
                         }
 
-                        parser_tx_obj.filter_msg_from_count++;
+                        tx_obj->filter_msg_from_count++;
                     }
 
                     break;
                 }
+                case root_item_fee: {
+                    if (totals->valid && strcmp(tmp_key, "fee/amount") == 0) {
+                        totals->valid = parser_totals_add(totals, &tx_obj->json, ret_value_token_index) == parser_ok;
+                    }
+                    break;
+                }
                 default:
                     break;
             }
 
-            display_cache.root_item_number_subitems[root_item_idx]++;
+            if (tx_obj->display_cache.root_item_number_subitems[root_item_idx] == UINT16_MAX) {
+                CLEAN_QUERY(tx_obj)
+                return parser_value_out_of_range;
+            }
+            tx_obj->display_cache.root_item_number_subitems[root_item_idx]++;
             current_item_idx++;
         }
 
         if (err != parser_query_no_results && err != parser_no_data) {
-            CLEAN_QUERY()
+            CLEAN_QUERY(tx_obj)
             return err;
         }
 
-        display_cache.total_item_count += display_cache.root_item_number_subitems[root_item_idx];
+        const uint32_t total_item_count = (uint32_t)tx_obj->display_cache.total_item_count +
+                                          tx_obj->display_cache.root_item_number_subitems[root_item_idx];
+        if (total_item_count > UINT16_MAX) {
+            CLEAN_QUERY(tx_obj)
+            return parser_value_out_of_range;
+        }
+        tx_obj->display_cache.total_item_count = (uint16_t)total_item_count;
+    }
+
+    // A single message already shows what it spends
+    if (totals->valid && totals->num_msg_amounts > 1) {
+        if (tx_obj->display_cache.total_item_count > UINT16_MAX - totals->num_denoms) {
+            CLEAN_QUERY(tx_obj)
+            return parser_value_out_of_range;
+        }
+        tx_obj->display_cache.root_item_number_subitems[root_item_total] = totals->num_denoms;
+        tx_obj->display_cache.total_item_count += totals->num_denoms;
     }
 
-    parser_tx_obj.flags.cache_valid = 1;
+    tx_obj->flags.cache_valid = 1;
 
-    CHECK_ERROR_CLEAN_QUERY(calculate_is_default_chainid())
+    CHECK_ERROR_CLEAN_QUERY(tx_obj, calculate_is_default_chainid(tx_obj))
 
     // turn off grouping if we are not in expert mode
     bool is_expert_or_default = false;
-    CHECK_ERROR_CLEAN_QUERY(parser_is_expert_mode_or_not_default_chainid(&is_expert_or_default))
+    CHECK_ERROR_CLEAN_QUERY(tx_obj, parser_is_expert_mode_or_not_default_chainid(tx_obj, &is_expert_or_default))
     if (is_expert_or_default) {
-        parser_tx_obj.flags.msg_from_grouping = 0;
+        tx_obj->flags.msg_from_grouping = 0;
     }
 
     // check if from reference value matches the device address that will be signing
-    parser_tx_obj.flags.msg_from_grouping_hide_all = 0;
-    if (address_matches_own(reference_msg_from)) {
-        parser_tx_obj.flags.msg_from_grouping_hide_all = 1;
+    tx_obj->flags.msg_from_grouping_hide_all = 0;
+    if (address_matches_own(tx_obj, reference_msg_from)) {
+        tx_obj->flags.msg_from_grouping_hide_all = 1;
     }
-    CLEAN_QUERY()
+
+    // Walks done while indexing did not hide grouped fields
+    tx_obj->query_cursor.valid = false;
+    CLEAN_QUERY(tx_obj)
     return parser_ok;
 }
 
-__Z_INLINE parser_error_t is_default_chainid(bool *is_default) {
+__Z_INLINE parser_error_t is_default_chainid(parser_tx_t *tx_obj, bool *is_default) {
     if (is_default == NULL) {
         return parser_unexpected_value;
     }
 
-    CHECK_ERROR(parser_indexRootFields())
-    *is_default = display_cache.is_default_chain;
+    CHECK_ERROR(parser_indexRootFields(tx_obj))
+    *is_default = tx_obj->display_cache.is_default_chain;
 
     return parser_ok;
 }
 
-parser_error_t parser_is_expert_mode_or_not_default_chainid(bool *expert_or_default) {
+parser_error_t parser_is_expert_mode_or_not_default_chainid(parser_tx_t *tx_obj, bool *expert_or_default) {
     if (expert_or_default == NULL) {
         return parser_unexpected_value;
     }
 
     bool is_default = false;
-    CHECK_ERROR(is_default_chainid(&is_default))
+    CHECK_ERROR(is_default_chainid(tx_obj, &is_default))
     *expert_or_default = app_mode_expert() || !is_default;
 
     return parser_ok;
 }
 
-__Z_INLINE parser_error_t get_subitem_count(root_item_e root_item, uint8_t *num_items) {
+__Z_INLINE parser_error_t get_subitem_count(parser_tx_t *tx_obj, root_item_e root_item, uint16_t *num_items) {
     if (num_items == NULL) {
         return parser_unexpected_value;
     }
 
-    CHECK_ERROR(parser_indexRootFields())
-    if (display_cache.total_item_count == 0) {
+    CHECK_ERROR(parser_indexRootFields(tx_obj))
+    if (tx_obj->display_cache.total_item_count == 0) {
         *num_items = 0;
         return parser_ok;
     }
 
-    int32_t tmp_num_items = display_cache.root_item_number_subitems[root_item];
+    int32_t tmp_num_items = tx_obj->display_cache.root_item_number_subitems[root_item];
 
     switch (root_item) {
         case root_item_chain_id:
@@ -308,15 +465,15 @@ __Z_INLINE parser_error_t get_subitem_count(root_item_e root_item, uint8_t *num_
             break;
         case root_item_msgs: {
             // Remove grouped items from list
-            if (parser_tx_obj.flags.msg_type_grouping && parser_tx_obj.filter_msg_type_count > 0) {
+            if (tx_obj->flags.msg_type_grouping && tx_obj->filter_msg_type_count > 0) {
                 tmp_num_items += 1;  // we leave main type
-                tmp_num_items -= parser_tx_obj.filter_msg_type_count;
+                tmp_num_items -= tx_obj->filter_msg_type_count;
             }
-            if (parser_tx_obj.flags.msg_from_grouping && parser_tx_obj.filter_msg_from_count > 0) {
-                if (!parser_tx_obj.flags.msg_from_grouping_hide_all) {
+            if (tx_obj->flags.msg_from_grouping && tx_obj->filter_msg_from_count > 0) {
+                if (!tx_obj->flags.msg_from_grouping_hide_all) {
                     tmp_num_items += 1;  // we leave main from
                 }
-                tmp_num_items -= parser_tx_obj.filter_msg_from_count;
+                tmp_num_items -= tx_obj->filter_msg_from_count;
             }
             break;
         }
@@ -333,42 +490,57 @@ __Z_INLINE parser_error_t get_subitem_count(root_item_e root_item, uint8_t *num_
         default:
             break;
     }
-    *num_items = tmp_num_items;
+    if (tmp_num_items < 0 || tmp_num_items > UINT16_MAX) {
+        return parser_unexpected_number_items;
+    }
+    *num_items = (uint16_t)tmp_num_items;
 
     return parser_ok;
 }
 
-__Z_INLINE parser_error_t retrieve_tree_indexes(uint8_t display_index, root_item_e *root_item, uint8_t *subitem_index) {
+__Z_INLINE parser_error_t retrieve_tree_indexes(parser_tx_t *tx_obj, uint16_t display_index, root_item_e *root_item,
+                                                uint16_t *subitem_index) {
     if (root_item == NULL || subitem_index == NULL) {
         return parser_unexpected_value;
     }
 
     // Find root index | display_index idx -> item_index
     // consume indexed subpages until we get the item index in the subpage
-    *root_item = 0;
-    *subitem_index = 0;
-    uint8_t num_items;
-
-    CHECK_ERROR(get_subitem_count(*root_item, &num_items));
-    while (num_items == 0) {
-        (*root_item)++;
-        CHECK_ERROR(get_subitem_count(*root_item, &num_items));
+    display_cursor_t *cursor = &tx_obj->display_cache.cursor;
+    const bool expert = app_mode_expert();
+    uint16_t i = 0;
+
+    if (cursor->valid && cursor->expert == expert && cursor->display_index <= display_index) {
+        // Continue from the last item resolved
+        *root_item = cursor->root_item;
+        *subitem_index = cursor->subitem_index;
+        i = cursor->display_index;
+    } else {
+        *root_item = 0;
+        *subitem_index = 0;
+        uint16_t num_items;
+
+        CHECK_ERROR(get_subitem_count(tx_obj, *root_item, &num_items));
+        while (num_items == 0) {
+            (*root_item)++;
+            CHECK_ERROR(get_subitem_count(tx_obj, *root_item, &num_items));
+        }
     }
 
-    for (uint16_t i = 0; i < display_index; i++) {
+    for (; i < display_index; i++) {
         (*subitem_index)++;
-        uint8_t subitem_count = 0;
-        CHECK_ERROR(get_subitem_count(*root_item, &subitem_count));
+        uint16_t subitem_count = 0;
+        CHECK_ERROR(get_subitem_count(tx_obj, *root_item, &subitem_count));
         if (*subitem_index >= subitem_count) {
             // Advance root index and skip empty items
             *subitem_index = 0;
             (*root_item)++;
 
-            uint8_t num_items_2 = 0;
-            CHECK_ERROR(get_subitem_count(*root_item, &num_items_2));
+            uint16_t num_items_2 = 0;
+            CHECK_ERROR(get_subitem_count(tx_obj, *root_item, &num_items_2));
             while (num_items_2 == 0) {
                 (*root_item)++;
-                CHECK_ERROR(get_subitem_count(*root_item, &num_items_2));
+                CHECK_ERROR(get_subitem_count(tx_obj, *root_item, &num_items_2));
             }
         }
     }
@@ -377,58 +549,77 @@ __Z_INLINE parser_error_t retrieve_tree_indexes(uint8_t display_index, root_item
         return parser_no_data;
     }
 
+    cursor->valid = true;
+    cursor->expert = expert;
+    cursor->display_index = display_index;
+    cursor->root_item = *root_item;
+    cursor->subitem_index = *subitem_index;
+
     return parser_ok;
 }
 
-parser_error_t parser_display_numItems(uint8_t *num_items) {
+parser_error_t parser_display_numItems(parser_tx_t *tx_obj, uint16_t *num_items) {
     if (num_items == NULL) {
         return parser_unexpected_value;
     }
     *num_items = 0;
-    CHECK_ERROR(parser_indexRootFields())
+    CHECK_ERROR(parser_indexRootFields(tx_obj))
 
-    *num_items = 0;
-    uint8_t n_items = 0;
+    uint32_t total = 0;
+    uint16_t n_items = 0;
     for (root_item_e root_item = 0; root_item < NUM_REQUIRED_ROOT_PAGES; root_item++) {
-        CHECK_ERROR(get_subitem_count(root_item, &n_items))
-        *num_items += n_items;
+        CHECK_ERROR(get_subitem_count(tx_obj, root_item, &n_items))
+        total += n_items;
+    }
+    if (total > UINT16_MAX) {
+        return parser_unexpected_number_items;
     }
+    *num_items = (uint16_t)total;
 
     return parser_ok;
 }
 
 // This function assumes that the tx_ctx has been set properly
-parser_error_t parser_display_query(uint16_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal, uint16_t outValLen,
-                                    uint16_t *ret_value_token_index) {
+parser_error_t parser_display_query(parser_tx_t *tx_obj, uint16_t displayIdx, char *outKey, uint16_t outKeyLen,
+                                    char *outVal, uint16_t outValLen, uint16_t *ret_value_token_index) {
     if (outKey == NULL || ret_value_token_index == NULL) {
         return parser_unexpected_value;
     }
-    CHECK_ERROR(parser_indexRootFields())
+    CHECK_ERROR(parser_indexRootFields(tx_obj))
 
-    uint8_t num_items;
-    CHECK_ERROR(parser_display_numItems(&num_items))
+    uint16_t num_items;
+    CHECK_ERROR(parser_display_numItems(tx_obj, &num_items))
 
     if (displayIdx >= num_items) {
         return parser_display_idx_out_of_range;
     }
 
     root_item_e root_index = 0;
-    uint8_t subitem_index = 0;
-    CHECK_ERROR(retrieve_tree_indexes(displayIdx, &root_index, &subitem_index))
+    uint16_t subitem_index = 0;
+    CHECK_ERROR(retrieve_tree_indexes(tx_obj, displayIdx, &root_index, &subitem_index))
 
     // Prepare query
-    INIT_QUERY_CONTEXT(outKey, outKeyLen, outVal, sizeof(outValLen), 0, get_root_max_level(root_index))
-    parser_tx_obj.query.item_index = subitem_index;
-    parser_tx_obj.query._item_index_current = 0;
+    INIT_QUERY_CONTEXT(tx_obj, outKey, outKeyLen, outVal, sizeof(outValLen), 0, get_root_max_level(root_index))
+    tx_obj->query.msg_levels = root_index == root_item_msgs;
+    tx_obj->query.item_index = subitem_index;
+    tx_obj->query._item_index_current = 0;
 
     strncpy_s(outKey, get_required_root_item(root_index), outKeyLen);
 
-    if (!display_cache.root_item_start_token_valid[root_index]) {
-        CLEAN_QUERY()
+    if (root_index == root_item_total) {
+        // Totals are not in the JSON, the value index is the one of the denom
+        *ret_value_token_index = subitem_index;
+        return parser_ok;
+    }
+
+    if (!tx_obj->display_cache.root_item_start_token_valid[root_index]) {
+        CLEAN_QUERY(tx_obj)
         return parser_no_data;
     }
 
-    CHECK_ERROR_CLEAN_QUERY(parser_traverse_find(display_cache.root_item_start_token_idx[root_index], ret_value_token_index))
+    CHECK_ERROR_CLEAN_QUERY(tx_obj, parser_traverse_find(tx_obj, tx_obj->display_cache.root_item_start_token_idx[root_index],
+                                                         ret_value_token_index))
+    CHECK_ERROR_CLEAN_QUERY(tx_obj, check_key_fits(tx_obj))
     return parser_ok;
 }
 
@@ -438,6 +629,7 @@ static const key_subst_t key_substitutions[] = {
     {"sequence", "Sequence"},
     {"memo", "Memo"},
     {"fee/amount", "Fee"},
+    {"total", "Total"},
     {"fee/gas", "Gas"},
     {"fee/gas_limit", "Gas Limit"},
     {"msgs/type", "Type"},
@@ -460,37 +652,60 @@ static const key_subst_t key_substitutions[] = {
     {"msgs/value/inputs/coins", "Src Coins"},
     {"msgs/value/outputs/address", "Dest Address"},
     {"msgs/value/outputs/coins", "Dest Coins"},
+
+    {"msgs/value/grantee", "Grantee"},
+    {"msgs/value/msgs/type", "Authz type"},
+    {"msgs/value/msgs/value/amount", "Authz amount"},
+    {"msgs/value/msgs/value/from_address", "Authz from"},
+    {"msgs/value/msgs/value/to_address", "Authz to"},
+    {"msgs/value/msgs/value/grantee", "Authz grantee"},
+    {"msgs/value/msgs/value/msgs", "Authz msgs"},
+    {"msgs/value/msgs/value/delegator_address", "Authz delegator"},
+    {"msgs/value/msgs/value/validator_address", "Authz validator"},
+    {"msgs/value/msgs/value/validator_dst_address", "Authz validator dest"},
+    {"msgs/value/msgs/value/validator_src_address", "Authz validator source"},
+    {"msgs/value/msgs/value/contract", "Authz contract"},
+    {"msgs/value/msgs/value/funds", "Authz funds"},
+    {"msgs/value/msgs/value/msg", "Authz msg"},
+    {"msgs/value/msgs/value/sender", "Authz sender"},
 };
 
-parser_error_t parser_display_make_friendly() {
-    if (!parser_tx_obj.flags.cache_valid) {
-        return parser_unexpected_value;
+void parser_friendly_key(char *key, uint16_t keyLen) {
+    if (key == NULL) {
+        return;
     }
 
-    // post process keys
     for (size_t i = 0; i < array_length(key_substitutions); i++) {
         const char *str1 = (const char *)PIC(key_substitutions[i].str1);
         const char *str2 = (const char *)PIC(key_substitutions[i].str2);
         const uint16_t str1Len = strlen(str1);
         const uint16_t str2Len = strlen(str2);
 
-        const uint16_t outKeyLen = strnlen(parser_tx_obj.query.out_key, parser_tx_obj.query.out_key_len);
-        if ((outKeyLen == str1Len && strncmp(parser_tx_obj.query.out_key, str1, str1Len) == 0) &&
-            parser_tx_obj.query.out_key_len >= str2Len) {
-            MEMZERO(parser_tx_obj.query.out_key, parser_tx_obj.query.out_key_len);
-            MEMCPY(parser_tx_obj.query.out_key, str2, str2Len);
+        const uint16_t currentLen = strnlen(key, keyLen);
+        if ((currentLen == str1Len && strncmp(key, str1, str1Len) == 0) && keyLen >= str2Len) {
+            MEMZERO(key, keyLen);
+            MEMCPY(key, str2, str2Len);
             break;
         }
     }
+}
+
+parser_error_t parser_display_make_friendly(parser_tx_t *tx_obj) {
+    if (!tx_obj->flags.cache_valid) {
+        return parser_unexpected_value;
+    }
+
+    // post process keys
+    parser_friendly_key(tx_obj->query.out_key, tx_obj->query.out_key_len);
     return parser_ok;
 }
 
-__Z_INLINE bool parser_areEqual(uint16_t tokenIdx, const char *expected) {
-    if (parser_tx_obj.json.tokens[tokenIdx].type != JSMN_STRING) {
+__Z_INLINE bool parser_areEqual(const parser_tx_t *tx_obj, uint16_t tokenIdx, const char *expected) {
+    if (tx_obj->json.tokens[tokenIdx].type != JSMN_STRING) {
         return false;
     }
 
-    int32_t len = parser_tx_obj.json.tokens[tokenIdx].end - parser_tx_obj.json.tokens[tokenIdx].start;
+    int32_t len = tx_obj->json.tokens[tokenIdx].end - tx_obj->json.tokens[tokenIdx].start;
     if (len < 0) {
         return false;
     }
@@ -499,7 +714,7 @@ __Z_INLINE bool parser_areEqual(uint16_t tokenIdx, const char *expected) {
         return false;
     }
 
-    const char *p = parser_tx_obj.tx + parser_tx_obj.json.tokens[tokenIdx].start;
+    const char *p = tx_obj->tx + tx_obj->json.tokens[tokenIdx].start;
     for (int32_t i = 0; i < len; i++) {
         if (expected[i] != *(p + i)) {
             return false;
@@ -533,28 +748,11 @@ bool parser_isAmount(char *key) {
         return true;
     }
 
-    return false;
-}
-
-__Z_INLINE parser_error_t is_default_denom_base(const char *denom, uint8_t denom_len, bool *is_default) {
-    if (denom == NULL || denom_len == 0) {
-        return parser_unexpected_value;
-    }
-    if (is_default == NULL) {
-        return parser_unexpected_value;
-    }
-
-    if (strlen(COIN_DEFAULT_DENOM_BASE) != denom_len) {
-        *is_default = false;
-        return parser_ok;
-    }
-
-    if (memcmp(denom, COIN_DEFAULT_DENOM_BASE, denom_len) == 0) {
-        *is_default = true;
-        return parser_ok;
+    if (strcmp(key, "msgs/value/msgs/value/amount") == 0) {
+        return true;
     }
 
-    return parser_ok;
+    return false;
 }
 
 void remove_fraction(char *s) {
@@ -584,15 +782,76 @@ void remove_fraction(char *s) {
     }
 }
 
-__Z_INLINE parser_error_t parser_formatAmountItem(uint16_t amountToken, char *outVal, uint16_t outValLen, uint8_t pageIdx,
-                                                  uint8_t *pageCount) {
+// Buffers parser_formatCoin takes from the scratch arena
+typedef struct {
+    char bufferUI[100];
+    char denom[COIN_DENOM_MAXSIZE];
+    char amount[COIN_AMOUNT_MAXSIZE];
+} format_coin_scratch_t;
+
+static parser_error_t format_coin(format_coin_scratch_t *tmp, const char *amount, uint16_t amountLen, const char *denom,
+                                  uint16_t denomLen, char *outVal, uint16_t outValLen, uint8_t pageIdx,
+                                  uint8_t *pageCount) {
+    const size_t totalLen = amountLen + denomLen + 2;
+    if (sizeof(tmp->bufferUI) < totalLen) {
+        return parser_unexpected_buffer_end;
+    }
+
+    // Extract amount and denomination
+    MEMCPY(tmp->denom, denom, denomLen);
+    MEMCPY(tmp->amount, amount, amountLen);
+
+    snprintf(tmp->bufferUI, sizeof(tmp->bufferUI), "%s ", tmp->amount);
+    // If denomination has been recognized format and replace
+    const denom_info_t *info = denom_registry_lookup(denom, denomLen);
+    if (info != NULL) {
+        if (fpstr_to_str(tmp->bufferUI, sizeof(tmp->bufferUI), tmp->amount, info->exponent) != 0) {
+            return parser_unexpected_error;
+        }
+        number_inplace_trimming(tmp->bufferUI, 1);
+        remove_fraction(tmp->bufferUI);
+        snprintf(tmp->denom, sizeof(tmp->denom), " %s", (const char *)PIC(info->symbol));
+    }
+
+    z_str3join(tmp->bufferUI, sizeof(tmp->bufferUI), "", tmp->denom);
+    pageString(outVal, outValLen, tmp->bufferUI, pageIdx, pageCount);
+
+    return parser_ok;
+}
+
+parser_error_t parser_formatCoin(const char *amount, uint16_t amountLen, const char *denom, uint16_t denomLen,
+                                 char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    if (amount == NULL || denom == NULL || outVal == NULL || outValLen == 0 || pageCount == NULL) {
+        return parser_unexpected_error;
+    }
+    if (denomLen == 0 || denomLen >= COIN_DENOM_MAXSIZE) {
+        return parser_unexpected_error;
+    }
+    if (amountLen == 0 || amountLen >= COIN_AMOUNT_MAXSIZE) {
+        return parser_unexpected_error;
+    }
+    MEMZERO(outVal, outValLen);
+
+    const scratch_mark_t mark = scratch_mark();
+    format_coin_scratch_t *tmp = scratch_alloc(sizeof(format_coin_scratch_t));
+    if (tmp == NULL) {
+        return parser_unexpected_error;
+    }
+    const parser_error_t err =
+        format_coin(tmp, amount, amountLen, denom, denomLen, outVal, outValLen, pageIdx, pageCount);
+    scratch_release(mark);
+    return err;
+}
+
+__Z_INLINE parser_error_t parser_formatAmountItem(const parser_tx_t *tx_obj, uint16_t amountToken, char *outVal,
+                                                  uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
     if (outVal == NULL || outValLen == 0 || pageCount == NULL) {
         return parser_unexpected_error;
     }
     *pageCount = 0;
 
     uint16_t numElements;
-    CHECK_ERROR(array_get_element_count(&parser_tx_obj.json, amountToken, &numElements))
+    CHECK_ERROR(array_get_element_count(&tx_obj->json, amountToken, &numElements))
 
     if (numElements == 0) {
         *pageCount = 1;
@@ -604,36 +863,28 @@ __Z_INLINE parser_error_t parser_formatAmountItem(uint16_t amountToken, char *ou
         return parser_unexpected_field;
     }
 
-    if (parser_tx_obj.json.tokens[amountToken].type != JSMN_OBJECT) {
+    if (tx_obj->json.tokens[amountToken].type != JSMN_OBJECT) {
         return parser_unexpected_field;
     }
 
-    if (!parser_areEqual(amountToken + 1u, "amount")) {
+    if (!parser_areEqual(tx_obj, amountToken + 1u, "amount")) {
         return parser_unexpected_field;
     }
 
-    if (!parser_areEqual(amountToken + 3u, "denom")) {
+    if (!parser_areEqual(tx_obj, amountToken + 3u, "denom")) {
         return parser_unexpected_field;
     }
 
-    char bufferUI[100];
-    char tmpDenom[COIN_DENOM_MAXSIZE];
-    char tmpAmount[COIN_AMOUNT_MAXSIZE];
-    MEMZERO(tmpDenom, sizeof tmpDenom);
-    MEMZERO(tmpAmount, sizeof(tmpAmount));
-    MEMZERO(outVal, outValLen);
-    MEMZERO(bufferUI, sizeof(bufferUI));
-
-    if (parser_tx_obj.json.tokens[amountToken + 2].start < 0 || parser_tx_obj.json.tokens[amountToken + 4].start < 0) {
+    if (tx_obj->json.tokens[amountToken + 2].start < 0 || tx_obj->json.tokens[amountToken + 4].start < 0) {
         return parser_unexpected_buffer_end;
     }
-    const char *amountPtr = parser_tx_obj.tx + parser_tx_obj.json.tokens[amountToken + 2].start;
+    const char *amountPtr = tx_obj->tx + tx_obj->json.tokens[amountToken + 2].start;
 
     const int32_t amountLen =
-        parser_tx_obj.json.tokens[amountToken + 2].end - parser_tx_obj.json.tokens[amountToken + 2].start;
-    const char *denomPtr = parser_tx_obj.tx + parser_tx_obj.json.tokens[amountToken + 4].start;
+        tx_obj->json.tokens[amountToken + 2].end - tx_obj->json.tokens[amountToken + 2].start;
+    const char *denomPtr = tx_obj->tx + tx_obj->json.tokens[amountToken + 4].start;
     const int32_t denomLen =
-        parser_tx_obj.json.tokens[amountToken + 4].end - parser_tx_obj.json.tokens[amountToken + 4].start;
+        tx_obj->json.tokens[amountToken + 4].end - tx_obj->json.tokens[amountToken + 4].start;
 
     if (denomLen <= 0 || denomLen >= COIN_DENOM_MAXSIZE) {
         return parser_unexpected_error;
@@ -642,61 +893,40 @@ __Z_INLINE parser_error_t parser_formatAmountItem(uint16_t amountToken, char *ou
         return parser_unexpected_error;
     }
 
-    const size_t totalLen = amountLen + denomLen + 2;
-    if (sizeof(bufferUI) < totalLen) {
-        return parser_unexpected_buffer_end;
-    }
-
-    // Extract amount and denomination
-    MEMCPY(tmpDenom, denomPtr, denomLen);
-    MEMCPY(tmpAmount, amountPtr, amountLen);
-
-    snprintf(bufferUI, sizeof(bufferUI), "%s ", tmpAmount);
-    // If denomination has been recognized format and replace
-    bool is_default = false;
-    CHECK_ERROR(is_default_denom_base(denomPtr, denomLen, &is_default))
-
-    if (is_default) {
-        if (fpstr_to_str(bufferUI, sizeof(bufferUI), tmpAmount, COIN_DEFAULT_DENOM_FACTOR) != 0) {
-            return parser_unexpected_error;
-        }
-        number_inplace_trimming(bufferUI, 1);
-        remove_fraction(bufferUI);
-        snprintf(tmpDenom, sizeof(tmpDenom), " %s", COIN_DEFAULT_DENOM_REPR);
-    }
-
-    z_str3join(bufferUI, sizeof(bufferUI), "", tmpDenom);
-    pageString(outVal, outValLen, bufferUI, pageIdx, pageCount);
-
-    return parser_ok;
+    return parser_formatCoin(amountPtr, (uint16_t)amountLen, denomPtr, (uint16_t)denomLen, outVal, outValLen, pageIdx,
+                             pageCount);
 }
 
-parser_error_t parser_formatAmount(uint16_t amountToken, char *outVal, uint16_t outValLen, uint8_t pageIdx,
-                                   uint8_t *pageCount) {
+parser_error_t parser_formatAmount(parser_tx_t *tx_obj, uint16_t amountToken, char *outVal, uint16_t outValLen,
+                                   uint8_t pageIdx, uint8_t *pageCount) {
     if (outVal == NULL || pageCount == NULL) {
         return parser_unexpected_error;
     }
     *pageCount = 0;
-    if (parser_tx_obj.json.tokens[amountToken].type != JSMN_ARRAY) {
-        return parser_formatAmountItem(amountToken, outVal, outValLen, pageIdx, pageCount);
+    if (tx_obj->json.tokens[amountToken].type != JSMN_ARRAY) {
+        return parser_formatAmountItem(tx_obj, amountToken, outVal, outValLen, pageIdx, pageCount);
     }
 
-    uint8_t totalPages = 0;
+    // Pages are addressed with 8 bits like in pageString, a list of coins that needs more is refused
+    uint16_t totalPages = 0;
     uint8_t showItemSet = 0;
     uint8_t showPageIdx = pageIdx;
     uint16_t showItemTokenIdx = 0;
 
     uint16_t numberAmounts;
-    CHECK_ERROR(array_get_element_count(&parser_tx_obj.json, amountToken, &numberAmounts))
+    CHECK_ERROR(array_get_element_count(&tx_obj->json, amountToken, &numberAmounts))
 
     // Count total subpagesCount and calculate correct page and TokenIdx
     for (uint16_t i = 0; i < numberAmounts; i++) {
         uint16_t itemTokenIdx;
         uint8_t subpagesCount;
 
-        CHECK_ERROR(array_get_nth_element(&parser_tx_obj.json, amountToken, i, &itemTokenIdx));
-        CHECK_ERROR(parser_formatAmountItem(itemTokenIdx, outVal, outValLen, 0, &subpagesCount));
+        CHECK_ERROR(array_get_nth_element(&tx_obj->json, amountToken, i, &itemTokenIdx));
+        CHECK_ERROR(parser_formatAmountItem(tx_obj, itemTokenIdx, outVal, outValLen, 0, &subpagesCount));
         totalPages += subpagesCount;
+        if (totalPages > UINT8_MAX) {
+            return parser_value_out_of_range;
+        }
 
         if (!showItemSet) {
             if (showPageIdx < subpagesCount) {
@@ -707,7 +937,7 @@ parser_error_t parser_formatAmount(uint16_t amountToken, char *outVal, uint16_t
             }
         }
     }
-    *pageCount = totalPages;
+    *pageCount = (uint8_t)totalPages;
     if (pageIdx > totalPages) {
         return parser_unexpected_value;
     }
@@ -719,5 +949,25 @@ parser_error_t parser_formatAmount(uint16_t amountToken, char *outVal, uint16_t
     }
 
     uint8_t dummy;
-    return parser_formatAmountItem(showItemTokenIdx, outVal, outValLen, showPageIdx, &dummy);
+    return parser_formatAmountItem(tx_obj, showItemTokenIdx, outVal, outValLen, showPageIdx, &dummy);
+}
+
+bool parser_isContractMsg(char *key) { return key != NULL && strcmp(key, "msgs/value/msg") == 0; }
+
+parser_error_t parser_formatContractMsg(parser_tx_t *tx_obj, uint16_t msgToken, char *outVal, uint16_t outValLen,
+                                        uint8_t pageIdx, uint8_t *pageCount) {
+    if (tx_obj == NULL || msgToken >= tx_obj->json.numberOfTokens) {
+        return parser_unexpected_value;
+    }
+
+    const jsmntok_t *token = &tx_obj->json.tokens[msgToken];
+    if (token->type != JSMN_OBJECT && token->type != JSMN_ARRAY) {
+        return parser_getToken(tx_obj, msgToken, outVal, outValLen, pageIdx, pageCount);
+    }
+    if (token->start < 0 || token->end < token->start) {
+        return parser_unexpected_buffer_end;
+    }
+
+    return json_pages_render(&tx_obj->display_cache.msg_pages, tx_obj->tx + token->start,
+                             (uint16_t)(token->end - token->start), outVal, outValLen, pageIdx, pageCount);
 }
@@ -27,8 +27,6 @@
 extern "C" {
 #endif
 
-#define NUM_REQUIRED_ROOT_PAGES 7
-
 typedef enum {
     root_item_chain_id = 0,
     root_item_account_number,
@@ -37,36 +35,38 @@ typedef enum {
     root_item_memo,
     root_item_fee,
     root_item_tip,
+    // Not in the JSON, per-denom sums of what the transaction spends
+    root_item_total,
 } root_item_e;
 
-typedef struct {
-    bool root_item_start_token_valid[NUM_REQUIRED_ROOT_PAGES];
-    // token where the root_item starts (negative for non-existing)
-    uint16_t root_item_start_token_idx[NUM_REQUIRED_ROOT_PAGES];
-
-    // total items
-    uint16_t total_item_count;
-    // number of items the root_item contains
-    uint8_t root_item_number_subitems[NUM_REQUIRED_ROOT_PAGES];
+parser_error_t parser_is_expert_mode_or_not_default_chainid(parser_tx_t *tx_obj, bool *expert_or_default);
 
-    uint8_t is_default_chain;
-} display_cache_t;
+const char *get_required_root_item(root_item_e i);
 
-parser_error_t parser_is_expert_mode_or_not_default_chainid(bool *expert_or_default);
+parser_error_t parser_display_query(parser_tx_t *tx_obj, uint16_t displayIdx, char *outKey, uint16_t outKeyLen,
+                                    char *outVal, uint16_t outValLen, uint16_t *ret_value_token_index);
 
-const char *get_required_root_item(root_item_e i);
+parser_error_t parser_display_numItems(parser_tx_t *tx_obj, uint16_t *num_items);
 
-parser_error_t parser_display_query(uint16_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal, uint16_t outValLen,
-                                    uint16_t *ret_value_token_index);
+parser_error_t parser_display_make_friendly(parser_tx_t *tx_obj);
 
-parser_error_t parser_display_numItems(uint8_t *num_items);
+// Replaces a raw path key (e.g. "msgs/value/amount") by its label, in place
+void parser_friendly_key(char *key, uint16_t keyLen);
 
-parser_error_t parser_display_make_friendly();
+// Formats a single coin; amounts in a registered denom are scaled and shown with its symbol (denom_registry.h)
+parser_error_t parser_formatCoin(const char *amount, uint16_t amountLen, const char *denom, uint16_t denomLen,
+                                 char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount);
 
-parser_error_t parser_formatAmount(uint16_t amountToken, char *outVal, uint16_t outValLen, uint8_t pageIdx,
-                                   uint8_t *pageCount);
+parser_error_t parser_formatAmount(parser_tx_t *tx_obj, uint16_t amountToken, char *outVal, uint16_t outValLen,
+                                   uint8_t pageIdx, uint8_t *pageCount);
 
 bool parser_isAmount(char *key);
+
+bool parser_isContractMsg(char *key);
+
+// Pages through the message of a contract call, see json_pages_render
+parser_error_t parser_formatContractMsg(parser_tx_t *tx_obj, uint16_t msgToken, char *outVal, uint16_t outValLen,
+                                        uint8_t pageIdx, uint8_t *pageCount);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "parser_totals.h"
+
+#include <zxmacros.h>
+
+#include "parser_print.h"
+
+parser_error_t parser_decimal_add(char *acc, uint16_t accSize, const char *digits, uint16_t digitsLen) {
+    if (acc == NULL || digits == NULL || accSize < 2 || digitsLen == 0) {
+        return parser_unexpected_value;
+    }
+    const uint16_t accLen = (uint16_t)strnlen(acc, accSize);
+    if (accLen == accSize) {
+        return parser_unexpected_value;
+    }
+
+    // The sum is written right aligned, one digit per column from the least significant one
+    char sum[COIN_AMOUNT_MAXSIZE];
+    if (accSize > sizeof(sum)) {
+        return parser_unexpected_value;
+    }
+    uint16_t pos = accSize - 1;
+    sum[pos] = 0;
+
+    uint16_t i = accLen;
+    uint16_t j = digitsLen;
+    uint8_t carry = 0;
+    while (i > 0 || j > 0 || carry != 0) {
+        uint8_t column = carry;
+        if (i > 0) {
+            i--;
+            if (acc[i] < '0' || acc[i] > '9') {
+                return parser_unexpected_characters;
+            }
+            column += (uint8_t)(acc[i] - '0');
+        }
+        if (j > 0) {
+            j--;
+            if (digits[j] < '0' || digits[j] > '9') {
+                return parser_unexpected_characters;
+            }
+            column += (uint8_t)(digits[j] - '0');
+        }
+        if (pos == 0) {
+            return parser_value_out_of_range;
+        }
+        sum[--pos] = (char)('0' + column % 10);
+        carry = column / 10;
+    }
+
+    // Leading zeros of the inputs are not kept, a zero sum is "0"
+    while (sum[pos] == '0' && sum[pos + 1] != 0) {
+        pos++;
+    }
+
+    MEMZERO(acc, accSize);
+    MEMCPY(acc, sum + pos, accSize - 1 - pos);
+    return parser_ok;
+}
+
+void parser_totals_reset(denom_totals_t *totals) {
+    if (totals == NULL) {
+        return;
+    }
+    MEMZERO(totals, sizeof(*totals));
+    totals->valid = true;
+}
+
+static bool totals_sameString(const parsed_json_t *json, uint16_t tokenA, uint16_t tokenB) {
+    const int32_t lenA = json->tokens[tokenA].end - json->tokens[tokenA].start;
+    const int32_t lenB = json->tokens[tokenB].end - json->tokens[tokenB].start;
+    if (lenA != lenB) {
+        return false;
+    }
+    return memcmp(json->buffer + json->tokens[tokenA].start, json->buffer + json->tokens[tokenB].start, lenA) == 0;
+}
+
+static parser_error_t totals_addCoin(denom_totals_t *totals, const parsed_json_t *json, uint16_t coinToken) {
+    if (json->tokens[coinToken].type != JSMN_OBJECT) {
+        return parser_unexpected_type;
+    }
+
+    uint16_t amountToken = 0;
+    uint16_t denomToken = 0;
+    CHECK_ERROR(object_get_value(json, coinToken, "amount", &amountToken))
+    CHECK_ERROR(object_get_value(json, coinToken, "denom", &denomToken))
+    if (json->tokens[amountToken].type != JSMN_STRING || json->tokens[denomToken].type != JSMN_STRING) {
+        return parser_unexpected_type;
+    }
+
+    const int32_t amountLen = json->tokens[amountToken].end - json->tokens[amountToken].start;
+    const int32_t denomLen = json->tokens[denomToken].end - json->tokens[denomToken].start;
+    if (amountLen <= 0 || amountLen >= COIN_AMOUNT_MAXSIZE || denomLen <= 0 || denomLen >= COIN_DENOM_MAXSIZE) {
+        return parser_value_out_of_range;
+    }
+
+    denom_total_t *total = NULL;
+    for (uint8_t i = 0; i < totals->num_denoms; i++) {
+        if (totals_sameString(json, totals->denoms[i].denom_token, denomToken)) {
+            total = &totals->denoms[i];
+            break;
+        }
+    }
+    if (total == NULL) {
+        if (totals->num_denoms >= COIN_TOTALS_MAX_DENOMS) {
+            return parser_value_out_of_range;
+        }
+        total = &totals->denoms[totals->num_denoms++];
+        MEMZERO(total, sizeof(*total));
+        total->denom_token = denomToken;
+    }
+
+    return parser_decimal_add(total->amount, sizeof(total->amount), json->buffer + json->tokens[amountToken].start,
+                              (uint16_t)amountLen);
+}
+
+parser_error_t parser_totals_add(denom_totals_t *totals, const parsed_json_t *json, uint16_t coinsToken) {
+    if (totals == NULL || json == NULL || coinsToken >= json->numberOfTokens) {
+        return parser_unexpected_value;
+    }
+
+    if (json->tokens[coinsToken].type == JSMN_OBJECT) {
+        return totals_addCoin(totals, json, coinsToken);
+    }
+    if (json->tokens[coinsToken].type != JSMN_ARRAY) {
+        return parser_unexpected_type;
+    }
+
+    uint16_t numCoins = 0;
+    CHECK_ERROR(array_get_element_count(json, coinsToken, &numCoins))
+    for (uint16_t i = 0; i < numCoins; i++) {
+        uint16_t coinToken = 0;
+        CHECK_ERROR(array_get_nth_element(json, coinsToken, i, &coinToken))
+        CHECK_ERROR(totals_addCoin(totals, json, coinToken))
+    }
+    return parser_ok;
+}
+
+parser_error_t parser_totals_format(const denom_totals_t *totals, const parsed_json_t *json, uint16_t idx, char *outVal,
+                                    uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    if (totals == NULL || json == NULL) {
+        return parser_unexpected_value;
+    }
+    if (!totals->valid || idx >= totals->num_denoms) {
+        return parser_display_idx_out_of_range;
+    }
+
+    const denom_total_t *total = &totals->denoms[idx];
+    const jsmntok_t *denom = &json->tokens[total->denom_token];
+    return parser_formatCoin(total->amount, (uint16_t)strlen(total->amount), json->buffer + denom->start,
+                             (uint16_t)(denom->end - denom->start), outVal, outValLen, pageIdx, pageCount);
+}
@@ -0,0 +1,42 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "parser_common.h"
+#include "parser_txdef.h"
+
+// Adds the decimal string digits[0..digitsLen) to the NUL terminated decimal string acc, which holds at most
+// accSize - 1 digits. An empty acc counts as zero. On error acc is left unchanged.
+parser_error_t parser_decimal_add(char *acc, uint16_t accSize, const char *digits, uint16_t digitsLen);
+
+void parser_totals_reset(denom_totals_t *totals);
+
+// Adds a coin object or a list of coins to the per-denom totals
+parser_error_t parser_totals_add(denom_totals_t *totals, const parsed_json_t *json, uint16_t coinsToken);
+
+// Formats the total of the denom at index idx like any other amount
+parser_error_t parser_totals_format(const denom_totals_t *totals, const parsed_json_t *json, uint16_t idx, char *outVal,
+                                    uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount);
+
+#ifdef __cplusplus
+}
+#endif
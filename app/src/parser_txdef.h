@@ -22,7 +22,13 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#include "coin.h"
+#include "json_pages.h"
 #include "json_parser.h"
+
+// Containers parser_traverse_find descends into before flattening
+#define MAX_RECURSION_DEPTH 6
+
 typedef struct {
     // These are internal values used for tracking the state of the query/search
     uint16_t _item_index_current;
@@ -33,6 +39,9 @@ typedef struct {
     // maximum tree traversal depth. This limits possible stack overflow issues
     uint8_t max_depth;
 
+    // The root is msgs, each message is flattened with its own level from display_cache.msgs instead of max_level
+    bool msg_levels;
+
     // Index of the item to retrieve
     int16_t item_index;
     // Chunk of the item to retrieve (assuming partitioning based on out_val_len chunks)
@@ -45,6 +54,118 @@ typedef struct {
     int16_t out_val_len;
 } tx_query_t;
 
+typedef struct {
+    // Object or array whose children are being visited
+    uint16_t token;
+    // Next token the child scan looks at and end of the last child found (see object_get_nth_key)
+    uint16_t next_token;
+    uint16_t prev_element_end;
+    // Arrays only: children left before the walk gives up on this array
+    uint16_t children_left;
+    // Key of the child being visited (objects only) and out_key length before it was appended
+    uint16_t key_token;
+    uint16_t key_len;
+    // Level and depth left at this container
+    uint8_t max_level;
+    uint8_t max_depth;
+} traverse_frame_t;
+
+// Where the last successful parser_traverse_find stopped. A query for the same root asking for the same or a
+// later item continues from here instead of walking the tree again from the root.
+typedef struct {
+    bool valid;
+
+    // Query the walk belongs to
+    const char *tx;
+    uint16_t root_token;
+    uint8_t max_level;
+    uint8_t max_depth;
+    bool msg_levels;
+    uint16_t out_key_len;
+    uint16_t root_key_len;
+
+    // Message the leaf belongs to and the next one the walk enters, when the query has msg_levels
+    uint16_t msg_index;
+    uint16_t next_msg;
+
+    // Item that was found, as requested and with the fields skipped by grouping before it
+    int16_t item_index;
+    int16_t skipped;
+    uint16_t item_index_current;
+
+    // Leaf token and the containers above it, outermost first
+    uint16_t leaf_token;
+    uint8_t leaf_max_level;
+    uint8_t leaf_max_depth;
+    uint8_t depth;
+    traverse_frame_t frames[MAX_RECURSION_DEPTH];
+} traverse_cursor_t;
+
+#define NUM_REQUIRED_ROOT_PAGES 8
+
+// Last display item resolved, the review asks for items in order so the next one is found from here
+typedef struct {
+    bool valid;
+    // Expert mode shows a different set of items
+    bool expert;
+    uint16_t display_index;
+    uint8_t root_item;
+    uint16_t subitem_index;
+} display_cursor_t;
+
+// Sum of the amounts of one denom, the denom is the string of the first coin token that had it
+typedef struct {
+    uint16_t denom_token;
+    // Decimal digits, most significant first
+    char amount[COIN_AMOUNT_MAXSIZE];
+} denom_total_t;
+
+typedef struct {
+    // Cleared when an amount cannot be added, the transaction is then shown without totals
+    bool valid;
+    // Messages whose amounts were added, totals are only shown when there is more than one
+    uint16_t num_msg_amounts;
+    uint8_t num_denoms;
+    denom_total_t denoms[COIN_TOTALS_MAX_DENOMS];
+} denom_totals_t;
+
+// A message with a type takes at least three tokens (the object, the "type" key and its value), transactions with
+// more elements in msgs than this are refused
+#define TX_MAX_MSGS (MAX_NUMBER_OF_TOKENS / 3)
+
+// What indexing found out about one message
+typedef struct {
+    // msg_schema_find of its type
+    uint8_t schema;
+    // Levels flattened into item keys, see msg_schema_t
+    uint8_t level;
+} msg_info_t;
+
+typedef struct {
+    bool root_item_start_token_valid[NUM_REQUIRED_ROOT_PAGES];
+    // token where the root_item starts (negative for non-existing)
+    uint16_t root_item_start_token_idx[NUM_REQUIRED_ROOT_PAGES];
+
+    // total items
+    uint16_t total_item_count;
+    // number of items the root_item contains
+    uint16_t root_item_number_subitems[NUM_REQUIRED_ROOT_PAGES];
+
+    uint8_t is_default_chain;
+
+    // Elements of the msgs array, or the msgs object itself
+    uint16_t num_msgs;
+    msg_info_t msgs[TX_MAX_MSGS];
+
+    // Amounts spent by the messages and the fee, per denom
+    denom_totals_t totals;
+
+    // Page boundaries of the contract message shown last
+    json_pages_t msg_pages;
+
+    display_cursor_t cursor;
+} display_cache_t;
+
 typedef struct {
     // Buffer to the original tx blob
     const char *tx;
@@ -61,16 +182,20 @@ typedef struct {
     } flags;
 
     // indicates that N identical msg_type fields have been detected
-    uint8_t filter_msg_type_count;
+    uint16_t filter_msg_type_count;
     int32_t filter_msg_type_valid_idx;
 
     // indicates that N identical msg_from fields have been detected
-    uint8_t filter_msg_from_count;
+    uint16_t filter_msg_from_count;
     int32_t filter_msg_from_valid_idx;
     const char *own_addr;
 
     // current tx query
     tx_query_t query;
+    traverse_cursor_t query_cursor;
+
+    // root items indexed by parser_indexRootFields
+    display_cache_t display_cache;
 } parser_tx_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,726 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "parser_impl_pb.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <zxformat.h>
+#include <zxmacros.h>
+
+#include "app_mode.h"
+#include "coin.h"
+#include "parser_print.h"
+
+// SignDoc
+#define PB_SIGNDOC_BODY 1
+#define PB_SIGNDOC_AUTH_INFO 2
+#define PB_SIGNDOC_CHAIN_ID 3
+#define PB_SIGNDOC_ACCOUNT_NUMBER 4
+
+// TxBody
+#define PB_BODY_MESSAGES 1
+#define PB_BODY_MEMO 2
+#define PB_BODY_TIMEOUT_HEIGHT 3
+
+// google.protobuf.Any
+#define PB_ANY_TYPE_URL 1
+#define PB_ANY_VALUE 2
+
+// AuthInfo
+#define PB_AUTH_SIGNER_INFOS 1
+#define PB_AUTH_FEE 2
+
+// SignerInfo
+#define PB_SIGNER_PUBLIC_KEY 1
+#define PB_SIGNER_MODE_INFO 2
+#define PB_SIGNER_SEQUENCE 3
+
+// Fee
+#define PB_FEE_AMOUNT 1
+#define PB_FEE_GAS_LIMIT 2
+
+// Coin
+#define PB_COIN_DENOM 1
+#define PB_COIN_AMOUNT 2
+
+#define PB_MAX_MSG_FIELDS 4
+
+typedef enum {
+    pb_kind_string,
+    pb_kind_coin,
+    pb_kind_coins,
+} pb_field_kind_e;
+
+typedef struct {
+    uint8_t number;
+    pb_field_kind_e kind;
+    // Same path the amino JSON parser builds, so both share the labels in parser_print.c
+    const char *key;
+} pb_field_schema_t;
+
+typedef struct {
+    const char *type_url;
+    const char *amino_type;
+    uint8_t numFields;
+    // In amino JSON (sorted keys) order, so both encodings render the same screens
+    pb_field_schema_t fields[PB_MAX_MSG_FIELDS];
+} pb_msg_schema_t;
+
+static const pb_msg_schema_t msg_schemas[] = {
+    {"/cosmos.bank.v1beta1.MsgSend",
+     "cosmos-sdk/MsgSend",
+     3,
+     {{3, pb_kind_coins, "msgs/value/amount"},
+      {1, pb_kind_string, "msgs/value/from_address"},
+      {2, pb_kind_string, "msgs/value/to_address"}}},
+    {"/cosmos.staking.v1beta1.MsgDelegate",
+     "cosmos-sdk/MsgDelegate",
+     3,
+     {{3, pb_kind_coin, "msgs/value/amount"},
+      {1, pb_kind_string, "msgs/value/delegator_address"},
+      {2, pb_kind_string, "msgs/value/validator_address"}}},
+    {"/cosmos.staking.v1beta1.MsgUndelegate",
+     "cosmos-sdk/MsgUndelegate",
+     3,
+     {{3, pb_kind_coin, "msgs/value/amount"},
+      {1, pb_kind_string, "msgs/value/delegator_address"},
+      {2, pb_kind_string, "msgs/value/validator_address"}}},
+    {"/cosmos.staking.v1beta1.MsgBeginRedelegate",
+     "cosmos-sdk/MsgBeginRedelegate",
+     4,
+     {{4, pb_kind_coin, "msgs/value/amount"},
+      {1, pb_kind_string, "msgs/value/delegator_address"},
+      {3, pb_kind_string, "msgs/value/validator_dst_address"},
+      {2, pb_kind_string, "msgs/value/validator_src_address"}}},
+    {"/cosmos.distribution.v1beta1.MsgWithdrawDelegatorReward",
+     "cosmos-sdk/MsgWithdrawDelegationReward",
+     2,
+     {{1, pb_kind_string, "msgs/value/delegator_address"}, {2, pb_kind_string, "msgs/value/validator_address"}}},
+};
+
+typedef enum {
+    pb_item_chain_id,
+    pb_item_account_number,
+    pb_item_sequence,
+    pb_item_msg_type,
+    pb_item_msg_field,
+    pb_item_memo,
+    pb_item_fee,
+    pb_item_gas,
+} pb_item_e;
+
+typedef struct {
+    uint8_t target;
+    uint8_t count;
+    bool found;
+    pb_item_e kind;
+    uint8_t msgIdx;
+    uint8_t fieldIdx;
+} pb_item_walk_t;
+
+__Z_INLINE parser_error_t expect_wire(pb_wire_type_e wire, pb_wire_type_e expected) {
+    return wire == expected ? parser_ok : parser_unexpected_type;
+}
+
+// Singular fields may only appear once, later values would silently override what was shown
+__Z_INLINE parser_error_t mark_seen(uint32_t *seen, uint32_t field) {
+    if (field >= 32) {
+        return parser_unexpected_field;
+    }
+    if (*seen & (1u << field)) {
+        return parser_duplicated_field;
+    }
+    *seen |= (1u << field);
+    return parser_ok;
+}
+
+__Z_INLINE bool was_seen(uint32_t seen, uint32_t field) { return field < 32 && (seen & (1u << field)) != 0; }
+
+static parser_error_t check_printable(const uint8_t *buffer, pb_span_t span) {
+    for (uint16_t i = 0; i < span.len; i++) {
+        const uint8_t c = buffer[span.offset + i];
+        if (c < 0x20 || c > 0x7E) {
+            return parser_unexpected_characters;
+        }
+    }
+    return parser_ok;
+}
+
+static bool span_equals(const uint8_t *buffer, pb_span_t span, const char *expected) {
+    const size_t expectedLen = strlen(expected);
+    return span.len == expectedLen && memcmp(buffer + span.offset, expected, expectedLen) == 0;
+}
+
+static parser_error_t read_coin(const uint8_t *buffer, pb_span_t coin, pb_span_t *denom, pb_span_t *amount) {
+    pb_reader_t reader;
+    pb_reader_init(&reader, buffer, coin);
+    uint32_t seen = 0;
+
+    while (!pb_reader_done(&reader)) {
+        uint32_t field = 0;
+        pb_wire_type_e wire = pb_wire_varint;
+        CHECK_ERROR(pb_read_tag(&reader, &field, &wire))
+        switch (field) {
+            case PB_COIN_DENOM:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, denom))
+                break;
+            case PB_COIN_AMOUNT:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, amount))
+                break;
+            default:
+                return parser_unexpected_field;
+        }
+    }
+
+    if (!was_seen(seen, PB_COIN_DENOM) || !was_seen(seen, PB_COIN_AMOUNT) || denom->len == 0 || amount->len == 0) {
+        return parser_missing_field;
+    }
+    if (denom->len >= COIN_DENOM_MAXSIZE || amount->len >= COIN_AMOUNT_MAXSIZE) {
+        return parser_value_out_of_range;
+    }
+    CHECK_ERROR(check_printable(buffer, *denom))
+    for (uint16_t i = 0; i < amount->len; i++) {
+        const uint8_t c = buffer[amount->offset + i];
+        if (c < '0' || c > '9') {
+            return parser_unexpected_characters;
+        }
+    }
+    return parser_ok;
+}
+
+static parser_error_t read_msg_value(const uint8_t *buffer, const pb_msg_schema_t *schema, pb_span_t value) {
+    pb_reader_t reader;
+    pb_reader_init(&reader, buffer, value);
+    uint32_t seen = 0;
+
+    while (!pb_reader_done(&reader)) {
+        uint32_t field = 0;
+        pb_wire_type_e wire = pb_wire_varint;
+        CHECK_ERROR(pb_read_tag(&reader, &field, &wire))
+
+        const pb_field_schema_t *fieldSchema = NULL;
+        for (uint8_t i = 0; i < schema->numFields; i++) {
+            if (schema->fields[i].number == field) {
+                fieldSchema = &schema->fields[i];
+                break;
+            }
+        }
+        if (fieldSchema == NULL) {
+            return parser_unexpected_field;
+        }
+        CHECK_ERROR(expect_wire(wire, pb_wire_len))
+
+        pb_span_t span = {0};
+        CHECK_ERROR(pb_read_span(&reader, &span))
+        pb_span_t denom = {0};
+        pb_span_t amount = {0};
+        switch (fieldSchema->kind) {
+            case pb_kind_string:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(check_printable(buffer, span))
+                break;
+            case pb_kind_coin:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(read_coin(buffer, span, &denom, &amount))
+                break;
+            case pb_kind_coins:
+                CHECK_ERROR(read_coin(buffer, span, &denom, &amount))
+                break;
+            default:
+                return parser_unexpected_type;
+        }
+    }
+
+    // Repeated coins may be empty, everything else has to be there
+    for (uint8_t i = 0; i < schema->numFields; i++) {
+        if (schema->fields[i].kind != pb_kind_coins && !was_seen(seen, schema->fields[i].number)) {
+            return parser_missing_field;
+        }
+    }
+    return parser_ok;
+}
+
+static parser_error_t read_msg(const uint8_t *buffer, pb_span_t any, pb_msg_t *msg) {
+    pb_reader_t reader;
+    pb_reader_init(&reader, buffer, any);
+    uint32_t seen = 0;
+    pb_span_t typeUrl = {0};
+
+    while (!pb_reader_done(&reader)) {
+        uint32_t field = 0;
+        pb_wire_type_e wire = pb_wire_varint;
+        CHECK_ERROR(pb_read_tag(&reader, &field, &wire))
+        switch (field) {
+            case PB_ANY_TYPE_URL:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, &typeUrl))
+                break;
+            case PB_ANY_VALUE:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, &msg->value))
+                break;
+            default:
+                return parser_unexpected_field;
+        }
+    }
+
+    if (!was_seen(seen, PB_ANY_TYPE_URL)) {
+        return parser_missing_field;
+    }
+
+    for (uint8_t i = 0; i < array_length(msg_schemas); i++) {
+        if (span_equals(buffer, typeUrl, (const char *)PIC(msg_schemas[i].type_url))) {
+            msg->schema = i;
+            return read_msg_value(buffer, &msg_schemas[i], msg->value);
+        }
+    }
+    return parser_unsupported_tx;
+}
+
+static parser_error_t read_body(const uint8_t *buffer, pb_span_t body, pb_tx_t *pb_tx_obj) {
+    pb_reader_t reader;
+    pb_reader_init(&reader, buffer, body);
+    uint32_t seen = 0;
+    uint64_t timeoutHeight = 0;
+
+    while (!pb_reader_done(&reader)) {
+        uint32_t field = 0;
+        pb_wire_type_e wire = pb_wire_varint;
+        CHECK_ERROR(pb_read_tag(&reader, &field, &wire))
+        pb_span_t span = {0};
+        switch (field) {
+            case PB_BODY_MESSAGES:
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                if (pb_tx_obj->numMsgs >= PB_MAX_MSGS) {
+                    return parser_value_out_of_range;
+                }
+                CHECK_ERROR(pb_read_span(&reader, &span))
+                CHECK_ERROR(read_msg(buffer, span, &pb_tx_obj->msgs[pb_tx_obj->numMsgs]))
+                pb_tx_obj->numMsgs++;
+                break;
+            case PB_BODY_MEMO:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, &pb_tx_obj->memo))
+                CHECK_ERROR(check_printable(buffer, pb_tx_obj->memo))
+                break;
+            case PB_BODY_TIMEOUT_HEIGHT:
+                // Not shown on the device, so only the default is accepted
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_varint))
+                CHECK_ERROR(pb_read_varint(&reader, &timeoutHeight))
+                if (timeoutHeight != 0) {
+                    return parser_unexpected_value;
+                }
+                break;
+            default:
+                // Extension options (1023, 2047) included
+                return parser_unexpected_field;
+        }
+    }
+
+    if (pb_tx_obj->numMsgs == 0) {
+        return parser_missing_field;
+    }
+    return parser_ok;
+}
+
+static parser_error_t read_signer_info(const uint8_t *buffer, pb_span_t signerInfo, pb_tx_t *pb_tx_obj) {
+    pb_reader_t reader;
+    pb_reader_init(&reader, buffer, signerInfo);
+    uint32_t seen = 0;
+
+    while (!pb_reader_done(&reader)) {
+        uint32_t field = 0;
+        pb_wire_type_e wire = pb_wire_varint;
+        CHECK_ERROR(pb_read_tag(&reader, &field, &wire))
+        pb_span_t span = {0};
+        switch (field) {
+            case PB_SIGNER_PUBLIC_KEY:
+            case PB_SIGNER_MODE_INFO:
+                // The key is the one of the device and the mode is the one selected by the APDU
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, &span))
+                break;
+            case PB_SIGNER_SEQUENCE:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_varint))
+                CHECK_ERROR(pb_read_varint(&reader, &pb_tx_obj->sequence))
+                break;
+            default:
+                return parser_unexpected_field;
+        }
+    }
+    return parser_ok;
+}
+
+static parser_error_t read_fee(const uint8_t *buffer, pb_span_t fee, pb_tx_t *pb_tx_obj) {
+    pb_reader_t reader;
+    pb_reader_init(&reader, buffer, fee);
+    uint32_t seen = 0;
+
+    while (!pb_reader_done(&reader)) {
+        uint32_t field = 0;
+        pb_wire_type_e wire = pb_wire_varint;
+        CHECK_ERROR(pb_read_tag(&reader, &field, &wire))
+        pb_span_t span = {0};
+        pb_span_t denom = {0};
+        pb_span_t amount = {0};
+        switch (field) {
+            case PB_FEE_AMOUNT:
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, &span))
+                CHECK_ERROR(read_coin(buffer, span, &denom, &amount))
+                break;
+            case PB_FEE_GAS_LIMIT:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_varint))
+                CHECK_ERROR(pb_read_varint(&reader, &pb_tx_obj->gas_limit))
+                break;
+            default:
+                // Fee payer and granter are not shown, so they are refused
+                return parser_unexpected_field;
+        }
+    }
+
+    pb_tx_obj->fee = fee;
+    return parser_ok;
+}
+
+static parser_error_t read_auth_info(const uint8_t *buffer, pb_span_t authInfo, pb_tx_t *pb_tx_obj) {
+    pb_reader_t reader;
+    pb_reader_init(&reader, buffer, authInfo);
+    uint32_t seen = 0;
+
+    while (!pb_reader_done(&reader)) {
+        uint32_t field = 0;
+        pb_wire_type_e wire = pb_wire_varint;
+        CHECK_ERROR(pb_read_tag(&reader, &field, &wire))
+        pb_span_t span = {0};
+        switch (field) {
+            case PB_AUTH_SIGNER_INFOS:
+                if (was_seen(seen, field)) {
+                    return parser_unexpected_value;
+                }
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, &span))
+                CHECK_ERROR(read_signer_info(buffer, span, pb_tx_obj))
+                break;
+            case PB_AUTH_FEE:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, &span))
+                CHECK_ERROR(read_fee(buffer, span, pb_tx_obj))
+                break;
+            default:
+                // Tips included
+                return parser_unexpected_field;
+        }
+    }
+
+    if (!was_seen(seen, PB_AUTH_SIGNER_INFOS) || !was_seen(seen, PB_AUTH_FEE)) {
+        return parser_missing_field;
+    }
+    return parser_ok;
+}
+
+parser_error_t _readPb(parser_context_t *ctx, pb_tx_t *pb_tx_obj) {
+    if (ctx == NULL || ctx->buffer == NULL || pb_tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
+    MEMZERO(pb_tx_obj, sizeof(pb_tx_t));
+
+    const pb_span_t signDoc = {.offset = 0, .len = ctx->bufferLen};
+    pb_reader_t reader;
+    pb_reader_init(&reader, ctx->buffer, signDoc);
+    uint32_t seen = 0;
+    pb_span_t body = {0};
+    pb_span_t authInfo = {0};
+
+    while (!pb_reader_done(&reader)) {
+        uint32_t field = 0;
+        pb_wire_type_e wire = pb_wire_varint;
+        CHECK_ERROR(pb_read_tag(&reader, &field, &wire))
+        switch (field) {
+            case PB_SIGNDOC_BODY:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, &body))
+                break;
+            case PB_SIGNDOC_AUTH_INFO:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, &authInfo))
+                break;
+            case PB_SIGNDOC_CHAIN_ID:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_len))
+                CHECK_ERROR(pb_read_span(&reader, &pb_tx_obj->chain_id))
+                break;
+            case PB_SIGNDOC_ACCOUNT_NUMBER:
+                CHECK_ERROR(mark_seen(&seen, field))
+                CHECK_ERROR(expect_wire(wire, pb_wire_varint))
+                CHECK_ERROR(pb_read_varint(&reader, &pb_tx_obj->account_number))
+                break;
+            default:
+                return parser_unexpected_field;
+        }
+    }
+
+    if (!was_seen(seen, PB_SIGNDOC_BODY) || !was_seen(seen, PB_SIGNDOC_AUTH_INFO) || pb_tx_obj->chain_id.len == 0) {
+        return parser_missing_field;
+    }
+
+    CHECK_ERROR(check_printable(ctx->buffer, pb_tx_obj->chain_id))
+    if (pb_tx_obj->chain_id.len == 1 && (ctx->buffer[pb_tx_obj->chain_id.offset] == '0' ||
+                                         ctx->buffer[pb_tx_obj->chain_id.offset] == '1')) {
+        return parser_unexpected_chain;
+    }
+
+    CHECK_ERROR(read_body(ctx->buffer, body, pb_tx_obj))
+    CHECK_ERROR(read_auth_info(ctx->buffer, authInfo, pb_tx_obj))
+    return parser_ok;
+}
+
+static void item_emit(pb_item_walk_t *walk, pb_item_e kind, uint8_t msgIdx, uint8_t fieldIdx) {
+    if (!walk->found && walk->count == walk->target) {
+        walk->found = true;
+        walk->kind = kind;
+        walk->msgIdx = msgIdx;
+        walk->fieldIdx = fieldIdx;
+    }
+    walk->count++;
+}
+
+// Same order as the amino JSON review: chain, account, messages, memo, fee
+static void item_walk(const pb_tx_t *pb_tx_obj, pb_item_walk_t *walk) {
+    const bool expert = app_mode_expert();
+
+    item_emit(walk, pb_item_chain_id, 0, 0);
+    if (expert) {
+        item_emit(walk, pb_item_account_number, 0, 0);
+        item_emit(walk, pb_item_sequence, 0, 0);
+    }
+
+    for (uint8_t m = 0; m < pb_tx_obj->numMsgs; m++) {
+        item_emit(walk, pb_item_msg_type, m, 0);
+        const pb_msg_schema_t *schema = &msg_schemas[pb_tx_obj->msgs[m].schema];
+        for (uint8_t f = 0; f < schema->numFields; f++) {
+            item_emit(walk, pb_item_msg_field, m, f);
+        }
+    }
+
+    if (pb_tx_obj->memo.len > 0) {
+        item_emit(walk, pb_item_memo, 0, 0);
+    }
+
+    item_emit(walk, pb_item_fee, 0, 0);
+    if (expert) {
+        item_emit(walk, pb_item_gas, 0, 0);
+    }
+}
+
+parser_error_t _getNumItemsPb(const pb_tx_t *pb_tx_obj, uint8_t *numItems) {
+    if (pb_tx_obj == NULL || numItems == NULL) {
+        return parser_unexpected_error;
+    }
+    pb_item_walk_t walk = {.target = UINT8_MAX};
+    item_walk(pb_tx_obj, &walk);
+    *numItems = walk.count;
+    return parser_ok;
+}
+
+static parser_error_t find_field(const uint8_t *buffer, pb_span_t container, uint32_t number, pb_span_t *span) {
+    pb_reader_t reader;
+    pb_reader_init(&reader, buffer, container);
+    while (!pb_reader_done(&reader)) {
+        uint32_t field = 0;
+        pb_wire_type_e wire = pb_wire_varint;
+        CHECK_ERROR(pb_read_tag(&reader, &field, &wire))
+        if (wire == pb_wire_varint) {
+            uint64_t ignored = 0;
+            CHECK_ERROR(pb_read_varint(&reader, &ignored))
+            continue;
+        }
+        CHECK_ERROR(pb_read_span(&reader, span))
+        if (field == number) {
+            return parser_ok;
+        }
+    }
+    return parser_no_data;
+}
+
+static parser_error_t format_coin_span(const uint8_t *buffer, pb_span_t coin, char *outVal, uint16_t outValLen,
+                                       uint8_t pageIdx, uint8_t *pageCount) {
+    pb_span_t denom = {0};
+    pb_span_t amount = {0};
+    CHECK_ERROR(read_coin(buffer, coin, &denom, &amount))
+    return parser_formatCoin((const char *)buffer + amount.offset, amount.len, (const char *)buffer + denom.offset,
+                             denom.len, outVal, outValLen, pageIdx, pageCount);
+}
+
+// Pages through every coin in the repeated field, like parser_formatAmount does for a JSON array
+static parser_error_t format_coins(const uint8_t *buffer, pb_span_t container, uint32_t number, char *outVal,
+                                   uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    uint8_t totalPages = 0;
+    uint8_t showPageIdx = pageIdx;
+    bool showItemSet = false;
+    pb_span_t showCoin = {0};
+
+    pb_reader_t reader;
+    pb_reader_init(&reader, buffer, container);
+    while (!pb_reader_done(&reader)) {
+        uint32_t field = 0;
+        pb_wire_type_e wire = pb_wire_varint;
+        CHECK_ERROR(pb_read_tag(&reader, &field, &wire))
+        if (wire == pb_wire_varint) {
+            uint64_t ignored = 0;
+            CHECK_ERROR(pb_read_varint(&reader, &ignored))
+            continue;
+        }
+        pb_span_t coin = {0};
+        CHECK_ERROR(pb_read_span(&reader, &coin))
+        if (field != number) {
+            continue;
+        }
+
+        uint8_t subpagesCount = 0;
+        CHECK_ERROR(format_coin_span(buffer, coin, outVal, outValLen, 0, &subpagesCount))
+        totalPages += subpagesCount;
+        if (!showItemSet) {
+            if (showPageIdx < subpagesCount) {
+                showItemSet = true;
+                showCoin = coin;
+            } else {
+                showPageIdx -= subpagesCount;
+            }
+        }
+    }
+
+    if (totalPages == 0) {
+        *pageCount = 1;
+        snprintf(outVal, outValLen, "Empty");
+        return parser_ok;
+    }
+
+    *pageCount = totalPages;
+    if (!showItemSet) {
+        return parser_display_page_out_of_range;
+    }
+
+    uint8_t dummy = 0;
+    return format_coin_span(buffer, showCoin, outVal, outValLen, showPageIdx, &dummy);
+}
+
+static parser_error_t format_span(const uint8_t *buffer, pb_span_t span, char *outVal, uint16_t outValLen,
+                                  uint8_t pageIdx, uint8_t *pageCount) {
+    pageStringExt(outVal, outValLen, (const char *)buffer + span.offset, span.len, pageIdx, pageCount);
+    return parser_ok;
+}
+
+static parser_error_t format_u64(uint64_t value, char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    char buffer[21] = {0};
+    if (uint64_to_str(buffer, sizeof(buffer), value) != NULL) {
+        return parser_unexpected_value;
+    }
+    pageString(outVal, outValLen, buffer, pageIdx, pageCount);
+    return parser_ok;
+}
+
+static parser_error_t format_msg_field(const uint8_t *buffer, const pb_msg_t *msg, const pb_field_schema_t *field,
+                                       char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    pb_span_t span = {0};
+    switch (field->kind) {
+        case pb_kind_string:
+            CHECK_ERROR(find_field(buffer, msg->value, field->number, &span))
+            return format_span(buffer, span, outVal, outValLen, pageIdx, pageCount);
+        case pb_kind_coin:
+            CHECK_ERROR(find_field(buffer, msg->value, field->number, &span))
+            return format_coin_span(buffer, span, outVal, outValLen, pageIdx, pageCount);
+        case pb_kind_coins:
+            return format_coins(buffer, msg->value, field->number, outVal, outValLen, pageIdx, pageCount);
+        default:
+            return parser_unexpected_type;
+    }
+}
+
+parser_error_t _getItemPb(const parser_context_t *ctx, uint8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal,
+                          uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    if (ctx == NULL || ctx->pb_tx_obj == NULL || outKey == NULL || outVal == NULL || pageCount == NULL) {
+        return parser_unexpected_error;
+    }
+    const pb_tx_t *pb_tx_obj = ctx->pb_tx_obj;
+    const uint8_t *buffer = ctx->buffer;
+
+    pb_item_walk_t walk = {.target = displayIdx};
+    item_walk(pb_tx_obj, &walk);
+    if (!walk.found) {
+        return parser_display_idx_out_of_range;
+    }
+
+    const pb_msg_t *msg = &pb_tx_obj->msgs[walk.msgIdx];
+    const pb_msg_schema_t *schema = &msg_schemas[msg->schema];
+    parser_error_t err = parser_unexpected_type;
+    switch (walk.kind) {
+        case pb_item_chain_id:
+            snprintf(outKey, outKeyLen, "chain_id");
+            err = format_span(buffer, pb_tx_obj->chain_id, outVal, outValLen, pageIdx, pageCount);
+            break;
+        case pb_item_account_number:
+            snprintf(outKey, outKeyLen, "account_number");
+            err = format_u64(pb_tx_obj->account_number, outVal, outValLen, pageIdx, pageCount);
+            break;
+        case pb_item_sequence:
+            snprintf(outKey, outKeyLen, "sequence");
+            err = format_u64(pb_tx_obj->sequence, outVal, outValLen, pageIdx, pageCount);
+            break;
+        case pb_item_msg_type:
+            snprintf(outKey, outKeyLen, "msgs/type");
+            pageString(outVal, outValLen, (const char *)PIC(schema->amino_type), pageIdx, pageCount);
+            err = parser_ok;
+            break;
+        case pb_item_msg_field:
+            snprintf(outKey, outKeyLen, "%s", (const char *)PIC(schema->fields[walk.fieldIdx].key));
+            err = format_msg_field(buffer, msg, &schema->fields[walk.fieldIdx], outVal, outValLen, pageIdx, pageCount);
+            break;
+        case pb_item_memo:
+            snprintf(outKey, outKeyLen, "memo");
+            err = format_span(buffer, pb_tx_obj->memo, outVal, outValLen, pageIdx, pageCount);
+            break;
+        case pb_item_fee:
+            snprintf(outKey, outKeyLen, "fee/amount");
+            err = format_coins(buffer, pb_tx_obj->fee, PB_FEE_AMOUNT, outVal, outValLen, pageIdx, pageCount);
+            break;
+        case pb_item_gas:
+            snprintf(outKey, outKeyLen, "fee/gas");
+            err = format_u64(pb_tx_obj->gas_limit, outVal, outValLen, pageIdx, pageCount);
+            break;
+        default:
+            break;
+    }
+    CHECK_ERROR(err)
+
+    parser_friendly_key(outKey, outKeyLen);
+    return parser_ok;
+}
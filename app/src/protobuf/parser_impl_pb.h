@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "parser_common.h"
+#include "parser_impl.h"
+#include "pb_decoder.h"
+
+#define PB_MAX_MSGS 8
+
+typedef struct {
+    // Index in the table of supported messages
+    uint8_t schema;
+    // Encoded message (Any.value), its fields are decoded while rendering
+    pb_span_t value;
+} pb_msg_t;
+
+// cosmos.tx.v1beta1.SignDoc, with spans pointing into the transaction buffer
+typedef struct pb_tx_s {
+    pb_span_t chain_id;
+    uint64_t account_number;
+
+    // TxBody
+    uint8_t numMsgs;
+    pb_msg_t msgs[PB_MAX_MSGS];
+    pb_span_t memo;
+
+    // AuthInfo, only a single signer is supported
+    uint64_t sequence;
+    pb_span_t fee;
+    uint64_t gas_limit;
+} pb_tx_t;
+
+parser_error_t _readPb(parser_context_t *ctx, pb_tx_t *pb_tx_obj);
+
+parser_error_t _getItemPb(const parser_context_t *ctx, uint8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal,
+                          uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount);
+
+// returns the number of items to display on the screen.
+parser_error_t _getNumItemsPb(const pb_tx_t *pb_tx_obj, uint8_t *numItems);
+
+#ifdef __cplusplus
+}
+#endif
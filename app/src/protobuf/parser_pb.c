@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "parser_pb.h"
+
+#include <stdio.h>
+#include <zxformat.h>
+#include <zxmacros.h>
+#include <zxtypes.h>
+
+#include "app_mode.h"
+#include "parser.h"
+#include "parser_common.h"
+#include "scratch.h"
+
+parser_error_t parser_parse_pb(parser_context_t *ctx, const uint8_t *data, size_t dataLen, pb_tx_t *tx_obj) {
+    if (ctx == NULL || data == NULL || tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
+    if (dataLen > UINT16_MAX) {
+        return parser_unexpected_buffer_end;
+    }
+    CHECK_ERROR(parser_init_context(ctx, data, dataLen))
+    ctx->pb_tx_obj = tx_obj;
+    app_mode_skip_blindsign_ui();
+    return _readPb(ctx, tx_obj);
+}
+
+parser_error_t parser_validate_pb(const parser_context_t *ctx) {
+    if (ctx == NULL || ctx->pb_tx_obj == NULL) {
+        return parser_unexpected_error;
+    }
+
+    // Iterate through all items to check that all can be shown and are valid
+    uint8_t numItems = 0;
+    CHECK_ERROR(parser_getNumItemsPb(ctx, &numItems))
+
+    const scratch_mark_t mark = scratch_mark();
+    char *tmpKey = scratch_alloc(VALIDATE_KEY_SIZE);
+    char *tmpVal = scratch_alloc(VALIDATE_VALUE_SIZE);
+    parser_error_t err = tmpKey != NULL && tmpVal != NULL ? parser_ok : parser_unexpected_error;
+
+    for (uint8_t idx = 0; idx < numItems && err == parser_ok; idx++) {
+        uint8_t pageCount = 0;
+        err = parser_getItemPb(ctx, idx, tmpKey, VALIDATE_KEY_SIZE, tmpVal, VALIDATE_VALUE_SIZE, 0, &pageCount);
+    }
+    scratch_release(mark);
+    return err;
+}
+
+parser_error_t parser_getNumItemsPb(const parser_context_t *ctx, uint8_t *num_items) {
+    if (ctx == NULL || num_items == NULL) {
+        return parser_unexpected_error;
+    }
+    CHECK_ERROR(_getNumItemsPb(ctx->pb_tx_obj, num_items))
+    if (*num_items == 0) {
+        return parser_unexpected_number_items;
+    }
+    return parser_ok;
+}
+
+parser_error_t parser_getItemPb(const parser_context_t *ctx, uint8_t displayIdx, char *outKey, uint16_t outKeyLen,
+                                char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount) {
+    if (ctx == NULL || outKey == NULL || outVal == NULL || pageCount == NULL) {
+        return parser_unexpected_error;
+    }
+    *pageCount = 0;
+    MEMZERO(outKey, outKeyLen);
+    MEMZERO(outVal, outValLen);
+
+    uint8_t numItems = 0;
+    CHECK_ERROR(parser_getNumItemsPb(ctx, &numItems))
+    CHECK_APP_CANARY()
+
+    if (displayIdx >= numItems) {
+        return parser_display_idx_out_of_range;
+    }
+
+    return _getItemPb(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+}
@@ -0,0 +1,40 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "parser_impl.h"
+#include "parser_impl_pb.h"
+
+//// parses a protobuf SignDoc (SIGN_MODE_DIRECT) into tx_obj, which must outlive every later call made with ctx
+parser_error_t parser_parse_pb(parser_context_t *ctx, const uint8_t *data, size_t dataLen, pb_tx_t *tx_obj);
+
+//// verifies tx fields
+parser_error_t parser_validate_pb(const parser_context_t *ctx);
+
+//// returns the number of items in the current parsing context
+parser_error_t parser_getNumItemsPb(const parser_context_t *ctx, uint8_t *num_items);
+
+// retrieves a readable output for each field / page
+parser_error_t parser_getItemPb(const parser_context_t *ctx, uint8_t displayIdx, char *outKey, uint16_t outKeyLen,
+                                char *outVal, uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "pb_decoder.h"
+
+#include <stddef.h>
+#include <zxmacros.h>
+
+#define PB_VARINT_MAX_BYTES 10u
+#define PB_MAX_FIELD_NUMBER 0x1FFFFFFFu
+
+void pb_reader_init(pb_reader_t *reader, const uint8_t *buffer, pb_span_t span) {
+    if (reader == NULL) {
+        return;
+    }
+    reader->buffer = buffer;
+    reader->offset = span.offset;
+    reader->end = span.offset + span.len;
+}
+
+bool pb_reader_done(const pb_reader_t *reader) { return reader == NULL || reader->offset >= reader->end; }
+
+parser_error_t pb_read_varint(pb_reader_t *reader, uint64_t *value) {
+    if (reader == NULL || reader->buffer == NULL || value == NULL) {
+        return parser_unexpected_error;
+    }
+
+    uint64_t result = 0;
+    for (uint8_t i = 0; i < PB_VARINT_MAX_BYTES; i++) {
+        if (reader->offset >= reader->end) {
+            return parser_unexpected_buffer_end;
+        }
+        const uint8_t byte = reader->buffer[reader->offset++];
+        // The tenth byte only has room for the top bit of a 64 bit value
+        if (i == PB_VARINT_MAX_BYTES - 1 && byte > 1) {
+            return parser_value_out_of_range;
+        }
+        result |= (uint64_t)(byte & 0x7Fu) << (7u * i);
+        if ((byte & 0x80u) == 0) {
+            *value = result;
+            return parser_ok;
+        }
+    }
+    return parser_value_out_of_range;
+}
+
+parser_error_t pb_read_tag(pb_reader_t *reader, uint32_t *field, pb_wire_type_e *wire) {
+    if (field == NULL || wire == NULL) {
+        return parser_unexpected_error;
+    }
+
+    uint64_t key = 0;
+    CHECK_ERROR(pb_read_varint(reader, &key))
+
+    const uint64_t number = key >> 3u;
+    if (number == 0 || number > PB_MAX_FIELD_NUMBER) {
+        return parser_unexpected_field;
+    }
+
+    const uint8_t type = (uint8_t)(key & 0x07u);
+    if (type != pb_wire_varint && type != pb_wire_len) {
+        return parser_unexpected_type;
+    }
+
+    *field = (uint32_t)number;
+    *wire = (pb_wire_type_e)type;
+    return parser_ok;
+}
+
+parser_error_t pb_read_span(pb_reader_t *reader, pb_span_t *span) {
+    if (span == NULL) {
+        return parser_unexpected_error;
+    }
+
+    uint64_t len = 0;
+    CHECK_ERROR(pb_read_varint(reader, &len))
+    if (len > (uint64_t)(reader->end - reader->offset)) {
+        return parser_unexpected_buffer_end;
+    }
+
+    span->offset = reader->offset;
+    span->len = (uint16_t)len;
+    reader->offset += (uint16_t)len;
+    return parser_ok;
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Minimal protobuf wire format reader. Nothing is copied: length delimited
+// fields come back as spans into the buffer the reader was opened on, so a
+// decoded value stays valid for as long as that buffer does.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "parser_common.h"
+
+// Only the wire types used by the cosmos sign documents are supported
+typedef enum {
+    pb_wire_varint = 0,
+    pb_wire_len = 2,
+} pb_wire_type_e;
+
+// Bytes [offset, offset + len) of the buffer being decoded
+typedef struct {
+    uint16_t offset;
+    uint16_t len;
+} pb_span_t;
+
+typedef struct {
+    const uint8_t *buffer;
+    uint16_t offset;
+    uint16_t end;
+} pb_reader_t;
+
+// Reads the fields inside span. span must lie within buffer.
+void pb_reader_init(pb_reader_t *reader, const uint8_t *buffer, pb_span_t span);
+
+bool pb_reader_done(const pb_reader_t *reader);
+
+parser_error_t pb_read_varint(pb_reader_t *reader, uint64_t *value);
+
+// Reads a field key. Field number 0 and wire types other than varint and
+// length delimited are rejected.
+parser_error_t pb_read_tag(pb_reader_t *reader, uint32_t *field, pb_wire_type_e *wire);
+
+// Reads the length prefix of a length delimited value and returns its span
+parser_error_t pb_read_span(pb_reader_t *reader, pb_span_t *span);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "tx_pb.h"
+
+#include <string.h>
+
+#include "apdu_codes.h"
+#include "app_mode.h"
+#include "item_cache.h"
+#include "parser.h"
+#include "parser_pb.h"
+#include "scratch.h"
+#include "tx.h"
+#include "zxmacros.h"
+
+static parser_context_t ctx_parsed_tx;
+
+const char *tx_parse_pb() {
+    item_cache_reset();
+    scratch_reset();
+    pb_tx_t *pb_tx_obj = tx_state_acquire(tx_state_pb, sizeof(pb_tx_t));
+    if (pb_tx_obj == NULL) {
+        return parser_getErrorDescription(parser_unexpected_error);
+    }
+    uint8_t err = parser_parse_pb(&ctx_parsed_tx, tx_get_buffer(), tx_get_buffer_length(), pb_tx_obj);
+
+    CHECK_APP_CANARY()
+
+    if (err != parser_ok) {
+        return parser_getErrorDescription(err);
+    }
+
+    err = parser_validate_pb(&ctx_parsed_tx);
+    CHECK_APP_CANARY()
+
+    if (err != parser_ok) {
+        return parser_getErrorDescription(err);
+    }
+
+    return NULL;
+}
+
+zxerr_t tx_getNumItemsPb(uint8_t *num_items) {
+    if (!tx_state_check(tx_state_pb)) {
+        return zxerr_unknown;
+    }
+    parser_error_t err = parser_getNumItemsPb(&ctx_parsed_tx, num_items);
+
+    if (err != parser_ok) {
+        return zxerr_unknown;
+    }
+
+    return zxerr_ok;
+}
+
+zxerr_t tx_getItemPb(int8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal, uint16_t outValLen, uint8_t pageIdx,
+                     uint8_t *pageCount) {
+    uint8_t numItems = 0;
+
+    CHECK_ZXERR(tx_getNumItemsPb(&numItems))
+
+    if (displayIdx > numItems) {
+        return zxerr_no_data;
+    }
+
+    const bool expert = app_mode_expert();
+    if (displayIdx >= 0 &&
+        item_cache_lookup((uint16_t)displayIdx, expert, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount)) {
+        return zxerr_ok;
+    }
+
+    scratch_reset();
+    parser_error_t err =
+        parser_getItemPb(&ctx_parsed_tx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+
+    // Convert error codes
+    if (err == parser_no_data || err == parser_display_idx_out_of_range || err == parser_display_page_out_of_range)
+        return zxerr_no_data;
+
+    if (err != parser_ok) return zxerr_unknown;
+
+    if (displayIdx >= 0) {
+        item_cache_store((uint16_t)displayIdx, expert, outKey, outVal, outValLen, pageIdx, *pageCount);
+    }
+    return zxerr_ok;
+}
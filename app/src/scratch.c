@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "scratch.h"
+
+#include <zxmacros.h>
+
+// Host builds render items from several threads (see preview), each one gets its own arena
+#if defined(TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2) || defined(TARGET_STAX) || defined(TARGET_FLEX)
+#define SCRATCH_STORAGE static
+#else
+#define SCRATCH_STORAGE static _Thread_local
+#endif
+
+// Allocations are aligned so any buffer type can be placed in the arena
+#define SCRATCH_ALIGN 4u
+
+SCRATCH_STORAGE struct {
+    uint8_t buffer[SCRATCH_SIZE] __attribute__((aligned(SCRATCH_ALIGN)));
+    uint16_t used;
+    uint16_t peak;
+} scratch;
+
+void scratch_reset(void) {
+#if defined(APP_TESTING)
+    if (scratch.used != 0) {
+        // Something allocated during the last request and did not release it
+        zemu_log("scratch: not released\n");
+    }
+#endif
+    scratch.used = 0;
+}
+
+void *scratch_alloc(uint16_t size) {
+    const uint32_t start = ((uint32_t)scratch.used + SCRATCH_ALIGN - 1) & ~(SCRATCH_ALIGN - 1);
+    if (size == 0 || start + size > SCRATCH_SIZE) {
+#if defined(APP_TESTING)
+        zemu_log("scratch: out of space\n");
+#endif
+        return NULL;
+    }
+
+    scratch.used = (uint16_t)(start + size);
+    if (scratch.used > scratch.peak) {
+        scratch.peak = scratch.used;
+    }
+    MEMZERO(scratch.buffer + start, size);
+    return scratch.buffer + start;
+}
+
+scratch_mark_t scratch_mark(void) { return scratch.used; }
+
+void scratch_release(scratch_mark_t mark) {
+    if (mark < scratch.used) {
+        scratch.used = mark;
+    }
+}
+
+uint16_t scratch_used(void) { return scratch.used; }
+
+uint16_t scratch_peak(void) { return scratch.peak; }
@@ -0,0 +1,46 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// Bytes the formatting helpers share instead of declaring their own stack buffers
+#define SCRATCH_SIZE 512
+
+// Arena offset returned by scratch_mark, scratch_release frees everything allocated after it
+typedef uint16_t scratch_mark_t;
+
+// Frees the whole arena, done when a request to show an item starts
+void scratch_reset(void);
+
+// Returns size zeroed bytes, NULL when the arena has no room left for them. Callers report that as
+// parser_unexpected_error: parser_unexpected_buffer_end would read as a short input to the EVM precheck
+void *scratch_alloc(uint16_t size);
+
+scratch_mark_t scratch_mark(void);
+void scratch_release(scratch_mark_t mark);
+
+// Bytes in use now and the most that were in use at once since the arena was created
+uint16_t scratch_used(void);
+uint16_t scratch_peak(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "bench_corpus.h"
+
+#include <json/json.h>
+
+#include <fstream>
+#include <string>
+
+#include "hexutils.h"
+
+namespace {
+
+std::vector<uint8_t> from_hex(const std::string &hex) {
+    std::vector<uint8_t> out(hex.size() / 2);
+    const uint16_t len = parseHexString(out.data(), out.size(), hex.c_str());
+    out.resize(len);
+    return out;
+}
+
+Json::Value load_json(const std::string &file) {
+    Json::Value obj;
+    std::ifstream in(std::string(TESTVECTORS_DIR) + file);
+    if (in.is_open()) {
+        const Json::CharReaderBuilder builder;
+        JSONCPP_STRING errs;
+        Json::parseFromStream(builder, in, &obj, &errs);
+    }
+    return obj;
+}
+
+void load_vectors(std::vector<generated_tx_t> *cases) {
+    for (const auto &tc : load_json("testvectors/amino.json")) {
+        cases->push_back({"amino/" + tc["name"].asString(), from_hex(tc["blob"].asString()), false});
+    }
+    for (const auto &tc : load_json("testvectors/evm.json")) {
+        cases->push_back({"evm/" + tc["description"].asString(), from_hex(tc["encoded_tx_hex"].asString()), true});
+    }
+}
+
+void add_generated(std::vector<generated_tx_t> *cases) {
+    for (const unsigned msgs : {8u, 32u}) {
+        const std::string json = amino_send(msgs, "Transfer");
+        cases->push_back({"generated/amino_send_x" + std::to_string(msgs), {json.begin(), json.end()}, false});
+    }
+    const std::string longMemo = amino_send(1, std::string(256, 'm'));
+    cases->push_back({"generated/amino_long_memo", {longMemo.begin(), longMemo.end()}, false});
+
+    for (const size_t dataLen : {1024u, 8192u}) {
+        cases->push_back({"generated/evm_call_data_" + std::to_string(dataLen), evm_contract_call(dataLen), true});
+    }
+
+    for (auto &tc : worst_case_txs()) {
+        cases->push_back(std::move(tc));
+    }
+}
+
+}  // namespace
+
+std::vector<generated_tx_t> bench_corpus() {
+    std::vector<generated_tx_t> cases;
+    load_vectors(&cases);
+    add_generated(&cases);
+    return cases;
+}
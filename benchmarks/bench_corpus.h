@@ -0,0 +1,26 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// The transactions the benchmarks and the stack report run: every test vector
+// in tests/testvectors/{amino,evm}.json, a few generated large transactions
+// and the worst cases from tx_generator.h.
+
+#include <vector>
+
+#include "tx_generator.h"
+
+std::vector<generated_tx_t> bench_corpus();
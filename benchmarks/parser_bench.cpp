@@ -0,0 +1,186 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+// Parser pipeline benchmarks.
+//
+// Every transaction in bench_corpus() is timed per stage:
+//   parse     parser_parse / parser_parse_eth
+//   validate  parser_validate / parser_validate_eth on an already parsed tx
+//   num_items parser_getNumItems / parser_getNumItemsEth
+//   render    every page of every item, as dumpUI does in the ui tests
+//
+// Results are printed as JSON unless --benchmark_format is given.
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "app_mode.h"
+#include "bench_corpus.h"
+#include "parser.h"
+#include "parser_evm.h"
+
+namespace {
+
+// Same key/value sizes the ui tests page with
+constexpr uint16_t RENDER_KEY_LEN = 39;
+constexpr uint16_t RENDER_VALUE_LEN = 39;
+
+using bench_case_t = generated_tx_t;
+
+/////////////////////////////////////////////////////////////////////
+// Stages
+
+// Parsed state of the benchmark being run
+parser_tx_t txObj;
+eth_tx_t ethTxObj;
+
+parser_error_t parse(parser_context_t *ctx, const bench_case_t &tc) {
+    return tc.is_eth ? parser_parse_eth(ctx, tc.blob.data(), tc.blob.size(), &ethTxObj)
+                     : parser_parse(ctx, tc.blob.data(), tc.blob.size(), &txObj);
+}
+
+parser_error_t validate(parser_context_t *ctx, const bench_case_t &tc) {
+    return tc.is_eth ? parser_validate_eth(ctx) : parser_validate(ctx);
+}
+
+parser_error_t num_items(const parser_context_t *ctx, const bench_case_t &tc, uint16_t *numItems) {
+    if (!tc.is_eth) {
+        return parser_getNumItems(ctx, numItems);
+    }
+    uint8_t numItemsEth = 0;
+    const parser_error_t err = parser_getNumItemsEth(ctx, &numItemsEth);
+    *numItems = numItemsEth;
+    return err;
+}
+
+// Pages through every item like dumpUI; returns the number of pages rendered
+size_t render(const parser_context_t *ctx, const bench_case_t &tc) {
+    char key[RENDER_KEY_LEN + 1];
+    char value[RENDER_VALUE_LEN + 1];
+    uint16_t numItems = 0;
+    if (num_items(ctx, tc, &numItems) != parser_ok) {
+        return 0;
+    }
+
+    size_t pages = 0;
+    for (uint16_t idx = 0; idx < numItems; idx++) {
+        uint8_t pageCount = 1;
+        for (uint8_t pageIdx = 0; pageIdx < pageCount; pageIdx++) {
+            const parser_error_t err =
+                tc.is_eth
+                    ? parser_getItemEth(ctx, (uint8_t)idx, key, RENDER_KEY_LEN, value, RENDER_VALUE_LEN, pageIdx, &pageCount)
+                    : parser_getItem(ctx, idx, key, RENDER_KEY_LEN, value, RENDER_VALUE_LEN, pageIdx, &pageCount);
+            benchmark::DoNotOptimize(err);
+            benchmark::DoNotOptimize(value);
+            pages++;
+        }
+    }
+    return pages;
+}
+
+// Parses and validates, leaving the parsed state ready for the later stages
+bool prepare(parser_context_t *ctx, const bench_case_t &tc, benchmark::State &state) {
+    parser_error_t err = parse(ctx, tc);
+    if (err == parser_ok) {
+        err = validate(ctx, tc);
+    }
+    if (err != parser_ok) {
+        state.SkipWithError(parser_getErrorDescription(err));
+        return false;
+    }
+    return true;
+}
+
+void BM_Parse(benchmark::State &state, const bench_case_t &tc) {
+    parser_context_t ctx;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parse(&ctx, tc));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * tc.blob.size()));
+}
+
+void BM_Validate(benchmark::State &state, const bench_case_t &tc) {
+    parser_context_t ctx;
+    if (!prepare(&ctx, tc, state)) {
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validate(&ctx, tc));
+    }
+}
+
+void BM_NumItems(benchmark::State &state, const bench_case_t &tc) {
+    parser_context_t ctx;
+    if (!prepare(&ctx, tc, state)) {
+        return;
+    }
+    uint16_t numItems = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(num_items(&ctx, tc, &numItems));
+    }
+    state.counters["items"] = numItems;
+}
+
+void BM_Render(benchmark::State &state, const bench_case_t &tc) {
+    parser_context_t ctx;
+    if (!prepare(&ctx, tc, state)) {
+        return;
+    }
+    size_t pages = 0;
+    for (auto _ : state) {
+        pages = render(&ctx, tc);
+    }
+    state.counters["pages"] = static_cast<double>(pages);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    // Blind signing lets every EVM vector reach the later stages
+    app_mode_set_expert(0);
+    app_mode_set_blindsign(1);
+
+    static const std::vector<bench_case_t> cases = bench_corpus();
+
+    for (const auto &tc : cases) {
+        benchmark::RegisterBenchmark((tc.name + "/parse").c_str(), BM_Parse, tc);
+        benchmark::RegisterBenchmark((tc.name + "/validate").c_str(), BM_Validate, tc);
+        benchmark::RegisterBenchmark((tc.name + "/num_items").c_str(), BM_NumItems, tc);
+        benchmark::RegisterBenchmark((tc.name + "/render").c_str(), BM_Render, tc);
+    }
+
+    std::vector<char *> args(argv, argv + argc);
+    std::string jsonFormat = "--benchmark_format=json";
+    bool hasFormat = false;
+    for (int i = 1; i < argc; i++) {
+        hasFormat |= strncmp(argv[i], "--benchmark_format", strlen("--benchmark_format")) == 0;
+    }
+    if (!hasFormat) {
+        args.push_back(jsonFormat.data());
+    }
+    int newArgc = static_cast<int>(args.size());
+
+    benchmark::Initialize(&newArgc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(newArgc, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+
+# Plots the BM_TokenScaling / BM_MsgScaling results of a benchmarks run:
+#   ./build/benchmarks --benchmark_filter=Scaling --benchmark_out=scaling.json
+#   benchmarks/plot_scaling.py scaling.json
+# Without matplotlib the same series are printed as tables.
+
+import json
+import sys
+from collections import defaultdict
+
+# (benchmark family, counter used as x axis)
+FAMILIES = [
+    ('BM_TokenScaling', 'tokens'),
+    ('BM_MsgScaling', 'msgs'),
+]
+
+if len(sys.argv) < 2:
+    print(f'usage: {sys.argv[0]} <benchmark json> [output png]')
+    sys.exit(1)
+
+with open(sys.argv[1]) as f:
+    results = json.load(f)['benchmarks']
+
+# family -> stage -> [(x, time in ms)]
+series = defaultdict(lambda: defaultdict(list))
+for r in results:
+    if r.get('run_type', 'iteration') != 'iteration' or r.get('error_occurred'):
+        continue
+    for family, axis in FAMILIES:
+        if r['name'].startswith(family + '/'):
+            stage = r['name'].split('/')[1]
+            scale = {'ns': 1e-6, 'us': 1e-3, 'ms': 1.0, 's': 1e3}[r['time_unit']]
+            series[family][stage].append((r[axis], r['real_time'] * scale))
+
+try:
+    import matplotlib
+    matplotlib.use('Agg')
+    import matplotlib.pyplot as plt
+except ImportError:
+    plt = None
+
+if plt is None:
+    for family, axis in FAMILIES:
+        for stage, points in series[family].items():
+            print(f'{family}/{stage}')
+            print(f'  {axis:>8} {"ms":>10}')
+            for x, ms in sorted(points):
+                print(f'  {x:>8.0f} {ms:>10.3f}')
+    sys.exit(0)
+
+fig, axes = plt.subplots(1, len(FAMILIES), figsize=(6 * len(FAMILIES), 4))
+for ax, (family, axis) in zip(axes, FAMILIES):
+    for stage, points in series[family].items():
+        xs, ys = zip(*sorted(points))
+        ax.plot(xs, ys, marker='o', label=stage)
+    ax.set_title(family)
+    ax.set_xlabel(axis)
+    ax.set_ylabel('ms')
+    ax.legend()
+
+out = sys.argv[2] if len(sys.argv) > 2 else 'scaling.png'
+fig.tight_layout()
+fig.savefig(out)
+print(f'saved {out}')
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+// Throughput of the batch preview pool.
+//
+// A fixed batch of every amino and EVM test vector, repeated up to
+// PREVIEW_BATCH_SIZE requests, is rendered with 1 to 32 worker threads.
+// The tx_per_second counter shows how the pool scales with the core count.
+
+#include <benchmark/benchmark.h>
+#include <json/json.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "hexutils.h"
+#include "preview.h"
+
+namespace {
+
+constexpr size_t PREVIEW_BATCH_SIZE = 4096;
+
+struct preview_blob_t {
+    preview_kind_e kind;
+    std::vector<uint8_t> data;
+};
+
+std::vector<preview_blob_t> load_blobs() {
+    std::vector<preview_blob_t> blobs;
+    const struct {
+        const char *file;
+        const char *field;
+        preview_kind_e kind;
+    } sources[] = {
+        {"testvectors/amino.json", "blob", preview_kind_e::amino_json},
+        {"testvectors/evm.json", "encoded_tx_hex", preview_kind_e::evm_rlp},
+    };
+
+    for (const auto &source : sources) {
+        Json::Value obj;
+        std::ifstream in(std::string(TESTVECTORS_DIR) + source.file);
+        const Json::CharReaderBuilder builder;
+        JSONCPP_STRING errs;
+        if (!Json::parseFromStream(builder, in, &obj, &errs)) {
+            continue;
+        }
+        for (const auto &tc : obj) {
+            const std::string hex = tc[source.field].asString();
+            preview_blob_t blob{source.kind, std::vector<uint8_t>(hex.size() / 2)};
+            blob.data.resize(parseHexString(blob.data.data(), blob.data.size(), hex.c_str()));
+            blobs.push_back(std::move(blob));
+        }
+    }
+    return blobs;
+}
+
+void BM_PreviewBatch(benchmark::State &state) {
+    static const std::vector<preview_blob_t> blobs = load_blobs();
+    if (blobs.empty()) {
+        state.SkipWithError("no test vectors found");
+        return;
+    }
+
+    std::vector<preview_request_t> requests;
+    requests.reserve(PREVIEW_BATCH_SIZE);
+    for (size_t i = 0; i < PREVIEW_BATCH_SIZE; i++) {
+        const auto &blob = blobs[i % blobs.size()];
+        requests.push_back({blob.kind, blob.data.data(), blob.data.size()});
+    }
+
+    preview_options_t options;
+    options.blindsign = true;
+
+    preview_pool_t pool(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pool.run(requests, options));
+    }
+    state.counters["tx_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * requests.size()), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_PreviewBatch)->ArgName("threads")->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+// How the amino pipeline scales with the size of the sign doc.
+//
+// BM_TokenScaling grows a grouped withdraw transaction token by token up to
+// MAX_NUMBER_OF_TOKENS; BM_MsgScaling adds whole messages up to the largest
+// count that fits. Each stage is a separate family and every run reports the
+// tokens, msgs and items counters, so benchmarks/plot_scaling.py can plot time
+// against either axis.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "json_parser.h"
+#include "parser.h"
+#include "tx_generator.h"
+
+namespace {
+
+constexpr uint16_t RENDER_KEY_LEN = 39;
+constexpr uint16_t RENDER_VALUE_LEN = 39;
+
+enum class stage_e { parse, validate, render };
+
+parser_error_t parse(parser_context_t *ctx, parser_tx_t *txObj, const std::string &json) {
+    return parser_parse(ctx, reinterpret_cast<const uint8_t *>(json.data()), json.size(), txObj);
+}
+
+uint16_t render(const parser_context_t *ctx) {
+    char key[RENDER_KEY_LEN + 1];
+    char value[RENDER_VALUE_LEN + 1];
+    uint16_t numItems = 0;
+    if (parser_getNumItems(ctx, &numItems) != parser_ok) {
+        return 0;
+    }
+    for (uint16_t idx = 0; idx < numItems; idx++) {
+        uint8_t pageCount = 1;
+        for (uint8_t pageIdx = 0; pageIdx < pageCount; pageIdx++) {
+            benchmark::DoNotOptimize(
+                parser_getItem(ctx, idx, key, RENDER_KEY_LEN, value, RENDER_VALUE_LEN, pageIdx, &pageCount));
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    return numItems;
+}
+
+void run_stage(benchmark::State &state, const std::string &json, unsigned msgs, stage_e stage) {
+    if (json.empty()) {
+        state.SkipWithError("size below the transaction envelope");
+        return;
+    }
+
+    parser_context_t ctx;
+    static parser_tx_t txObj;
+    parser_error_t err = parse(&ctx, &txObj, json);
+    if (err == parser_ok) {
+        err = parser_validate(&ctx);
+    }
+    if (err != parser_ok) {
+        state.SkipWithError(parser_getErrorDescription(err));
+        return;
+    }
+
+    for (auto _ : state) {
+        switch (stage) {
+            case stage_e::parse:
+                benchmark::DoNotOptimize(parse(&ctx, &txObj, json));
+                break;
+            case stage_e::validate:
+                benchmark::DoNotOptimize(parser_validate(&ctx));
+                break;
+            case stage_e::render:
+                benchmark::DoNotOptimize(render(&ctx));
+                break;
+        }
+    }
+
+    uint16_t items = 0;
+    if (parser_getNumItems(&ctx, &items) != parser_ok) {
+        items = 0;
+    }
+    state.counters["tokens"] = txObj.json.numberOfTokens;
+    state.counters["msgs"] = msgs;
+    state.counters["items"] = items;
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+
+void BM_TokenScaling(benchmark::State &state, stage_e stage) {
+    const std::string json = amino_tokens(static_cast<uint16_t>(state.range(0)));
+    unsigned msgs = 0;
+    for (size_t pos = json.find(R"("type":)"); pos != std::string::npos; pos = json.find(R"("type":)", pos + 1)) {
+        msgs++;
+    }
+    run_stage(state, json, msgs, stage);
+}
+
+void BM_MsgScaling(benchmark::State &state, stage_e stage) {
+    const unsigned msgs = static_cast<unsigned>(state.range(0));
+    run_stage(state, amino_grouped(msgs), msgs, stage);
+}
+
+// Grouped withdraw messages take 9 tokens each, so 81 of them plus the envelope stay below MAX_NUMBER_OF_TOKENS
+#define TOKEN_RANGE DenseRange(64, MAX_NUMBER_OF_TOKENS, 64)->ArgName("tokens")
+#define MSG_RANGE DenseRange(1, 81, 8)->ArgName("msgs")
+
+BENCHMARK_CAPTURE(BM_TokenScaling, parse, stage_e::parse)->TOKEN_RANGE;
+BENCHMARK_CAPTURE(BM_TokenScaling, validate, stage_e::validate)->TOKEN_RANGE;
+BENCHMARK_CAPTURE(BM_TokenScaling, render, stage_e::render)->TOKEN_RANGE;
+
+BENCHMARK_CAPTURE(BM_MsgScaling, parse, stage_e::parse)->MSG_RANGE;
+BENCHMARK_CAPTURE(BM_MsgScaling, validate, stage_e::validate)->MSG_RANGE;
+BENCHMARK_CAPTURE(BM_MsgScaling, render, stage_e::render)->MSG_RANGE;
+
+}  // namespace
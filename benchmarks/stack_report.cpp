@@ -0,0 +1,212 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+// stack-report: peak stack use of the parser on the benchmark corpus.
+//
+// Every transaction in bench_corpus() is parsed, validated and rendered page
+// by page (amino in normal and expert mode, EVM with blind signing) with the
+// stack painted beforehand, so the peak covers the whole review. Built with
+// -DENABLE_STACK_USAGE=ON the app code is instrumented and the call path that
+// reached the deepest frame is printed too.
+//
+//   ./build/stack-report           table, deepest transactions first
+//   ./build/stack-report --json    input for benchmarks/stack_usage.py
+
+#include <dlfcn.h>
+#include <json/json.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "app_mode.h"
+#include "bench_corpus.h"
+#include "host_stack.h"
+#include "parser.h"
+#include "parser_evm.h"
+
+namespace {
+
+// Same key/value sizes the ui tests page with
+constexpr uint16_t RENDER_KEY_LEN = 39;
+constexpr uint16_t RENDER_VALUE_LEN = 39;
+
+struct stack_result_t {
+    std::string name;
+    bool expert;
+    parser_error_t err;
+    uint32_t peak;
+    host_stack_path_t path;
+};
+
+// Parsed state lives in globals, as on the device
+parser_tx_t txObj;
+eth_tx_t ethTxObj;
+
+__attribute__((noinline)) parser_error_t review(const generated_tx_t &tc) {
+    parser_context_t ctx;
+    if (tc.is_eth) {
+        CHECK_ERROR(parser_parse_eth(&ctx, tc.blob.data(), tc.blob.size(), &ethTxObj))
+        CHECK_ERROR(parser_validate_eth(&ctx))
+    } else {
+        CHECK_ERROR(parser_parse(&ctx, tc.blob.data(), tc.blob.size(), &txObj))
+        CHECK_ERROR(parser_validate(&ctx))
+    }
+
+    uint16_t numItems = 0;
+    uint8_t numItemsEth = 0;
+    CHECK_ERROR(tc.is_eth ? parser_getNumItemsEth(&ctx, &numItemsEth) : parser_getNumItems(&ctx, &numItems))
+    if (tc.is_eth) {
+        numItems = numItemsEth;
+    }
+
+    char key[RENDER_KEY_LEN + 1];
+    char value[RENDER_VALUE_LEN + 1];
+    for (uint16_t idx = 0; idx < numItems; idx++) {
+        uint8_t pageCount = 1;
+        for (uint8_t pageIdx = 0; pageIdx < pageCount; pageIdx++) {
+            CHECK_ERROR(tc.is_eth ? parser_getItemEth(&ctx, (uint8_t)idx, key, RENDER_KEY_LEN, value, RENDER_VALUE_LEN,
+                                                      pageIdx, &pageCount)
+                                  : parser_getItem(&ctx, idx, key, RENDER_KEY_LEN, value, RENDER_VALUE_LEN, pageIdx,
+                                                   &pageCount))
+        }
+    }
+    return parser_ok;
+}
+
+stack_result_t measure(const generated_tx_t &tc, bool expert) {
+    stack_result_t result = {tc.name, expert, parser_ok, 0, {}};
+    app_mode_set_expert(expert ? 1 : 0);
+
+    volatile uint8_t top_marker = 0;
+    host_stack_paint();
+    host_stack_trace_start(reinterpret_cast<uintptr_t>(&top_marker));
+    result.err = review(tc);
+    result.peak = host_stack_peak(reinterpret_cast<uintptr_t>(&top_marker));
+    result.path = *host_stack_trace_worst();
+    host_stack_trace_start(0);
+    return result;
+}
+
+// Exported symbols only; static functions are left to addr2line in stack_usage.py
+std::string symbol_name(const void *fn) {
+    Dl_info info = {};
+    if (dladdr(fn, &info) != 0 && info.dli_sname != nullptr && info.dli_saddr == fn) {
+        return info.dli_sname;
+    }
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%p", fn);
+    return buf;
+}
+
+Json::Value frame_json(const void *fn) {
+    Json::Value frame;
+    Dl_info info = {};
+    if (dladdr(fn, &info) != 0) {
+        frame["module"] = info.dli_fname;
+        frame["base"] = static_cast<Json::UInt64>(reinterpret_cast<uintptr_t>(info.dli_fbase));
+    }
+    frame["addr"] = static_cast<Json::UInt64>(reinterpret_cast<uintptr_t>(fn));
+    frame["symbol"] = symbol_name(fn);
+    return frame;
+}
+
+void print_json(const std::vector<stack_result_t> &results) {
+    Json::Value root;
+    Json::Value &cases = root["cases"];
+    cases = Json::arrayValue;
+    for (const auto &r : results) {
+        Json::Value tc;
+        tc["name"] = r.name;
+        tc["expert"] = r.expert;
+        tc["error"] = r.err == parser_ok ? "" : parser_getErrorDescription(r.err);
+        tc["peak"] = r.peak;
+        tc["traced_depth"] = r.path.depth;
+        cases.append(tc);
+    }
+
+    const stack_result_t &worst = results.front();
+    Json::Value &path = root["worst"];
+    path["name"] = worst.name;
+    path["expert"] = worst.expert;
+    path["peak"] = worst.peak;
+    path["traced_depth"] = worst.path.depth;
+    path["truncated"] = worst.path.truncated;
+    path["frames"] = Json::arrayValue;
+    for (uint8_t i = 0; i < worst.path.pathLen; i++) {
+        path["frames"].append(frame_json(worst.path.path[i]));
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+    std::cout << Json::writeString(builder, root) << std::endl;
+}
+
+void print_table(const std::vector<stack_result_t> &results) {
+    printf("%8s  %-6s  %s\n", "peak", "mode", "transaction");
+    for (const auto &r : results) {
+        printf("%8" PRIu32 "  %-6s  %s%s%s\n", r.peak, r.expert ? "expert" : "normal", r.name.c_str(),
+               r.err == parser_ok ? "" : "  error: ", r.err == parser_ok ? "" : parser_getErrorDescription(r.err));
+    }
+
+    const stack_result_t &worst = results.front();
+    if (worst.path.pathLen == 0) {
+        printf("\nNo call path recorded, configure with -DENABLE_STACK_USAGE=ON\n");
+        return;
+    }
+    printf("\nDeepest path: %s (%s), %" PRIu32 " bytes at the deepest entry%s\n", worst.name.c_str(),
+           worst.expert ? "expert" : "normal", worst.path.depth, worst.path.truncated ? ", truncated" : "");
+    for (uint8_t i = 0; i < worst.path.pathLen; i++) {
+        printf("  %*s%s\n", 2 * i, "", symbol_name(worst.path.path[i]).c_str());
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const bool json = argc > 1 && strcmp(argv[1], "--json") == 0;
+
+    // Blind signing lets every EVM vector reach the review
+    app_mode_set_blindsign(1);
+
+    const std::vector<generated_tx_t> corpus = bench_corpus();
+
+    // Unmeasured pass first: resolving libc symbols on first use runs the dynamic linker on the app's stack
+    for (const auto &tc : corpus) {
+        (void)measure(tc, true);
+    }
+
+    std::vector<stack_result_t> results;
+    for (const auto &tc : corpus) {
+        results.push_back(measure(tc, false));
+        if (!tc.is_eth) {
+            results.push_back(measure(tc, true));
+        }
+    }
+    std::stable_sort(results.begin(), results.end(),
+                     [](const stack_result_t &a, const stack_result_t &b) { return a.peak > b.peak; });
+
+    if (json) {
+        print_json(results);
+    } else {
+        print_table(results);
+    }
+    return 0;
+}
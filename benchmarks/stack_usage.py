@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""Stack usage report for a -DENABLE_STACK_USAGE=ON build.
+
+Combines the per-function frame sizes gcc/clang write with -fstack-usage (.su
+files) with the output of stack-report, which runs the benchmark corpus with
+the stack painted and the app code instrumented. Prints the largest frames,
+the transactions with the deepest stack and the call path behind the deepest
+one, each frame annotated with its size.
+
+Host frames are larger than on the device (64-bit pointers, different ABI and
+optimizer), so read the numbers as an upper bound for the ARM build. The same
+frame table can be produced for the device build by adding -fstack-usage to its
+CFLAGS and pointing --su-dir at its object directory.
+
+    benchmarks/stack_usage.py build
+    benchmarks/stack_usage.py build --budget 8192 --top 30
+"""
+
+import argparse
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+from collections import defaultdict
+
+SU_LOCATION = re.compile(r'^(?P<file>.*):(?P<line>\d+):(?P<col>\d+):(?P<function>.*)$')
+# gcc suffixes for cloned functions (foo.part.0, foo.constprop.0, foo.isra.0)
+CLONE_SUFFIX = re.compile(r'\.(part|constprop|isra|cold)\.\d+.*$')
+
+ET_DYN = 3
+
+# Host replacements for the SDK crypto; the device uses cx_* instead
+HOST_ONLY = os.path.join('app', 'src', 'host') + os.sep
+
+
+def base_name(function):
+    return CLONE_SUFFIX.sub('', function)
+
+
+def load_su(su_dir):
+    frames = []
+    for path in glob.glob(os.path.join(su_dir, '**', '*.su'), recursive=True):
+        with open(path) as f:
+            for line in f:
+                fields = line.rstrip('\n').split('\t')
+                match = SU_LOCATION.match(fields[0]) if len(fields) == 3 else None
+                if match is None:
+                    continue
+                frames.append({
+                    'file': match['file'],
+                    'line': int(match['line']),
+                    'function': match['function'],
+                    'bytes': int(fields[1]),
+                    'qualifier': fields[2],
+                })
+    return frames
+
+
+def relative(path, root):
+    try:
+        return os.path.relpath(path, root)
+    except ValueError:
+        return path
+
+
+def run_report(build_dir):
+    exe = os.path.join(build_dir, 'stack-report')
+    if not os.path.exists(exe):
+        sys.exit(f'{exe} not found, configure with -DENABLE_STACK_USAGE=ON and build stack-report')
+    return json.loads(subprocess.check_output([exe, '--json']))
+
+
+def elf_type(module):
+    with open(module, 'rb') as f:
+        header = f.read(18)
+    return int.from_bytes(header[16:18], 'little')
+
+
+def symbolize(frames):
+    """addr2line every frame, grouped per module. Returns (function, file, line) per frame."""
+    by_module = defaultdict(list)
+    for i, frame in enumerate(frames):
+        by_module[frame.get('module', '')].append(i)
+
+    resolved = [(frame.get('symbol', hex(frame['addr'])), '', 0) for frame in frames]
+    for module, indexes in by_module.items():
+        if not module or not os.path.exists(module):
+            continue
+        # Position independent executables are linked at 0
+        relocate = elf_type(module) == ET_DYN
+        addrs = [hex(frames[i]['addr'] - (frames[i]['base'] if relocate else 0)) for i in indexes]
+        try:
+            out = subprocess.check_output(['addr2line', '-f', '-e', module] + addrs, text=True).splitlines()
+        except (OSError, subprocess.CalledProcessError):
+            continue
+        for i, function, location in zip(indexes, out[0::2], out[1::2]):
+            file, _, line = location.rpartition(':')
+            line = line.split(' ')[0]
+            resolved[i] = (function, file, int(line) if line.isdigit() else 0)
+    return resolved
+
+
+def frame_size(su_index, function, file):
+    candidates = su_index.get(base_name(function), [])
+    for frame in candidates:
+        if file and os.path.basename(frame['file']) == os.path.basename(file):
+            return frame['bytes']
+    return max((frame['bytes'] for frame in candidates), default=None)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('build_dir', nargs='?', default='build')
+    parser.add_argument('--su-dir', help='directory searched for .su files (default: the build directory)')
+    parser.add_argument('--top', type=int, default=20, help='rows per table')
+    parser.add_argument('--budget', type=int, help='device stack size in bytes, to print the headroom')
+    parser.add_argument('--include-host', action='store_true', help='list frames of the host-only crypto too')
+    args = parser.parse_args()
+
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    su = load_su(args.su_dir or args.build_dir)
+    if not su:
+        sys.exit('no .su files found, configure with -DENABLE_STACK_USAGE=ON')
+    su_index = defaultdict(list)
+    for frame in su:
+        su_index[base_name(frame['function'])].append(frame)
+
+    print(f'Largest frames (-fstack-usage, {len(su)} functions)')
+    print(f'{"bytes":>7}  {"kind":<16} function')
+    listed = [f for f in su if args.include_host or HOST_ONLY not in f['file']]
+    listed = [f for f in listed if f['function'] != 'host_stack_paint']
+    for frame in sorted(listed, key=lambda f: -f['bytes'])[:args.top]:
+        where = f'{relative(frame["file"], root)}:{frame["line"]}'
+        print(f'{frame["bytes"]:>7}  {frame["qualifier"]:<16} {frame["function"]}  ({where})')
+
+    report = run_report(args.build_dir)
+    cases = report['cases']
+    print(f'\nDeepest transactions (painted peak, {len(cases)} runs)')
+    print(f'{"peak":>7}  {"traced":>7}  {"mode":<6} transaction')
+    for tc in cases[:args.top]:
+        error = f'  error: {tc["error"]}' if tc['error'] else ''
+        mode = 'expert' if tc['expert'] else 'normal'
+        print(f'{tc["peak"]:>7}  {tc["traced_depth"]:>7}  {mode:<6} {tc["name"]}{error}')
+
+    worst = report['worst']
+    frames = worst['frames']
+    print(f'\nWorst-case path: {worst["name"]} ({"expert" if worst["expert"] else "normal"})')
+    if not frames:
+        print('  no path recorded, the app code was not built with -finstrument-functions')
+    else:
+        total = 0
+        for depth, (function, file, line) in enumerate(symbolize(frames)):
+            size = frame_size(su_index, function, file)
+            total += size or 0
+            where = f'  ({relative(file, root)}:{line})' if file else ''
+            size_text = f'{size:>6}' if size is not None else '     ?'
+            print(f'{size_text} {total:>7}  {"  " * depth}{function}{where}')
+        if worst['truncated']:
+            print('  ... deeper frames not recorded')
+        print(f'\n  app frames on the path: {total} bytes (traced {worst["traced_depth"]} bytes)')
+        print(f'  painted peak:           {worst["peak"]} bytes, the rest is host libc and the harness')
+
+    if args.budget:
+        peak = max(tc['peak'] for tc in cases)
+        print(f'\nHeadroom against {args.budget} bytes: {args.budget - peak} bytes (peak {peak})')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,287 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include "tx_generator.h"
+
+#include <algorithm>
+
+#include "coin.h"
+#include "json_parser.h"
+#include "parser_impl.h"
+
+namespace {
+
+constexpr char DELEGATOR[] = "sei14ae4g3422thcyuxler2ws3w25fpesrh2uqmgm9";
+constexpr char RECIPIENT[] = "sei1cdvr6tns50wv03ek94ds6vnxh7pl3pmm9amstu";
+constexpr char VALIDATOR[] = "seivaloper1sq7x0r2mf3gvwr2l9amtlye0yd3c6dqa4th95v";
+
+// Tokens taken by the grouped withdraw message below
+constexpr uint16_t GROUPED_MSG_TOKENS = 9;
+
+std::string amino_doc(const std::string &chainId, const std::string &memo, const std::string &msgs) {
+    return R"({"account_number":"1227","chain_id":")" + chainId +
+           R"(","fee":{"amount":[{"amount":"10000","denom":"usei"}],"gas":"100000"},"memo":")" + memo +
+           R"(","msgs":[)" + msgs + R"(],"sequence":"183653"})";
+}
+
+std::string join_msgs(unsigned count, const std::string &msg) {
+    std::string msgs;
+    for (unsigned i = 0; i < count; i++) {
+        msgs += (i == 0 ? "" : ",") + msg;
+    }
+    return msgs;
+}
+
+std::string withdraw_msg(const std::string &extraFields) {
+    return R"({"type":"cosmos-sdk/MsgWithdrawDelegationReward","value":{"delegator_address":")" +
+           std::string(DELEGATOR) + R"(","validator_address":")" + VALIDATOR + "\"" + extraFields + "}}";
+}
+
+std::string send_msg(const std::string &amount) {
+    return R"({"type":"cosmos-sdk/MsgSend","value":{"amount":[)" + amount + R"(],"from_address":")" +
+           std::string(DELEGATOR) + R"(","to_address":")" + RECIPIENT + "\"}}";
+}
+
+// Largest n, starting at 1, for which fits(n) holds
+template <typename F>
+unsigned largest_fitting(F fits) {
+    unsigned n = 1;
+    while (fits(n + 1)) {
+        n++;
+    }
+    return n;
+}
+
+void rlp_append_length(std::vector<uint8_t> *out, size_t len, uint8_t shortBase, uint8_t longBase) {
+    if (len < 56) {
+        out->push_back(static_cast<uint8_t>(shortBase + len));
+        return;
+    }
+    std::vector<uint8_t> lenBytes;
+    for (size_t l = len; l > 0; l >>= 8) {
+        lenBytes.insert(lenBytes.begin(), static_cast<uint8_t>(l & 0xFF));
+    }
+    out->push_back(static_cast<uint8_t>(longBase + lenBytes.size()));
+    out->insert(out->end(), lenBytes.begin(), lenBytes.end());
+}
+
+void rlp_append_bytes(std::vector<uint8_t> *out, const std::vector<uint8_t> &bytes) {
+    if (bytes.size() == 1 && bytes[0] < 0x80) {
+        out->push_back(bytes[0]);
+        return;
+    }
+    rlp_append_length(out, bytes.size(), 0x80, 0xB7);
+    out->insert(out->end(), bytes.begin(), bytes.end());
+}
+
+void rlp_append_list(std::vector<uint8_t> *out, const std::vector<uint8_t> &payload) {
+    rlp_append_length(out, payload.size(), 0xC0, 0xF7);
+    out->insert(out->end(), payload.begin(), payload.end());
+}
+
+std::vector<uint8_t> pattern_bytes(size_t len, uint8_t seed) {
+    std::vector<uint8_t> bytes(len);
+    for (size_t i = 0; i < len; i++) {
+        bytes[i] = static_cast<uint8_t>(i * 31 + seed);
+    }
+    return bytes;
+}
+
+}  // namespace
+
+uint16_t json_token_count(const std::string &json) {
+    uint16_t count = 0;
+    bool inString = false;
+    bool inPrimitive = false;
+    for (const char c : json) {
+        if (inString) {
+            inString = c != '"';
+            continue;
+        }
+        const bool delimiter = c == ',' || c == ':' || c == ']' || c == '}';
+        if (inPrimitive) {
+            inPrimitive = !delimiter;
+            continue;
+        }
+        if (c == '"') {
+            inString = true;
+            count++;
+        } else if (c == '{' || c == '[') {
+            count++;
+        } else if (!delimiter) {
+            inPrimitive = true;
+            count++;
+        }
+    }
+    return count;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Amino JSON
+
+std::string amino_send(unsigned msgCount, const std::string &memo) {
+    const std::string coin = R"({"amount":"1000000","denom":"usei"})";
+    return amino_doc("atlantic-2", memo, join_msgs(msgCount, send_msg(coin)));
+}
+
+std::string amino_grouped(unsigned msgCount) {
+    return amino_doc(COIN_DEFAULT_CHAINID, "", join_msgs(msgCount, withdraw_msg("")));
+}
+
+std::string amino_tokens(uint16_t tokenCount) {
+    const uint16_t envelope = json_token_count(amino_doc(COIN_DEFAULT_CHAINID, "", ""));
+    if (tokenCount < envelope + GROUPED_MSG_TOKENS) {
+        return "";
+    }
+
+    // The remainder goes to an array field in the last message: its key and the
+    // array take two tokens and every element one more
+    unsigned msgCount = (tokenCount - envelope) / GROUPED_MSG_TOKENS;
+    unsigned remainder = (tokenCount - envelope) % GROUPED_MSG_TOKENS;
+    if (remainder == 1) {
+        if (msgCount == 1) {
+            return "";
+        }
+        msgCount--;
+        remainder += GROUPED_MSG_TOKENS;
+    }
+
+    std::string msgs = join_msgs(msgCount - 1, withdraw_msg(""));
+    std::string padding;
+    if (remainder > 0) {
+        padding = R"(,"z_padding":[)";
+        for (unsigned i = 0; i < remainder - 2; i++) {
+            padding += (i == 0 ? "" : ",") + std::string("\"p\"");
+        }
+        padding += "]";
+    }
+    msgs += (msgCount > 1 ? "," : "") + withdraw_msg(padding);
+    return amino_doc(COIN_DEFAULT_CHAINID, "", msgs);
+}
+
+std::string amino_nested(uint8_t depth) {
+    std::string value = R"("sei")";
+    for (uint8_t i = 0; i < depth; i++) {
+        value = R"({"msg":)" + value + "}";
+    }
+    const std::string msg = R"({"type":"wasm/MsgExecuteContract","value":)" + value + "}";
+
+    const unsigned msgCount = largest_fitting([&](unsigned n) {
+        return json_token_count(amino_doc(COIN_DEFAULT_CHAINID, "", join_msgs(n, msg))) <= MAX_NUMBER_OF_TOKENS;
+    });
+    return amino_doc(COIN_DEFAULT_CHAINID, "", join_msgs(msgCount, msg));
+}
+
+std::string amino_coins(unsigned coinCount) {
+    std::string amount;
+    for (unsigned i = 0; i < coinCount; i++) {
+        amount += (i == 0 ? "" : ",") + std::string(R"({"amount":")") + std::to_string(1000000 + i) +
+                  R"(","denom":"usei"})";
+    }
+    return amino_doc(COIN_DEFAULT_CHAINID, "", send_msg(amount));
+}
+
+std::string amino_memo(size_t txLen) {
+    const size_t envelope = amino_doc(COIN_DEFAULT_CHAINID, "", send_msg("")).size();
+    std::string memo;
+    for (size_t i = envelope; i < txLen; i++) {
+        memo += static_cast<char>('a' + i % 26);
+    }
+    return amino_doc(COIN_DEFAULT_CHAINID, memo, send_msg(""));
+}
+
+/////////////////////////////////////////////////////////////////////
+// EVM
+
+std::vector<uint8_t> evm_contract_call(size_t dataLen) {
+    std::vector<uint8_t> payload;
+    rlp_append_bytes(&payload, {0x01});                          // nonce
+    rlp_append_bytes(&payload, {0x6d, 0x6e, 0x2e, 0xdc, 0x00});  // gas price
+    rlp_append_bytes(&payload, {0x2d, 0xc6, 0xc0});              // gas limit
+    rlp_append_bytes(&payload, std::vector<uint8_t>(20, 0x62));  // to
+    rlp_append_bytes(&payload, {0x01});                          // value
+    rlp_append_bytes(&payload, pattern_bytes(dataLen, 7));       // data
+    rlp_append_bytes(&payload, {0x05, 0x31});                    // chain id
+    rlp_append_bytes(&payload, {});                              // r
+    rlp_append_bytes(&payload, {});                              // s
+
+    std::vector<uint8_t> tx;
+    rlp_append_list(&tx, payload);
+    return tx;
+}
+
+std::vector<uint8_t> evm_max_calldata(size_t txLen) {
+    // Length prefixes only grow with the data, so shrinking by the excess converges in a couple of steps
+    size_t dataLen = txLen;
+    std::vector<uint8_t> tx = evm_contract_call(dataLen);
+    while (tx.size() > txLen && dataLen > 0) {
+        dataLen -= std::min(dataLen, tx.size() - txLen);
+        tx = evm_contract_call(dataLen);
+    }
+    return tx;
+}
+
+std::vector<uint8_t> evm_access_list(unsigned addressCount, unsigned keysPerAddress) {
+    std::vector<uint8_t> accessList;
+    for (unsigned i = 0; i < addressCount; i++) {
+        std::vector<uint8_t> keys;
+        for (unsigned k = 0; k < keysPerAddress; k++) {
+            rlp_append_bytes(&keys, pattern_bytes(32, static_cast<uint8_t>(i + k)));
+        }
+        std::vector<uint8_t> entry;
+        rlp_append_bytes(&entry, pattern_bytes(20, static_cast<uint8_t>(i)));
+        rlp_append_list(&entry, keys);
+        rlp_append_list(&accessList, entry);
+    }
+
+    std::vector<uint8_t> payload;
+    rlp_append_bytes(&payload, {0x05, 0x31});                    // chain id
+    rlp_append_bytes(&payload, {0x01});                          // nonce
+    rlp_append_bytes(&payload, {0x3b, 0x9a, 0xca, 0x00});        // max priority fee per gas
+    rlp_append_bytes(&payload, {0x6d, 0x6e, 0x2e, 0xdc, 0x00});  // max fee per gas
+    rlp_append_bytes(&payload, {0x2d, 0xc6, 0xc0});              // gas limit
+    rlp_append_bytes(&payload, std::vector<uint8_t>(20, 0x62));  // to
+    rlp_append_bytes(&payload, {0x01});                          // value
+    rlp_append_bytes(&payload, {0xd0, 0xe3, 0x0d, 0xb0});        // data: deposit()
+    rlp_append_list(&payload, accessList);                       // access list
+
+    std::vector<uint8_t> tx = {0x02};
+    rlp_append_list(&tx, payload);
+    return tx;
+}
+
+/////////////////////////////////////////////////////////////////////
+
+std::vector<generated_tx_t> worst_case_txs() {
+    const auto json_case = [](const std::string &name, const std::string &json) {
+        return generated_tx_t{name, {json.begin(), json.end()}, false};
+    };
+    const auto fits_tokens = [](const std::string &json) { return json_token_count(json) <= MAX_NUMBER_OF_TOKENS; };
+
+    const unsigned maxMsgs = largest_fitting([&](unsigned n) { return fits_tokens(amino_grouped(n)); });
+    const unsigned maxCoins = largest_fitting([&](unsigned n) { return fits_tokens(amino_coins(n)); });
+    const unsigned maxAddresses =
+        largest_fitting([](unsigned n) { return evm_access_list(n, 2).size() <= WORST_CASE_TX_SIZE; });
+
+    return {
+        json_case("worst/amino_max_tokens", amino_tokens(MAX_NUMBER_OF_TOKENS)),
+        json_case("worst/amino_grouped_msgs", amino_grouped(maxMsgs)),
+        json_case("worst/amino_max_depth", amino_nested(MAX_RECURSION_DEPTH)),
+        json_case("worst/amino_long_coins", amino_coins(maxCoins)),
+        json_case("worst/amino_max_memo", amino_memo(WORST_CASE_TX_SIZE)),
+        {"worst/evm_max_calldata", evm_max_calldata(WORST_CASE_TX_SIZE), true},
+        {"worst/evm_max_access_list", evm_access_list(maxAddresses, 2), true},
+    };
+}
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Synthetic transactions for the benchmarks.
+//
+// Every generated transaction is valid: amino JSON is sorted and has no
+// whitespace, so it passes parser_validate, and EVM transactions are unsigned
+// RLP as the host wallets send them. The worst cases push one limit at a time
+// up to what the parser or the device tx buffer accepts.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Largest transaction the device can receive (flash buffer on Nano S+/X, Stax and Flex)
+#define WORST_CASE_TX_SIZE 16384u
+
+struct generated_tx_t {
+    std::string name;
+    std::vector<uint8_t> blob;
+    bool is_eth;
+};
+
+// Number of jsmn tokens in a generated JSON document (no escapes, no whitespace)
+uint16_t json_token_count(const std::string &json);
+
+/////////////////////////////////////////////////////////////////////
+// Amino JSON
+
+// msgCount identical MsgSend messages
+std::string amino_send(unsigned msgCount, const std::string &memo);
+
+// msgCount MsgWithdrawDelegationReward messages sharing type and delegator, so both are grouped
+std::string amino_grouped(unsigned msgCount);
+
+// Grouped messages padded to exactly tokenCount tokens, or empty if tokenCount is below the envelope
+std::string amino_tokens(uint16_t tokenCount);
+
+// As many messages as fit in MAX_NUMBER_OF_TOKENS, each value nested depth objects deep
+std::string amino_nested(uint8_t depth);
+
+// A single MsgSend with coinCount coins in its amount
+std::string amino_coins(unsigned coinCount);
+
+// A single MsgSend with the memo sized so the whole document is txLen bytes
+std::string amino_memo(size_t txLen);
+
+/////////////////////////////////////////////////////////////////////
+// EVM
+
+// Legacy EIP-155 contract call on Sei (chain id 1329) with dataLen bytes of calldata
+std::vector<uint8_t> evm_contract_call(size_t dataLen);
+
+// Legacy contract call with as much calldata as fits in txLen bytes
+std::vector<uint8_t> evm_max_calldata(size_t txLen);
+
+// EIP-1559 contract call with an access list of addressCount entries and keysPerAddress storage keys each
+std::vector<uint8_t> evm_access_list(unsigned addressCount, unsigned keysPerAddress);
+
+/////////////////////////////////////////////////////////////////////
+
+// One transaction per limit, each as large as the parser accepts
+std::vector<generated_tx_t> worst_case_txs();
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "app_mode.h"
+#include "sim.h"
+
+#ifdef NDEBUG
+#error "This fuzz target won't work correctly with NDEBUG defined, which will cause asserts to be eliminated"
+#endif
+
+// Sends the input as an EIP-191 personal message through the APDU simulator,
+// so chunking, eip191_msg_parse, every page of eip191_msg_getItem and, when
+// approved, the signature all run exactly as on the device.
+//
+// Input: flags | message length (4 bytes BE) | message
+//   flags bit 0: blind signing enabled
+//   flags bit 1: approve the review instead of rejecting it
+
+using std::size_t;
+
+namespace {
+
+constexpr uint8_t CLA_ETH = 0xE0;
+constexpr uint8_t INS_SIGN_PERSONAL_MESSAGE = 0x08;
+constexpr uint8_t P1_FIRST = 0x00;
+constexpr uint8_t P1_MORE = 0x80;
+constexpr size_t MAX_CHUNK = 255;
+
+// m/44'/60'/0'/0'/5, as in sim/scripts/eip191.apdu
+constexpr uint8_t PATH[] = {0x05, 0x80, 0x00, 0x00, 0x2c, 0x80, 0x00, 0x00, 0x3c, 0x80, 0x00,
+                            0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05};
+
+void check_page(void *, uint8_t, uint8_t pageIdx, uint8_t pageCount, const char *key, const char *value) {
+    assert(pageIdx < pageCount);
+    assert(strnlen(key, SIM_VIEW_KEY_LEN) < SIM_VIEW_KEY_LEN);
+    assert(strnlen(value, SIM_VIEW_VALUE_LEN) < SIM_VIEW_VALUE_LEN);
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerInitialize(int *, char ***) {
+    // Derives the test seed once
+    sim_init();
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size < 1) {
+        return 0;
+    }
+    const uint8_t flags = data[0];
+    const uint8_t *payload = data + 1;
+    const size_t payloadLen = size - 1;
+
+    sim_reset();
+    app_mode_set_blindsign(flags & 0x01);
+    sim_set_review_action((flags & 0x02) != 0 ? SIM_REVIEW_APPROVE : SIM_REVIEW_REJECT);
+    sim_set_page_callback(check_page, nullptr);
+
+    size_t offset = 0;
+    bool first = true;
+    do {
+        std::vector<uint8_t> command = {CLA_ETH, INS_SIGN_PERSONAL_MESSAGE, first ? P1_FIRST : P1_MORE, 0x00, 0x00};
+        if (first) {
+            command.insert(command.end(), PATH, PATH + sizeof(PATH));
+        }
+        const size_t chunkLen = std::min(MAX_CHUNK - (command.size() - 5), payloadLen - offset);
+        command.insert(command.end(), payload + offset, payload + offset + chunkLen);
+        command[4] = static_cast<uint8_t>(command.size() - 5);
+        offset += chunkLen;
+        first = false;
+
+        uint8_t response[260];
+        sim_stats_t stats;
+        const uint16_t responseLen =
+            sim_exchange(command.data(), static_cast<uint16_t>(command.size()), response, sizeof(response), &stats);
+        assert(responseLen >= 2);
+
+        // A message accepted for review must render completely
+        if (stats.review_error) {
+            (void)fprintf(stderr, "review failed to render\n");
+            assert(false);
+        }
+
+        // Stop at the first error status, the app has reset its state
+        const uint16_t sw = static_cast<uint16_t>((response[responseLen - 2] << 8) | response[responseLen - 1]);
+        if (sw != 0x9000 || stats.review_pages > 0) {
+            break;
+        }
+    } while (offset < payloadLen);
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+"""Seed the fuzzing corpora with the transactions in tests/testvectors."""
+
+import hashlib
+import json
+import os
+
+TESTVECTORS_DIR = os.path.join('tests', 'testvectors')
+CORPORA_DIR = os.path.join('fuzz', 'corpora')
+
+
+def load(name):
+    with open(os.path.join(TESTVECTORS_DIR, name)) as f:
+        return json.load(f)
+
+
+def write_seeds(fuzzer, blobs):
+    corpus_dir = os.path.join(CORPORA_DIR, fuzzer)
+    os.makedirs(corpus_dir, exist_ok=True)
+    for blob in blobs:
+        # libFuzzer names corpus entries by their SHA-1, so reruns don't duplicate seeds
+        path = os.path.join(corpus_dir, hashlib.sha1(blob).hexdigest())
+        with open(path, 'wb') as f:
+            f.write(blob)
+    print(f'{fuzzer}: {len(blobs)} seeds')
+
+
+def main():
+    amino = [bytes.fromhex(tc['blob']) for tc in load('amino.json')]
+    evm = [bytes.fromhex(tc['encoded_tx_hex']) for tc in load('evm.json') if tc['valid']]
+    # Typed transactions are the type byte followed by plain RLP
+    rlp = [tx[1:] if tx[0] <= 0x7f else tx for tx in evm]
+
+    write_seeds('parser_parse', amino)
+    write_seeds('parser_parse_eth', evm)
+    write_seeds('rlp_read', rlp)
+
+
+if __name__ == '__main__':
+    main()
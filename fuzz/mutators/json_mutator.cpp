@@ -0,0 +1,410 @@
+#include "json_mutator.h"
+
+#include <cctype>
+#include <cstring>
+#include <random>
+
+extern "C" size_t LLVMFuzzerMutate(uint8_t *data, size_t size, size_t maxSize);
+
+namespace {
+
+constexpr uint8_t MAX_PARSE_DEPTH = 32;
+constexpr unsigned MAX_MUTATIONS = 4;
+// Longest leaf handed to LLVMFuzzerMutate
+constexpr size_t MAX_LEAF_LEN = 512;
+
+const char *const NUMBERS[] = {
+    "0",
+    "1",
+    "999999",
+    "1000000",
+    "4294967296",
+    "18446744073709551615",
+    "18446744073709551616",
+    "340282366920938463463374607431768211455",
+    "115792089237316195423570985008687907853269984665640564039457584007913129639935",
+    "00000000000000000000000000000000000000000000000000000000000000000000000000000001",
+};
+
+const char *const STRINGS[] = {
+    "",
+    "usei",
+    "SEI",
+    "ibc/27394FB092D2ECCD56123C74F36E4C1F926001CEADA9CA97EA622B25F41E5EB2",
+    "cosmos-sdk/MsgSend",
+    "cosmos-sdk/MsgMultiSend",
+    "cosmos-sdk/MsgDelegate",
+    "cosmos-sdk/MsgWithdrawDelegationReward",
+    "wasm/MsgExecuteContract",
+    "sei14ae4g3422thcyuxler2ws3w25fpesrh2uqmgm9",
+};
+
+/////////////////////////////////////////////////////////////////////
+// Parsing
+
+struct json_reader_t {
+    const uint8_t *data;
+    size_t size;
+    size_t offset;
+};
+
+bool is_space(uint8_t c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+void skip_whitespace(json_reader_t *r) {
+    while (r->offset < r->size && is_space(r->data[r->offset])) {
+        r->offset++;
+    }
+}
+
+bool parse_string(json_reader_t *r, std::string *out) {
+    if (r->offset >= r->size || r->data[r->offset] != '"') {
+        return false;
+    }
+    const size_t start = ++r->offset;
+    while (r->offset < r->size && r->data[r->offset] != '"') {
+        // Escapes are kept verbatim, only the quote after a backslash must be skipped
+        r->offset += r->data[r->offset] == '\\' ? 2 : 1;
+    }
+    if (r->offset >= r->size) {
+        return false;
+    }
+    out->assign(reinterpret_cast<const char *>(r->data + start), r->offset - start);
+    r->offset++;
+    return true;
+}
+
+bool parse_value(json_reader_t *r, uint8_t depth, json_node_t *node) {
+    if (depth == 0) {
+        return false;
+    }
+    skip_whitespace(r);
+    if (r->offset >= r->size) {
+        return false;
+    }
+
+    const uint8_t c = r->data[r->offset];
+    if (c == '"') {
+        node->kind = json_node_t::STRING;
+        return parse_string(r, &node->text);
+    }
+
+    if (c == '{' || c == '[') {
+        const bool isObject = c == '{';
+        const uint8_t close = isObject ? '}' : ']';
+        node->kind = isObject ? json_node_t::OBJECT : json_node_t::ARRAY;
+        r->offset++;
+        skip_whitespace(r);
+        if (r->offset < r->size && r->data[r->offset] == close) {
+            r->offset++;
+            return true;
+        }
+        while (true) {
+            json_node_t child;
+            if (isObject) {
+                std::string key;
+                skip_whitespace(r);
+                if (!parse_string(r, &key)) {
+                    return false;
+                }
+                skip_whitespace(r);
+                if (r->offset >= r->size || r->data[r->offset++] != ':') {
+                    return false;
+                }
+                if (!parse_value(r, depth - 1, &child)) {
+                    return false;
+                }
+                node->members[key] = std::move(child);
+            } else {
+                if (!parse_value(r, depth - 1, &child)) {
+                    return false;
+                }
+                node->items.push_back(std::move(child));
+            }
+            skip_whitespace(r);
+            if (r->offset >= r->size) {
+                return false;
+            }
+            const uint8_t next = r->data[r->offset++];
+            if (next == close) {
+                return true;
+            }
+            if (next != ',') {
+                return false;
+            }
+        }
+    }
+
+    node->kind = json_node_t::PRIMITIVE;
+    const size_t start = r->offset;
+    while (r->offset < r->size && !is_space(r->data[r->offset]) && strchr(",]}:\"", r->data[r->offset]) == nullptr) {
+        r->offset++;
+    }
+    node->text.assign(reinterpret_cast<const char *>(r->data + start), r->offset - start);
+    return !node->text.empty();
+}
+
+void serialize(const json_node_t &node, std::string *out) {
+    switch (node.kind) {
+        case json_node_t::OBJECT: {
+            out->push_back('{');
+            bool first = true;
+            for (const auto &member : node.members) {
+                if (!first) {
+                    out->push_back(',');
+                }
+                first = false;
+                out->push_back('"');
+                out->append(member.first);
+                out->append("\":");
+                serialize(member.second, out);
+            }
+            out->push_back('}');
+            break;
+        }
+        case json_node_t::ARRAY: {
+            out->push_back('[');
+            for (size_t i = 0; i < node.items.size(); i++) {
+                if (i > 0) {
+                    out->push_back(',');
+                }
+                serialize(node.items[i], out);
+            }
+            out->push_back(']');
+            break;
+        }
+        case json_node_t::STRING:
+            out->push_back('"');
+            out->append(node.text);
+            out->push_back('"');
+            break;
+        case json_node_t::PRIMITIVE:
+            out->append(node.text);
+            break;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+// Mutations
+
+struct json_index_t {
+    std::vector<json_node_t *> nodes;
+    std::vector<json_node_t *> leaves;
+    std::vector<json_node_t *> arrays;
+    std::vector<json_node_t *> objects;
+    std::vector<std::string> keys;
+};
+
+void index_tree(json_node_t *node, json_index_t *index) {
+    index->nodes.push_back(node);
+    switch (node->kind) {
+        case json_node_t::OBJECT:
+            index->objects.push_back(node);
+            for (auto &member : node->members) {
+                index->keys.push_back(member.first);
+                index_tree(&member.second, index);
+            }
+            break;
+        case json_node_t::ARRAY:
+            index->arrays.push_back(node);
+            for (auto &item : node->items) {
+                index_tree(&item, index);
+            }
+            break;
+        default:
+            index->leaves.push_back(node);
+            break;
+    }
+}
+
+bool is_digits(const std::string &s) {
+    if (s.empty()) {
+        return false;
+    }
+    for (const char c : s) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Byte-level mutation of a leaf, keeping numbers numeric and strings printable without quotes or escapes
+void mutate_leaf_bytes(json_node_t *leaf) {
+    const bool numeric = is_digits(leaf->text);
+    std::vector<uint8_t> buf(leaf->text.begin(), leaf->text.end());
+    const size_t len = buf.size();
+    buf.resize(MAX_LEAF_LEN);
+    buf.resize(LLVMFuzzerMutate(buf.data(), len < MAX_LEAF_LEN ? len : MAX_LEAF_LEN, MAX_LEAF_LEN));
+
+    // Unquoted literals must stay a single token
+    const bool literal = leaf->kind == json_node_t::PRIMITIVE;
+    std::string text;
+    for (const uint8_t b : buf) {
+        bool keep = b >= 0x20 && b != '"' && b != '\\';
+        if (numeric) {
+            keep = b >= '0' && b <= '9';
+        } else if (literal) {
+            keep = isalnum(b) != 0;
+        }
+        if (keep) {
+            text.push_back(static_cast<char>(b));
+        }
+    }
+    if ((numeric || literal) && text.empty()) {
+        text = "0";
+    }
+    leaf->text = text;
+}
+
+template <typename T, size_t N>
+const T &pick(const T (&values)[N], std::minstd_rand *rng) {
+    return values[(*rng)() % N];
+}
+
+template <typename T>
+T &pick(std::vector<T> &values, std::minstd_rand *rng) {
+    return values[(*rng)() % values.size()];
+}
+
+// Applies one mutation. Returns false when the tree has nothing it applies to.
+bool mutate_once(json_node_t *root, std::minstd_rand *rng) {
+    json_index_t index;
+    index_tree(root, &index);
+
+    switch ((*rng)() % 8) {
+        case 0: {
+            // Leaf value: amounts, gas, addresses, memo
+            if (index.leaves.empty()) {
+                return false;
+            }
+            mutate_leaf_bytes(pick(index.leaves, rng));
+            return true;
+        }
+        case 1: {
+            // Leaf value from the dictionary
+            if (index.leaves.empty()) {
+                return false;
+            }
+            json_node_t *leaf = pick(index.leaves, rng);
+            if (leaf->kind == json_node_t::STRING && !is_digits(leaf->text) && ((*rng)() & 1) != 0) {
+                leaf->text = pick(STRINGS, rng);
+            } else {
+                leaf->text = pick(NUMBERS, rng);
+            }
+            return true;
+        }
+        case 2: {
+            // One more message, coin or input
+            if (index.arrays.empty()) {
+                return false;
+            }
+            json_node_t *array = pick(index.arrays, rng);
+            if (array->items.empty()) {
+                return false;
+            }
+            const json_node_t copy = pick(array->items, rng);
+            array->items.insert(array->items.begin() + (*rng)() % (array->items.size() + 1), copy);
+            return true;
+        }
+        case 3: {
+            // One less message, coin or input
+            if (index.arrays.empty()) {
+                return false;
+            }
+            json_node_t *array = pick(index.arrays, rng);
+            if (array->items.empty()) {
+                return false;
+            }
+            array->items.erase(array->items.begin() + (*rng)() % array->items.size());
+            return true;
+        }
+        case 4: {
+            // Replace a value by a copy of another subtree, possibly one of its ancestors
+            if (index.nodes.size() < 2) {
+                return false;
+            }
+            const json_node_t copy = *pick(index.nodes, rng);
+            json_node_t *target = index.nodes[1 + (*rng)() % (index.nodes.size() - 1)];
+            *target = copy;
+            return true;
+        }
+        case 5: {
+            // One more nesting level, as amino does with {"type":..,"value":..}
+            if (index.nodes.size() < 2) {
+                return false;
+            }
+            json_node_t *target = index.nodes[1 + (*rng)() % (index.nodes.size() - 1)];
+            json_node_t wrapper;
+            if (((*rng)() & 1) != 0) {
+                wrapper.kind = json_node_t::ARRAY;
+                wrapper.items.push_back(std::move(*target));
+            } else {
+                wrapper.kind = json_node_t::OBJECT;
+                wrapper.members["value"] = std::move(*target);
+            }
+            *target = std::move(wrapper);
+            return true;
+        }
+        case 6: {
+            // Drop a field
+            json_node_t *object = pick(index.objects, rng);
+            if (object->members.empty()) {
+                return false;
+            }
+            auto it = object->members.begin();
+            std::advance(it, (*rng)() % object->members.size());
+            object->members.erase(it);
+            return true;
+        }
+        default: {
+            // Add or overwrite a field using a key seen elsewhere in the document
+            if (index.keys.empty()) {
+                return false;
+            }
+            json_node_t *object = pick(index.objects, rng);
+            const std::string key = pick(index.keys, rng);
+            const json_node_t value = *pick(index.nodes, rng);
+            object->members[key] = value;
+            return true;
+        }
+    }
+}
+
+}  // namespace
+
+bool json_parse(const uint8_t *data, size_t size, json_node_t *root) {
+    json_reader_t reader = {data, size, 0};
+    if (!parse_value(&reader, MAX_PARSE_DEPTH, root)) {
+        return false;
+    }
+    skip_whitespace(&reader);
+    return reader.offset == reader.size;
+}
+
+std::string json_serialize(const json_node_t &node) {
+    std::string out;
+    serialize(node, &out);
+    return out;
+}
+
+size_t json_mutate(uint8_t *data, size_t size, size_t maxSize, unsigned int seed) {
+    std::minstd_rand rng(seed);
+
+    // Keep some plain byte mutations so the JSON and validation errors stay covered
+    json_node_t root;
+    if ((rng() % 8) == 0 || !json_parse(data, size, &root) || root.kind != json_node_t::OBJECT) {
+        return LLVMFuzzerMutate(data, size, maxSize);
+    }
+
+    const unsigned count = 1 + rng() % MAX_MUTATIONS;
+    for (unsigned i = 0; i < count; i++) {
+        (void)mutate_once(&root, &rng);
+    }
+
+    const std::string out = json_serialize(root);
+    if (out.size() > maxSize) {
+        return LLVMFuzzerMutate(data, size, maxSize);
+    }
+    memcpy(data, out.data(), out.size());
+    return out.size();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// Structure-aware mutator for amino JSON sign documents.
+//
+// The input is parsed into a tree, mutated structurally (values, array
+// lengths, nesting) and written back in canonical form: keys sorted and no
+// whitespace, so the result passes parser_json_validate and reaches the
+// display code instead of being rejected up front.
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+struct json_node_t {
+    enum kind_t { OBJECT, ARRAY, STRING, PRIMITIVE };
+
+    kind_t kind = PRIMITIVE;
+    // Raw text between the quotes for strings, the literal for primitives
+    std::string text;
+    // std::map keeps the keys sorted the way parser_json_validate expects
+    std::map<std::string, json_node_t> members;
+    std::vector<json_node_t> items;
+};
+
+// Parses a JSON document, whitespace allowed. Returns false on malformed input.
+bool json_parse(const uint8_t *data, size_t size, json_node_t *root);
+
+// Canonical form: sorted keys, no whitespace
+std::string json_serialize(const json_node_t &node);
+
+// LLVMFuzzerCustomMutator body. Falls back to LLVMFuzzerMutate when the input is not JSON.
+size_t json_mutate(uint8_t *data, size_t size, size_t maxSize, unsigned int seed);
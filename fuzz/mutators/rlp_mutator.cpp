@@ -0,0 +1,208 @@
+#include "rlp_mutator.h"
+
+#include <cstring>
+#include <random>
+
+extern "C" size_t LLVMFuzzerMutate(uint8_t *data, size_t size, size_t maxSize);
+
+namespace {
+
+constexpr uint8_t MAX_LIST_DEPTH = 16;
+constexpr unsigned MAX_MUTATIONS = 4;
+// Room given to LLVMFuzzerMutate to grow a payload
+constexpr size_t PAYLOAD_GROWTH = 64;
+
+// Prefixes from the Ethereum yellow paper, appendix B
+constexpr uint8_t STRING_SHORT = 0x80;
+constexpr uint8_t STRING_LONG = 0xB7;
+constexpr uint8_t LIST_SHORT = 0xC0;
+constexpr uint8_t LIST_LONG = 0xF7;
+// Highest first byte of an EIP-2718 transaction type
+constexpr uint8_t MAX_TX_TYPE = 0x7F;
+
+// ERC-20 transfer(address,uint256) selector
+constexpr uint8_t ERC20_TRANSFER[] = {0xA9, 0x05, 0x9C, 0xBB};
+
+std::vector<uint8_t> erc20_transfer_data(uint8_t fill) {
+    std::vector<uint8_t> data(ERC20_TRANSFER, ERC20_TRANSFER + sizeof(ERC20_TRANSFER));
+    data.resize(sizeof(ERC20_TRANSFER) + 64, fill);
+    return data;
+}
+
+// Values at the edges of what the field parsers accept
+std::vector<uint8_t> interesting_payload(std::minstd_rand *rng) {
+    switch ((*rng)() % 10) {
+        case 0:
+            return {};
+        case 1:
+            return {0x00};
+        case 2:
+            return {0x7F};
+        case 3:
+            return {0x80};
+        case 4:
+            // Sei mainnet and testnet chain ids
+            return ((*rng)() & 1) != 0 ? std::vector<uint8_t>{0x05, 0x31} : std::vector<uint8_t>{0x05, 0x30};
+        case 5:
+            // Non-canonical leading zero
+            return {0x00, 0x01};
+        case 6:
+            return std::vector<uint8_t>(20, 0xFF);
+        case 7:
+            return std::vector<uint8_t>(32, 0xFF);
+        case 8:
+            return std::vector<uint8_t>(33, 0x01);
+        default:
+            return erc20_transfer_data(((*rng)() & 1) != 0 ? 0x00 : 0xFF);
+    }
+}
+
+bool read_length(const uint8_t *data, size_t size, size_t *offset, uint8_t lenLen, uint64_t *len) {
+    if (lenLen > sizeof(uint64_t) || size - *offset < lenLen) {
+        return false;
+    }
+    *len = 0;
+    for (uint8_t i = 0; i < lenLen; i++) {
+        *len = (*len << 8) | data[(*offset)++];
+    }
+    return true;
+}
+
+bool decode(const uint8_t *data, size_t size, uint8_t depth, std::vector<rlp_node_t> *nodes) {
+    size_t offset = 0;
+    while (offset < size) {
+        const uint8_t prefix = data[offset++];
+        rlp_node_t node;
+        node.is_list = prefix >= LIST_SHORT;
+
+        uint64_t len = 0;
+        if (prefix < STRING_SHORT) {
+            node.payload.push_back(prefix);
+            nodes->push_back(std::move(node));
+            continue;
+        }
+        if (prefix <= STRING_LONG) {
+            len = prefix - STRING_SHORT;
+        } else if (prefix < LIST_SHORT) {
+            if (!read_length(data, size, &offset, prefix - STRING_LONG, &len)) {
+                return false;
+            }
+        } else if (prefix <= LIST_LONG) {
+            len = prefix - LIST_SHORT;
+        } else if (!read_length(data, size, &offset, prefix - LIST_LONG, &len)) {
+            return false;
+        }
+        if (len > size - offset) {
+            return false;
+        }
+
+        if (node.is_list) {
+            if (depth == 0 || !decode(data + offset, len, depth - 1, &node.children)) {
+                return false;
+            }
+        } else {
+            node.payload.assign(data + offset, data + offset + len);
+        }
+        offset += len;
+        nodes->push_back(std::move(node));
+    }
+    return true;
+}
+
+void append_length(std::vector<uint8_t> *out, uint64_t len, uint8_t shortBase, uint8_t longBase) {
+    if (len < 56) {
+        out->push_back(static_cast<uint8_t>(shortBase + len));
+        return;
+    }
+    std::vector<uint8_t> lenBytes;
+    for (uint64_t l = len; l > 0; l >>= 8) {
+        lenBytes.insert(lenBytes.begin(), static_cast<uint8_t>(l & 0xFF));
+    }
+    out->push_back(static_cast<uint8_t>(longBase + lenBytes.size()));
+    out->insert(out->end(), lenBytes.begin(), lenBytes.end());
+}
+
+void collect_strings(std::vector<rlp_node_t> *nodes, std::vector<rlp_node_t *> *strings) {
+    for (auto &node : *nodes) {
+        if (node.is_list) {
+            collect_strings(&node.children, strings);
+        } else {
+            strings->push_back(&node);
+        }
+    }
+}
+
+void mutate_payload(rlp_node_t *node, size_t maxSize) {
+    const size_t len = node->payload.size();
+    const size_t room = len + PAYLOAD_GROWTH < maxSize ? len + PAYLOAD_GROWTH : maxSize;
+    if (room == 0) {
+        return;
+    }
+    node->payload.resize(room);
+    node->payload.resize(LLVMFuzzerMutate(node->payload.data(), len < room ? len : room, room));
+}
+
+}  // namespace
+
+bool rlp_decode(const uint8_t *data, size_t size, std::vector<rlp_node_t> *nodes) {
+    return decode(data, size, MAX_LIST_DEPTH, nodes);
+}
+
+void rlp_encode(const std::vector<rlp_node_t> &nodes, std::vector<uint8_t> *out) {
+    for (const auto &node : nodes) {
+        if (node.is_list) {
+            std::vector<uint8_t> payload;
+            rlp_encode(node.children, &payload);
+            append_length(out, payload.size(), LIST_SHORT, LIST_LONG);
+            out->insert(out->end(), payload.begin(), payload.end());
+        } else if (node.payload.size() == 1 && node.payload[0] < STRING_SHORT) {
+            out->push_back(node.payload[0]);
+        } else {
+            append_length(out, node.payload.size(), STRING_SHORT, STRING_LONG);
+            out->insert(out->end(), node.payload.begin(), node.payload.end());
+        }
+    }
+}
+
+size_t rlp_mutate(uint8_t *data, size_t size, size_t maxSize, unsigned int seed) {
+    std::minstd_rand rng(seed);
+
+    // Typed transactions carry their type in front of the RLP list
+    const size_t typeLen = size > 0 && data[0] <= MAX_TX_TYPE ? 1 : 0;
+
+    // Keep some plain byte mutations so malformed envelopes stay covered
+    std::vector<rlp_node_t> nodes;
+    if ((rng() % 8) == 0 || !rlp_decode(data + typeLen, size - typeLen, &nodes)) {
+        return LLVMFuzzerMutate(data, size, maxSize);
+    }
+    std::vector<rlp_node_t *> strings;
+    collect_strings(&nodes, &strings);
+    if (strings.empty()) {
+        return LLVMFuzzerMutate(data, size, maxSize);
+    }
+
+    const unsigned count = 1 + rng() % MAX_MUTATIONS;
+    for (unsigned i = 0; i < count; i++) {
+        rlp_node_t *target = strings[rng() % strings.size()];
+        switch (rng() % 3) {
+            case 0:
+                mutate_payload(target, maxSize);
+                break;
+            case 1:
+                target->payload = interesting_payload(&rng);
+                break;
+            default:
+                // Values of one field in another: addresses as amounts, data as chain id
+                target->payload = strings[rng() % strings.size()]->payload;
+                break;
+        }
+    }
+
+    std::vector<uint8_t> out(data, data + typeLen);
+    rlp_encode(nodes, &out);
+    if (out.size() > maxSize) {
+        return LLVMFuzzerMutate(data, size, maxSize);
+    }
+    memcpy(data, out.data(), out.size());
+    return out.size();
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// Structure-aware mutator for EVM transactions.
+//
+// The input is an optional EIP-2718 type byte followed by an RLP stream. Only
+// string payloads are mutated; every list keeps its number of elements, so
+// the field layout of legacy, EIP-2930 and EIP-1559 transactions survives and
+// the mutated values reach the field parsers and the display code.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct rlp_node_t {
+    bool is_list;
+    std::vector<uint8_t> payload;
+    std::vector<rlp_node_t> children;
+};
+
+// Decodes a whole RLP stream, accepting non-canonical lengths. Returns false on malformed input.
+bool rlp_decode(const uint8_t *data, size_t size, std::vector<rlp_node_t> *nodes);
+
+// Canonical encoding of a stream of nodes, appended to out
+void rlp_encode(const std::vector<rlp_node_t> &nodes, std::vector<uint8_t> *out);
+
+// LLVMFuzzerCustomMutator body. Falls back to LLVMFuzzerMutate when the input is not RLP.
+size_t rlp_mutate(uint8_t *data, size_t size, size_t maxSize, unsigned int seed);
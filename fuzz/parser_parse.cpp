@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <cstdio>
 
+#include "json_mutator.h"
 #include "parser.h"
 #include "zxformat.h"
 
@@ -16,6 +17,11 @@ char PARSER_KEY[16384];
 char PARSER_VALUE[16384];
 }  // namespace
 
+// Keeps amino JSON sorted and whitespace free so mutations reach the display code
+extern "C" size_t LLVMFuzzerCustomMutator(uint8_t *data, size_t size, size_t maxSize, unsigned int seed) {
+    return json_mutate(data, size, maxSize, seed);
+}
+
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     parser_tx_t txObj;
     MEMZERO(&txObj, sizeof(txObj));
@@ -32,7 +38,7 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
         return 0;
     }
 
-    uint8_t num_items;
+    uint16_t num_items;
     rc = parser_getNumItems(&ctx, &num_items);
     if (rc != parser_ok) {
         fprintf(stderr, "error in parser_getNumItems: %s\n", parser_getErrorDescription(rc));
@@ -41,7 +47,7 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
 
     (void)fprintf(stderr, "----------------------------------------------\n");
 
-    for (uint8_t i = 0; i < num_items; i += 1) {
+    for (uint16_t i = 0; i < num_items; i += 1) {
         uint8_t page_idx = 0;
         uint8_t page_count = 1;
         while (page_idx < page_count) {
@@ -0,0 +1,91 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+
+#include "app_mode.h"
+#include "parser_evm.h"
+#include "rlp_mutator.h"
+#include "zxformat.h"
+
+#ifdef NDEBUG
+#error "This fuzz target won't work correctly with NDEBUG defined, which will cause asserts to be eliminated"
+#endif
+
+using std::size_t;
+
+namespace {
+char PARSER_KEY[16384];
+char PARSER_VALUE[16384];
+}  // namespace
+
+extern "C" int LLVMFuzzerInitialize(int *, char ***) {
+    // Without blind signing every contract call stops at validation
+    app_mode_set_blindsign(1);
+    return 0;
+}
+
+// Keeps the RLP field layout so mutations reach the field parsers and the display code
+extern "C" size_t LLVMFuzzerCustomMutator(uint8_t *data, size_t size, size_t maxSize, unsigned int seed) {
+    return rlp_mutate(data, size, maxSize, seed);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    eth_tx_t ethTxObj;
+    MEMZERO(&ethTxObj, sizeof(ethTxObj));
+    parser_context_t ctx;
+    parser_error_t rc;
+
+    rc = parser_parse_eth(&ctx, data, size, &ethTxObj);
+    if (rc != parser_ok) {
+        return 0;
+    }
+
+    // What is refused while chunks arrive must also be refused by the full parse
+    for (size_t len = 0; len <= size; len++) {
+        rc = parser_precheck_eth(data, len);
+        if (rc != parser_ok) {
+            fprintf(stderr, "prefix %zu rejected: %s\n", len, parser_getErrorDescription(rc));
+            assert(false);
+        }
+    }
+
+    rc = parser_validate_eth(&ctx);
+    if (rc != parser_ok) {
+        return 0;
+    }
+
+    uint8_t v = 0;
+    for (unsigned int info = 0; info < 2; info++) {
+        rc = parser_compute_eth_v(&ctx, info, &v, false);
+        if (rc != parser_ok) {
+            fprintf(stderr, "error in parser_compute_eth_v: %s\n", parser_getErrorDescription(rc));
+            assert(false);
+        }
+    }
+
+    uint8_t num_items;
+    rc = parser_getNumItemsEth(&ctx, &num_items);
+    if (rc != parser_ok) {
+        fprintf(stderr, "error in parser_getNumItemsEth: %s\n", parser_getErrorDescription(rc));
+        assert(false);
+    }
+
+    for (uint8_t i = 0; i < num_items; i += 1) {
+        uint8_t page_idx = 0;
+        uint8_t page_count = 1;
+        while (page_idx < page_count) {
+            rc = parser_getItemEth(&ctx, i, PARSER_KEY, sizeof(PARSER_KEY), PARSER_VALUE, sizeof(PARSER_VALUE),
+                                   page_idx, &page_count);
+
+            if (rc != parser_ok) {
+                (void)fprintf(stderr, "error getting item %u at page index %u: %s\n", (unsigned)i, (unsigned)page_idx,
+                              parser_getErrorDescription(rc));
+                assert(false);
+            }
+
+            page_idx += 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "rlp.h"
+#include "rlp_mutator.h"
+
+#ifdef NDEBUG
+#error "This fuzz target won't work correctly with NDEBUG defined, which will cause asserts to be eliminated"
+#endif
+
+// Decodes the input as an RLP stream, nested lists included, re-encodes what
+// was decoded in canonical form and checks the re-encoding decodes to the same
+// tree and matches the decoder in mutators/rlp_mutator.cpp. Every string is
+// also read back through rlp_readUInt256.
+
+using std::size_t;
+
+namespace {
+
+constexpr uint8_t MAX_LIST_DEPTH = 16;
+
+bool same_tree(const std::vector<rlp_node_t> &a, const std::vector<rlp_node_t> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].is_list != b[i].is_list || a[i].payload != b[i].payload || !same_tree(a[i].children, b[i].children)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void check_uint256(const rlp_t *item) {
+    uint256_t value;
+    const parser_error_t rc = rlp_readUInt256(item, &value);
+    if (item->rlpLen > 32) {
+        assert(rc == parser_value_out_of_range);
+        return;
+    }
+    assert(rc == parser_ok);
+
+    uint8_t expected[32] = {0};
+    memcpy(expected + sizeof(expected) - item->rlpLen, item->ptr, item->rlpLen);
+    const uint64_t limbs[4] = {UPPER(UPPER(value)), LOWER(UPPER(value)), UPPER(LOWER(value)), LOWER(LOWER(value))};
+    for (size_t i = 0; i < sizeof(expected); i++) {
+        assert(expected[i] == static_cast<uint8_t>(limbs[i / 8] >> (56 - 8 * (i % 8))));
+    }
+}
+
+bool decode(const uint8_t *data, size_t size, uint8_t depth, std::vector<rlp_node_t> *nodes) {
+    parser_context_t ctx = {};
+    ctx.buffer = data;
+    ctx.bufferLen = static_cast<uint16_t>(size);
+
+    while (ctx.offset < ctx.bufferLen) {
+        const uint16_t start = ctx.offset;
+        rlp_t item = {};
+        if (rlp_read(&ctx, &item) != parser_ok) {
+            return false;
+        }
+
+        // The decoded value lies within the bytes just consumed
+        assert(ctx.offset > start && ctx.offset <= ctx.bufferLen);
+        assert(item.ptr >= data + start && item.ptr + item.rlpLen <= data + ctx.offset);
+
+        rlp_node_t node;
+        node.is_list = item.kind == RLP_KIND_LIST;
+        if (node.is_list) {
+            if (depth == 0 || !decode(item.ptr, item.rlpLen, depth - 1, &node.children)) {
+                return false;
+            }
+        } else {
+            assert(item.kind != RLP_KIND_BYTE || item.rlpLen == 1);
+            node.payload.assign(item.ptr, item.ptr + item.rlpLen);
+            check_uint256(&item);
+        }
+        nodes->push_back(std::move(node));
+    }
+    return true;
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size > UINT16_MAX) {
+        return 0;
+    }
+
+    std::vector<rlp_node_t> decoded;
+    if (!decode(data, size, MAX_LIST_DEPTH, &decoded)) {
+        return 0;
+    }
+
+    // An independent decoder agrees on everything rlp_read accepts
+    std::vector<rlp_node_t> reference;
+    if (!rlp_decode(data, size, &reference) || !same_tree(decoded, reference)) {
+        (void)fprintf(stderr, "rlp_read disagrees with the reference decoder\n");
+        assert(false);
+    }
+
+    std::vector<uint8_t> encoded;
+    rlp_encode(decoded, &encoded);
+
+    // Canonical encodings are never longer than what was accepted
+    assert(encoded.size() <= size);
+    if (size > 0 && encoded.size() == size) {
+        assert(memcmp(encoded.data(), data, size) == 0);
+    }
+
+    std::vector<rlp_node_t> redecoded;
+    const bool ok = decode(encoded.data(), encoded.size(), MAX_LIST_DEPTH, &redecoded);
+    if (!ok || !same_tree(decoded, redecoded)) {
+        (void)fprintf(stderr, "re-encoded stream does not decode to the same values\n");
+        assert(false);
+    }
+
+    return 0;
+}
@@ -11,6 +11,10 @@ MUTATE_DEPTH = random.randint(1, 20)
 # (fuzzer name, max length, max time scale factor)
 CONFIGS = [
     ('parser_parse', 17000, 4),
+    ('parser_parse_eth', 17000, 2),
+    ('rlp_read', 17000, 1),
+    ('uint256', 66, 1),
+    ('eip191', 17000, 1),
 ]
 
 for config in CONFIGS:
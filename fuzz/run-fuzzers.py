@@ -11,8 +11,16 @@ MUTATE_DEPTH = random.randint(1, 20)
 # (fuzzer name, max length, max time scale factor)
 CONFIGS = [
     ('parser_parse', 17000, 4),
+    ('parser_parse_eth', 17000, 2),
+    ('parser_parse_pb', 17000, 2),
+    ('rlp_read', 17000, 1),
+    ('uint256', 66, 1),
+    ('eip191', 17000, 1),
 ]
 
+# Start every corpus from the test vectors
+subprocess.check_call(['python3', os.path.join('fuzz', 'generate-seeds.py')])
+
 for config in CONFIGS:
     fuzzer, max_len, scale_factor = config
     max_time = MAX_SECONDS_PER_RUN * scale_factor
@@ -0,0 +1,222 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "uint256.h"
+
+#ifdef NDEBUG
+#error "This fuzz target won't work correctly with NDEBUG defined, which will cause asserts to be eliminated"
+#endif
+
+// Differential target for uint256.c. mul256, divmod256 and tostring256 are
+// checked against a plain 32-bit limb reference, and their 128-bit versions
+// against unsigned __int128.
+//
+// Input: a (32 bytes BE) | b (32 bytes BE) | base | output length, zero padded.
+
+using std::size_t;
+
+namespace {
+
+constexpr size_t INPUT_SIZE = 32 + 32 + 2;
+constexpr char DIGITS[] = "0123456789abcdef";
+
+// Little endian 32-bit limbs
+struct ref256_t {
+    uint32_t limb[8];
+};
+
+ref256_t ref_from_bytes(const uint8_t *be) {
+    ref256_t r = {};
+    for (size_t i = 0; i < 32; i++) {
+        r.limb[(31 - i) / 4] |= static_cast<uint32_t>(be[i]) << (8 * ((31 - i) % 4));
+    }
+    return r;
+}
+
+ref256_t ref_from_uint256(const uint256_t &v) {
+    const uint64_t words[4] = {LOWER(LOWER(v)), UPPER(LOWER(v)), LOWER(UPPER(v)), UPPER(UPPER(v))};
+    ref256_t r = {};
+    for (size_t i = 0; i < 4; i++) {
+        r.limb[2 * i] = static_cast<uint32_t>(words[i]);
+        r.limb[2 * i + 1] = static_cast<uint32_t>(words[i] >> 32);
+    }
+    return r;
+}
+
+bool ref_equal(const ref256_t &a, const ref256_t &b) { return memcmp(a.limb, b.limb, sizeof(a.limb)) == 0; }
+
+bool ref_is_zero(const ref256_t &a) { return ref_equal(a, ref256_t{}); }
+
+bool ref_gte(const ref256_t &a, const ref256_t &b) {
+    for (int i = 7; i >= 0; i--) {
+        if (a.limb[i] != b.limb[i]) {
+            return a.limb[i] > b.limb[i];
+        }
+    }
+    return true;
+}
+
+void ref_sub(ref256_t *a, const ref256_t &b) {
+    int64_t borrow = 0;
+    for (size_t i = 0; i < 8; i++) {
+        const int64_t d = static_cast<int64_t>(a->limb[i]) - b.limb[i] - borrow;
+        borrow = d < 0 ? 1 : 0;
+        a->limb[i] = static_cast<uint32_t>(d);
+    }
+}
+
+// Product modulo 2^256
+ref256_t ref_mul(const ref256_t &a, const ref256_t &b) {
+    ref256_t r = {};
+    for (size_t i = 0; i < 8; i++) {
+        uint64_t carry = 0;
+        for (size_t j = 0; i + j < 8; j++) {
+            const uint64_t t = static_cast<uint64_t>(a.limb[i]) * b.limb[j] + r.limb[i + j] + carry;
+            r.limb[i + j] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+    }
+    return r;
+}
+
+// Restoring long division, one bit at a time
+void ref_divmod(const ref256_t &l, const ref256_t &r, ref256_t *div, ref256_t *mod) {
+    *div = {};
+    *mod = {};
+    for (int bit = 255; bit >= 0; bit--) {
+        for (int i = 7; i > 0; i--) {
+            mod->limb[i] = (mod->limb[i] << 1) | (mod->limb[i - 1] >> 31);
+        }
+        mod->limb[0] = (mod->limb[0] << 1) | ((l.limb[bit / 32] >> (bit % 32)) & 1);
+        if (ref_gte(*mod, r)) {
+            ref_sub(mod, r);
+            div->limb[bit / 32] |= 1u << (bit % 32);
+        }
+    }
+}
+
+std::string ref_tostring(ref256_t v, uint32_t base) {
+    std::string out;
+    do {
+        uint64_t rem = 0;
+        for (int i = 7; i >= 0; i--) {
+            const uint64_t cur = (rem << 32) | v.limb[i];
+            v.limb[i] = static_cast<uint32_t>(cur / base);
+            rem = cur % base;
+        }
+        out.insert(out.begin(), DIGITS[rem]);
+    } while (!ref_is_zero(v));
+    return out;
+}
+
+uint256_t read_u256(const uint8_t *be) {
+    uint256_t v;
+    parser_context_t ctx = {};
+    ctx.buffer = be;
+    ctx.bufferLen = 32;
+    const parser_error_t rc = readu256BE(&ctx, &v);
+    assert(rc == parser_ok);
+    return v;
+}
+
+unsigned __int128 to_u128(const uint128_t &v) { return (static_cast<unsigned __int128>(UPPER(v)) << 64) | LOWER(v); }
+
+std::string u128_tostring(unsigned __int128 v, uint32_t base) {
+    std::string out;
+    do {
+        out.insert(out.begin(), DIGITS[static_cast<uint32_t>(v % base)]);
+        v /= base;
+    } while (v != 0);
+    return out;
+}
+
+void check_128(uint128_t a, uint128_t b, uint32_t base) {
+    const unsigned __int128 ra = to_u128(a);
+    const unsigned __int128 rb = to_u128(b);
+
+    uint128_t product;
+    mul128(&a, &b, &product);
+    assert(to_u128(product) == static_cast<unsigned __int128>(ra * rb));
+
+    if (rb != 0) {
+        uint128_t div;
+        uint128_t mod;
+        divmod128(&a, &b, &div, &mod);
+        assert(to_u128(div) == ra / rb);
+        assert(to_u128(mod) == ra % rb);
+    }
+
+    char out[130];
+    const bool ok = tostring128(&a, base, out, sizeof(out));
+    assert(ok == (base >= 2 && base <= 16));
+    if (ok) {
+        assert(u128_tostring(ra, base) == out);
+    }
+}
+
+void check_256(uint256_t a, uint256_t b, uint32_t base, uint32_t outLen) {
+    const ref256_t ra = ref_from_uint256(a);
+    const ref256_t rb = ref_from_uint256(b);
+
+    uint256_t product;
+    mul256(&a, &b, &product);
+    if (!ref_equal(ref_from_uint256(product), ref_mul(ra, rb))) {
+        (void)fprintf(stderr, "mul256 mismatch\n");
+        assert(false);
+    }
+
+    // divmod256 never returns for a zero divisor; callers only divide by constants
+    if (!ref_is_zero(rb)) {
+        uint256_t div;
+        uint256_t mod;
+        divmod256(&a, &b, &div, &mod);
+        ref256_t refDiv;
+        ref256_t refMod;
+        ref_divmod(ra, rb, &refDiv, &refMod);
+        if (!ref_equal(ref_from_uint256(div), refDiv) || !ref_equal(ref_from_uint256(mod), refMod)) {
+            (void)fprintf(stderr, "divmod256 mismatch\n");
+            assert(false);
+        }
+    }
+
+    char out[258];
+    assert(outLen <= sizeof(out));
+    const bool ok = tostring256(&a, base, out, outLen);
+    if (base < 2 || base > 16) {
+        assert(!ok);
+        return;
+    }
+    const std::string expected = ref_tostring(ra, base);
+    assert(ok == (expected.size() < outLen));
+    if (ok) {
+        assert(expected == out);
+    }
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    uint8_t input[INPUT_SIZE] = {0};
+    if (size > 0) {
+        memcpy(input, data, size < sizeof(input) ? size : sizeof(input));
+    }
+
+    const uint256_t a = read_u256(input);
+    const uint256_t b = read_u256(input + 32);
+    assert(ref_equal(ref_from_uint256(a), ref_from_bytes(input)));
+    assert(ref_equal(ref_from_uint256(b), ref_from_bytes(input + 32)));
+
+    // Bases slightly outside 2..16 must be rejected
+    const uint32_t base = input[64] % 20;
+    // 256 binary digits plus the terminator fit in 258 bytes
+    const uint32_t outLen = input[65] + 3u;
+
+    check_256(a, b, base, outLen);
+    check_128(LOWER(a), LOWER(b), base);
+    check_128(UPPER(a), LOWER(b), base);
+
+    return 0;
+}
@@ -0,0 +1,368 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+// sei-preview: renders a corpus of transactions with the app parser.
+//
+// Input is one transaction per line, read from a file (memory mapped) or stdin:
+//   {...}        amino JSON sign doc, as sent to the device
+//   <hex>        hex encoded amino JSON or EVM RLP transaction
+// Blank lines and lines starting with # are skipped.
+//
+// Output is NDJSON in input order, one object per transaction:
+//   {"line":1,"kind":"amino","us":12.3,"items":["0 | Chain ID : pacific-1",...]}
+//   {"line":2,"kind":"evm","us":4.1,"error":"Unexpected buffer end"}
+// Latency percentiles and throughput are printed to stderr at the end.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parser.h"
+#include "preview.h"
+
+namespace {
+
+enum class input_kind_e { autodetect, amino, evm };
+
+struct options_t {
+    std::string path;
+    size_t threads = 0;
+    size_t batchSize = 4096;
+    input_kind_e kind = input_kind_e::autodetect;
+    preview_options_t preview;
+};
+
+// Lines of the input. Memory mapped files are read in place, stdin is copied.
+class line_reader_t {
+   public:
+    ~line_reader_t() {
+        if (mapped != nullptr) {
+            munmap(mapped, mappedLen);
+        }
+    }
+
+    bool open(const std::string &path) {
+        if (path.empty() || path == "-") {
+            return true;
+        }
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st = {};
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return false;
+        }
+        mappedLen = static_cast<size_t>(st.st_size);
+        if (mappedLen > 0) {
+            void *addr = mmap(nullptr, mappedLen, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                close(fd);
+                return false;
+            }
+            madvise(addr, mappedLen, MADV_SEQUENTIAL);
+            mapped = static_cast<char *>(addr);
+        }
+        close(fd);
+        isMapped = true;
+        return true;
+    }
+
+    // The returned view stays valid until clear() is called
+    bool next(std::string_view *line) {
+        if (isMapped) {
+            if (offset >= mappedLen) {
+                return false;
+            }
+            const char *start = mapped + offset;
+            const void *end = memchr(start, '\n', mappedLen - offset);
+            const size_t len = end != nullptr ? static_cast<size_t>(static_cast<const char *>(end) - start)
+                                              : mappedLen - offset;
+            offset += len + 1;
+            *line = std::string_view(start, len);
+            return true;
+        }
+        std::string tmp;
+        if (!std::getline(std::cin, tmp)) {
+            return false;
+        }
+        owned.push_back(std::move(tmp));
+        *line = owned.back();
+        return true;
+    }
+
+    void clear() { owned.clear(); }
+
+   private:
+    bool isMapped = false;
+    char *mapped = nullptr;
+    size_t mappedLen = 0;
+    size_t offset = 0;
+    // deque so earlier views are not invalidated while the batch grows
+    std::deque<std::string> owned;
+};
+
+struct batch_entry_t {
+    size_t line;
+    const char *inputError;
+    std::vector<uint8_t> decoded;
+};
+
+bool hex_value(char c, uint8_t *v) {
+    if (c >= '0' && c <= '9') {
+        *v = static_cast<uint8_t>(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+        *v = static_cast<uint8_t>(c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+        *v = static_cast<uint8_t>(c - 'A' + 10);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool decode_hex(std::string_view hex, std::vector<uint8_t> *out) {
+    if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+        hex.remove_prefix(2);
+    }
+    if (hex.size() % 2 != 0) {
+        return false;
+    }
+    out->resize(hex.size() / 2);
+    for (size_t i = 0; i < out->size(); i++) {
+        uint8_t hi = 0;
+        uint8_t lo = 0;
+        if (!hex_value(hex[2 * i], &hi) || !hex_value(hex[2 * i + 1], &lo)) {
+            return false;
+        }
+        (*out)[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && isspace(static_cast<unsigned char>(s.front()))) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && isspace(static_cast<unsigned char>(s.back()))) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+void append_json_string(std::string *out, const std::string &s) {
+    out->push_back('"');
+    for (const char c : s) {
+        const auto u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out->push_back('\\');
+            out->push_back(c);
+        } else if (u < 0x20) {
+            char tmp[8];
+            snprintf(tmp, sizeof(tmp), "\\u%04x", u);
+            out->append(tmp);
+        } else {
+            out->push_back(c);
+        }
+    }
+    out->push_back('"');
+}
+
+void write_result(const batch_entry_t &entry, const preview_request_t &request, const preview_result_t *result,
+                  std::string *out) {
+    char tmp[64];
+    snprintf(tmp, sizeof(tmp), "{\"line\":%zu", entry.line);
+    out->append(tmp);
+
+    if (entry.inputError != nullptr) {
+        out->append(",\"error\":");
+        append_json_string(out, entry.inputError);
+    } else {
+        out->append(request.kind == preview_kind_e::evm_rlp ? ",\"kind\":\"evm\"" : ",\"kind\":\"amino\"");
+        snprintf(tmp, sizeof(tmp), ",\"us\":%.1f", static_cast<double>(result->elapsedNs) / 1e3);
+        out->append(tmp);
+        if (result->error != parser_ok) {
+            out->append(",\"error\":");
+            append_json_string(out, parser_getErrorDescription(result->error));
+        } else {
+            out->append(",\"items\":[");
+            for (size_t i = 0; i < result->items.size(); i++) {
+                if (i > 0) {
+                    out->push_back(',');
+                }
+                append_json_string(out, result->items[i]);
+            }
+            out->push_back(']');
+        }
+    }
+    out->append("}\n");
+}
+
+bool parse_args(int argc, char **argv, options_t *opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if ((arg == "-j" || arg == "--threads") && hasValue) {
+            opts->threads = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--batch" && hasValue) {
+            opts->batchSize = std::max(1ul, strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--kind" && hasValue) {
+            const std::string kind = argv[++i];
+            if (kind == "amino") {
+                opts->kind = input_kind_e::amino;
+            } else if (kind == "evm") {
+                opts->kind = input_kind_e::evm;
+            } else if (kind != "auto") {
+                return false;
+            }
+        } else if (arg == "--key-len" && hasValue) {
+            opts->preview.keyLen = static_cast<uint16_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--value-len" && hasValue) {
+            opts->preview.valueLen = static_cast<uint16_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--expert") {
+            opts->preview.expert = true;
+        } else if (arg == "--blindsign") {
+            opts->preview.blindsign = true;
+        } else if (arg[0] == '-' && arg != "-") {
+            return false;
+        } else if (opts->path.empty()) {
+            opts->path = arg;
+        } else {
+            return false;
+        }
+    }
+    return opts->preview.keyLen > 0 && opts->preview.valueLen > 0;
+}
+
+double percentile(const std::vector<uint64_t> &sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[idx]) / 1e3;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    options_t opts;
+    if (!parse_args(argc, argv, &opts)) {
+        fprintf(stderr,
+                "usage: %s [-j threads] [--batch n] [--kind auto|amino|evm] [--key-len n] [--value-len n]\n"
+                "       [--expert] [--blindsign] [file|-]\n",
+                argv[0]);
+        return 2;
+    }
+
+    line_reader_t reader;
+    if (!reader.open(opts.path)) {
+        fprintf(stderr, "%s: cannot open\n", opts.path.c_str());
+        return 2;
+    }
+
+    preview_pool_t pool(opts.threads);
+    std::vector<uint64_t> latencies;
+    size_t total = 0;
+    size_t failed = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    // Requests point into entries, so it must never reallocate while a batch is built
+    std::vector<batch_entry_t> entries;
+    entries.reserve(opts.batchSize);
+    std::vector<preview_request_t> requests;
+    std::string out;
+    size_t lineNumber = 0;
+    bool eof = false;
+
+    while (!eof) {
+        entries.clear();
+        requests.clear();
+        reader.clear();
+
+        std::string_view line;
+        while (entries.size() < opts.batchSize) {
+            if (!reader.next(&line)) {
+                eof = true;
+                break;
+            }
+            lineNumber++;
+            line = trim(line);
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            entries.push_back({lineNumber, nullptr, {}});
+            batch_entry_t &entry = entries.back();
+            preview_request_t request = {preview_kind_e::amino_json, nullptr, 0};
+
+            if (line[0] == '{') {
+                request.data = reinterpret_cast<const uint8_t *>(line.data());
+                request.dataLen = line.size();
+            } else if (decode_hex(line, &entry.decoded)) {
+                request.data = entry.decoded.data();
+                request.dataLen = entry.decoded.size();
+            } else {
+                entry.inputError = "invalid hex";
+            }
+
+            if (opts.kind == input_kind_e::evm ||
+                (opts.kind == input_kind_e::autodetect && request.dataLen > 0 && request.data[0] != '{')) {
+                request.kind = preview_kind_e::evm_rlp;
+            }
+            requests.push_back(request);
+        }
+
+        const auto results = pool.run(requests, opts.preview);
+
+        out.clear();
+        for (size_t i = 0; i < entries.size(); i++) {
+            write_result(entries[i], requests[i], &results[i], &out);
+            total++;
+            if (entries[i].inputError != nullptr || results[i].error != parser_ok) {
+                failed++;
+            }
+            if (entries[i].inputError == nullptr) {
+                latencies.push_back(results[i].elapsedNs);
+            }
+        }
+        fwrite(out.data(), 1, out.size(), stdout);
+    }
+    fflush(stdout);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::sort(latencies.begin(), latencies.end());
+    fprintf(stderr,
+            "transactions %zu  failed %zu  threads %zu  elapsed %.2f s  %.0f tx/s\n"
+            "latency us   p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+            total, failed, pool.threads(), seconds, seconds > 0 ? static_cast<double>(total) / seconds : 0.0,
+            percentile(latencies, 0.50), percentile(latencies, 0.90), percentile(latencies, 0.99),
+            percentile(latencies, 0.999), percentile(latencies, 1.0));
+
+    return failed == 0 ? 0 : 1;
+}
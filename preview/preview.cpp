@@ -0,0 +1,278 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include "preview.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "app_mode.h"
+#include "parser.h"
+#include "parser_evm.h"
+
+namespace {
+
+// Requests are queued in chunks to keep the queue traffic low for small transactions
+constexpr size_t CHUNK_SIZE = 8;
+
+// Parser state of one thread. It is reused for every request that thread renders.
+struct preview_arena_t {
+    parser_context_t ctx;
+    parser_tx_t tx_obj;
+    eth_tx_t eth_tx_obj;
+    std::vector<char> key;
+    std::vector<char> value;
+};
+
+preview_arena_t &thread_arena() {
+    static thread_local preview_arena_t arena;
+    return arena;
+}
+
+// app_mode is a process wide setting shared by every parser context
+std::mutex app_mode_mutex;
+
+void apply_app_mode(const preview_options_t &options) {
+    app_mode_set_expert(options.expert);
+    app_mode_set_blindsign(options.blindsign);
+}
+
+void render_items(preview_arena_t *arena, const preview_request_t &request, const preview_options_t &options,
+                  preview_result_t *result) {
+    result->items.clear();
+    result->error = parser_ok;
+
+    if (request.data == nullptr || request.dataLen == 0) {
+        result->error = parser_no_data;
+        return;
+    }
+    // Contexts index the buffer with 16 bits
+    if (request.dataLen > UINT16_MAX) {
+        result->error = parser_transaction_too_big;
+        return;
+    }
+
+    const bool isEth = request.kind == preview_kind_e::evm_rlp;
+    parser_context_t *ctx = &arena->ctx;
+
+    // Same sequence as tx_parse / tx_parse_eth on the device
+    parser_error_t err = isEth ? parser_parse_eth(ctx, request.data, request.dataLen, &arena->eth_tx_obj)
+                               : parser_parse(ctx, request.data, request.dataLen, &arena->tx_obj);
+    if (err == parser_ok) {
+        err = isEth ? parser_validate_eth(ctx) : parser_validate(ctx);
+    }
+
+    uint16_t numItems = 0;
+    if (err == parser_ok) {
+        uint8_t numItemsEth = 0;
+        err = isEth ? parser_getNumItemsEth(ctx, &numItemsEth) : parser_getNumItems(ctx, &numItems);
+        if (isEth) {
+            numItems = numItemsEth;
+        }
+    }
+    if (err != parser_ok) {
+        result->error = err;
+        return;
+    }
+
+    arena->key.assign(options.keyLen + 1u, 0);
+    arena->value.assign(options.valueLen + 1u, 0);
+    char *key = arena->key.data();
+    char *value = arena->value.data();
+
+    for (uint16_t idx = 0; idx < numItems; idx++) {
+        uint8_t pageIdx = 0;
+        uint8_t pageCount = 1;
+        while (pageIdx < pageCount) {
+            err = isEth ? parser_getItemEth(ctx, (uint8_t)idx, key, options.keyLen, value, options.valueLen, pageIdx,
+                                            &pageCount)
+                        : parser_getItem(ctx, idx, key, options.keyLen, value, options.valueLen, pageIdx, &pageCount);
+
+            std::string line = std::to_string(idx) + " | " + key;
+            if (pageCount > 1) {
+                line += " [" + std::to_string(pageIdx + 1) + "/" + std::to_string(pageCount) + "]";
+            }
+            line += " : ";
+            line += err == parser_ok ? value : parser_getErrorDescription(err);
+            result->items.push_back(std::move(line));
+
+            pageIdx++;
+        }
+    }
+}
+
+void render(preview_arena_t *arena, const preview_request_t &request, const preview_options_t &options,
+            preview_result_t *result) {
+    const auto start = std::chrono::steady_clock::now();
+    render_items(arena, request, options, result);
+    result->elapsedNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+}  // namespace
+
+preview_result_t preview_one(const preview_request_t &request, const preview_options_t &options) {
+    preview_result_t result;
+    const std::lock_guard<std::mutex> lock(app_mode_mutex);
+    apply_app_mode(options);
+    render(&thread_arena(), request, options, &result);
+    return result;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Work stealing pool
+//
+// Each worker owns a queue of chunk indices. A batch is split evenly over the
+// queues; a worker pops from the back of its own queue and, once it is empty,
+// steals from the front of the others until every queue is drained.
+
+struct preview_pool_t::impl_t {
+    struct queue_t {
+        std::mutex mutex;
+        std::deque<size_t> chunks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<queue_t>> queues;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    uint64_t generation = 0;
+    size_t busyWorkers = 0;
+    bool stopping = false;
+
+    // Current batch
+    const std::vector<preview_request_t> *requests = nullptr;
+    const preview_options_t *options = nullptr;
+    std::vector<preview_result_t> *results = nullptr;
+
+    bool next_chunk(size_t self, size_t *chunk) {
+        {
+            queue_t &own = *queues[self];
+            const std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.chunks.empty()) {
+                *chunk = own.chunks.back();
+                own.chunks.pop_back();
+                return true;
+            }
+        }
+        for (size_t i = 1; i < queues.size(); i++) {
+            queue_t &victim = *queues[(self + i) % queues.size()];
+            const std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.chunks.empty()) {
+                *chunk = victim.chunks.front();
+                victim.chunks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(size_t self) {
+        uint64_t seen = 0;
+        preview_arena_t &arena = thread_arena();
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+
+            size_t chunk = 0;
+            while (next_chunk(self, &chunk)) {
+                const size_t first = chunk * CHUNK_SIZE;
+                const size_t last = std::min(first + CHUNK_SIZE, requests->size());
+                for (size_t i = first; i < last; i++) {
+                    render(&arena, (*requests)[i], *options, &(*results)[i]);
+                }
+            }
+
+            const std::lock_guard<std::mutex> lock(mutex);
+            if (--busyWorkers == 0) {
+                done.notify_one();
+            }
+        }
+    }
+};
+
+preview_pool_t::preview_pool_t(size_t threads) : impl(new impl_t) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < threads; i++) {
+        impl->queues.emplace_back(new impl_t::queue_t);
+    }
+    for (size_t i = 0; i < threads; i++) {
+        impl->workers.emplace_back(&impl_t::worker_loop, impl.get(), i);
+    }
+}
+
+preview_pool_t::~preview_pool_t() {
+    {
+        const std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->stopping = true;
+    }
+    impl->wake.notify_all();
+    for (auto &worker : impl->workers) {
+        worker.join();
+    }
+}
+
+size_t preview_pool_t::threads() const { return impl->workers.size(); }
+
+std::vector<preview_result_t> preview_pool_t::run(const std::vector<preview_request_t> &requests,
+                                                  const preview_options_t &options) {
+    std::vector<preview_result_t> results(requests.size());
+    if (requests.empty()) {
+        return results;
+    }
+
+    const std::lock_guard<std::mutex> modeLock(app_mode_mutex);
+    apply_app_mode(options);
+
+    // Contiguous runs of chunks per worker keep neighbouring requests on one thread
+    const size_t numChunks = (requests.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const size_t numQueues = impl->queues.size();
+    for (size_t q = 0; q < numQueues; q++) {
+        const std::lock_guard<std::mutex> queueLock(impl->queues[q]->mutex);
+        auto &chunks = impl->queues[q]->chunks;
+        for (size_t c = numChunks * q / numQueues; c < numChunks * (q + 1) / numQueues; c++) {
+            chunks.push_back(c);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(impl->mutex);
+    impl->requests = &requests;
+    impl->options = &options;
+    impl->results = &results;
+    impl->busyWorkers = impl->workers.size();
+    impl->generation++;
+    impl->wake.notify_all();
+    impl->done.wait(lock, [&] { return impl->busyWorkers == 0; });
+
+    impl->requests = nullptr;
+    impl->options = nullptr;
+    impl->results = nullptr;
+    return results;
+}
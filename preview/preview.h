@@ -0,0 +1,84 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Host-only batch preview of transactions.
+//
+// Renders what the device will show for a transaction, line by line and in the
+// same "idx | key [page/pages] : value" format as dumpUI in the unit tests, so
+// wallet backends can display or check it before sending anything to a Ledger.
+// Batches are spread over a pool of worker threads; every worker owns its own
+// parser state, so requests never share a parser context.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parser_common.h"
+
+enum class preview_kind_e {
+    amino_json,  // Cosmos amino JSON sign doc
+    evm_rlp,     // EVM transaction (legacy, EIP-2930 or EIP-1559)
+};
+
+struct preview_request_t {
+    preview_kind_e kind;
+    // Not owned, must stay valid until the batch returns
+    const uint8_t *data;
+    size_t dataLen;
+};
+
+struct preview_options_t {
+    // Key/value sizes of the target screen, as passed to dumpUI
+    uint16_t keyLen = 39;
+    uint16_t valueLen = 39;
+    bool expert = false;
+    bool blindsign = false;
+};
+
+struct preview_result_t {
+    // parse / validate error, in which case items is empty
+    parser_error_t error = parser_ok;
+    std::vector<std::string> items;
+    // Wall time spent parsing and rendering this request
+    uint64_t elapsedNs = 0;
+};
+
+// Renders a single request on the calling thread
+preview_result_t preview_one(const preview_request_t &request, const preview_options_t &options);
+
+class preview_pool_t {
+   public:
+    // threads == 0 uses one thread per hardware thread
+    explicit preview_pool_t(size_t threads = 0);
+    ~preview_pool_t();
+
+    preview_pool_t(const preview_pool_t &) = delete;
+    preview_pool_t &operator=(const preview_pool_t &) = delete;
+
+    size_t threads() const;
+
+    // Renders every request; results[i] belongs to requests[i].
+    // Expert and blind signing are process wide app modes, so batches from
+    // different pools or threads run one after the other.
+    std::vector<preview_result_t> run(const std::vector<preview_request_t> &requests, const preview_options_t &options);
+
+   private:
+    struct impl_t;
+    std::unique_ptr<impl_t> impl;
+};
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Generate app/src/denom_registry_entries.h, the table behind denom_registry.c.
+
+Native and factory denoms are listed by name. IBC denoms are listed by the trace they arrive through on Sei
+(pacific-1), the on-chain name ibc/<SHA-256 of the trace> is derived here so every entry can be checked against
+its channel. Run with --check to fail when the checked-in header differs from what this script generates.
+"""
+
+import hashlib
+import os
+import sys
+
+OUTPUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'app', 'src', 'denom_registry_entries.h')
+
+# (denom or IBC trace, display symbol, exponent, origin)
+DENOMS = [
+    ('usei', 'SEI', 6, 'native'),
+    ('transfer/channel-45/uusdc', 'USDC', 6, 'USDC from Noble'),
+]
+
+COIN_DENOM_MAXSIZE = 129
+
+HEADER = '''/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+// Generated by scripts/gen_denom_registry.py, do not edit. Entries of denom_registry, sorted by hash.
+'''
+
+
+def fnv1a(data):
+    h = 0x811C9DC5
+    for b in data:
+        h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def base_denom(denom):
+    if denom.startswith('transfer/'):
+        return 'ibc/' + hashlib.sha256(denom.encode()).hexdigest().upper()
+    return denom
+
+
+def render():
+    entries = []
+    for denom, symbol, exponent, origin in DENOMS:
+        base = base_denom(denom)
+        assert len(base) < COIN_DENOM_MAXSIZE, base
+        note = origin if base == denom else f'{origin}, {denom}'
+        entries.append((fnv1a(base.encode()), base, symbol, exponent, note))
+    entries.sort()
+
+    lines = [HEADER]
+    for h, base, symbol, exponent, note in entries:
+        lines.append(f'// {note}\n')
+        lines.append(f'{{0x{h:08X}u, "{base}", "{symbol}", {exponent}}},\n')
+    return ''.join(lines)
+
+
+def main():
+    content = render()
+    if '--check' in sys.argv[1:]:
+        with open(OUTPUT) as f:
+            if f.read() != content:
+                print(f'{OUTPUT} is out of date, run {sys.argv[0]}')
+                return 1
+        return 0
+    with open(OUTPUT, 'w') as f:
+        f.write(content)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
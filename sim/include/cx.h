@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// The subset of the SDK cryptography API used by crypto.c and crypto_evm.c,
+// implemented on top of the host backend in app/src/host. Keys are derived
+// from HOST_TEST_MNEMONIC, the seed the zemu tests load on the emulator.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "host_hash.h"
+#include "host_secp256k1.h"
+
+typedef uint32_t cx_err_t;
+
+#define CX_OK 0x00000000u
+#define CX_INTERNAL_ERROR 0xFFFFFF85u
+#define CX_INVALID_PARAMETER 0xFFFFFF83u
+
+#define CX_LAST (1u << 0)
+#define CX_RND_RFC6979 (3u << 9)
+
+#define CX_SHA256_SIZE HOST_SHA256_SIZE
+#define CX_RIPEMD160_SIZE HOST_RIPEMD160_SIZE
+
+#ifndef CX_ECCINFO_PARITY_ODD
+#define CX_ECCINFO_PARITY_ODD HOST_SECP256K1_INFO_PARITY_ODD
+#define CX_ECCINFO_xGTn HOST_SECP256K1_INFO_X_GT_N
+#endif
+
+typedef enum {
+    CX_NONE = 0,
+    CX_RIPEMD160 = 1,
+    CX_SHA256 = 3,
+    CX_KECCAK = 6,
+} cx_md_t;
+
+typedef enum {
+    CX_CURVE_NONE = 0,
+    CX_CURVE_256K1 = 0x21,
+} cx_curve_t;
+
+#define HDW_NORMAL 0u
+
+typedef struct {
+    cx_md_t algo;
+} cx_hash_t;
+
+typedef struct {
+    cx_hash_t header;
+    host_sha256_t state;
+} cx_sha256_t;
+
+typedef struct {
+    cx_hash_t header;
+    host_keccak256_t state;
+} cx_sha3_t;
+
+typedef struct {
+    cx_curve_t curve;
+    size_t d_len;
+    uint8_t d[HOST_SECP256K1_SK_LEN];
+} cx_ecfp_private_key_t;
+
+typedef struct {
+    cx_curve_t curve;
+    size_t W_len;
+    uint8_t W[HOST_SECP256K1_PK_LEN];
+} cx_ecfp_public_key_t;
+
+cx_err_t cx_sha256_init_no_throw(cx_sha256_t *hash);
+cx_err_t cx_keccak_init_no_throw(cx_sha3_t *hash, size_t size);
+cx_err_t cx_hash_no_throw(cx_hash_t *hash, uint32_t mode, const uint8_t *in, size_t len, uint8_t *out, size_t out_len);
+
+cx_err_t os_derive_bip32_with_seed_no_throw(unsigned int derivation_mode, cx_curve_t curve, const uint32_t *path,
+                                            size_t path_len, uint8_t raw_privkey[64], uint8_t *chain_code,
+                                            const unsigned char *seed_key, unsigned int seed_key_length);
+
+cx_err_t cx_ecfp_init_private_key_no_throw(cx_curve_t curve, const uint8_t *rawkey, size_t key_len,
+                                           cx_ecfp_private_key_t *pvkey);
+cx_err_t cx_ecfp_init_public_key_no_throw(cx_curve_t curve, const uint8_t *rawkey, size_t key_len,
+                                          cx_ecfp_public_key_t *key);
+cx_err_t cx_ecfp_generate_pair_no_throw(cx_curve_t curve, cx_ecfp_public_key_t *pubkey, cx_ecfp_private_key_t *privkey,
+                                        bool keepprivate);
+cx_err_t cx_ecdsa_sign_no_throw(const cx_ecfp_private_key_t *pvkey, uint32_t mode, cx_md_t hashID, const uint8_t *hash,
+                                size_t hash_len, uint8_t *sig, size_t *sig_len, uint32_t *info);
+
+#ifndef CATCH_CXERROR
+#define CATCH_CXERROR(CALL)               \
+    do {                                  \
+        const cx_err_t __cx_err = (CALL); \
+        if (__cx_err != CX_OK) {          \
+            goto catch_cx_error;          \
+        }                                 \
+    } while (0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Minimal stand-in for the secure SDK os.h used by the host APDU simulator.
+// Only what the app sources touch is provided: the TRY/CATCH exception model
+// and the PIN state query.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef uint16_t exception_t;
+
+typedef struct try_context_s {
+    jmp_buf jmp_buf;
+    struct try_context_s *previous_context;
+    volatile exception_t ex;
+} try_context_t;
+
+try_context_t *try_context_get(void);
+try_context_t *try_context_set(try_context_t *context);
+void os_longjmp(exception_t exception) __attribute__((noreturn));
+
+// Same layout as the SDK macros, one TRY block per function
+#define BEGIN_TRY                    \
+    {                                \
+        try_context_t __try_context; \
+        __try_context.ex = 0;
+
+#define TRY                                                     \
+    __try_context.ex = (exception_t)setjmp(__try_context.jmp_buf); \
+    if (__try_context.ex == 0) {                                \
+        __try_context.previous_context = try_context_set(&__try_context);
+
+#define CATCH(x)                               \
+    goto __FINALLY;                            \
+    }                                          \
+    else if (__try_context.ex == (x)) {        \
+        __try_context.ex = 0;                  \
+        try_context_set(__try_context.previous_context);
+
+#define CATCH_OTHER(e)                         \
+    goto __FINALLY;                            \
+    }                                          \
+    else {                                     \
+        exception_t e = __try_context.ex;      \
+        __try_context.ex = 0;                  \
+        try_context_set(__try_context.previous_context);
+
+#define FINALLY                                         \
+    goto __FINALLY;                                     \
+    }                                                   \
+    __FINALLY:                                          \
+    if (try_context_get() == &__try_context) {          \
+        try_context_set(__try_context.previous_context); \
+    }
+
+#define END_TRY                          \
+    if (__try_context.ex != 0) {         \
+        os_longjmp(__try_context.ex);    \
+    }                                    \
+    }
+
+#define THROW(x) os_longjmp((exception_t)(x))
+
+#define EXCEPTION_IO_RESET 0x10u
+
+#define BOLOS_UX_OK 0xAAu
+#define BOLOS_UX_CANCEL 0x69u
+
+uint8_t os_global_pin_is_validated(void);
+
+#ifdef __cplusplus
+}
+#endif
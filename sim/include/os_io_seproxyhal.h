@@ -0,0 +1,41 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Host replacement for the SDK APDU transport. io_exchange does not block:
+// replies sent from review callbacks are captured by the simulator.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "os.h"
+
+#define IO_APDU_BUFFER_SIZE (5 + 255)
+
+#define CHANNEL_APDU 0x00u
+#define IO_ASYNCH_REPLY 0x10u
+#define IO_RETURN_AFTER_TX 0x20u
+
+extern uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+unsigned short io_exchange(unsigned char channel_and_flags, unsigned short tx_len);
+
+#ifdef __cplusplus
+}
+#endif
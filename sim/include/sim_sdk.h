@@ -0,0 +1,32 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Included ahead of every app source built into the simulator. On the device
+// zxmacros pulls these SDK headers in for all translation units; this keeps
+// the app sources unchanged on the host.
+
+#include <stdbool.h>
+
+#include "cx.h"
+#include "os.h"
+#include "os_io_seproxyhal.h"
+#include "ux.h"
+
+#ifndef TARGET_ID
+// Reported by GET_VERSION; the simulator mimics the Nano S+ buffer sizes
+#define TARGET_ID 0x33100004u
+#endif
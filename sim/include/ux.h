@@ -0,0 +1,29 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#include "os.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The simulator has no screen; a locked device is the only UX state it models
+#define IS_UX_ALLOWED (os_global_pin_is_validated() == BOLOS_UX_OK)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Review flow of the simulator. There is no display: a review is recorded
+// when it is shown and walked page by page by the simulator afterwards, as
+// the device UI would, before calling the accept or reject action.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "zxerror.h"
+
+typedef enum {
+    REVIEW_UI = 0,
+    REVIEW_ADDRESS,
+    REVIEW_TXN,
+    REVIEW_MSG,
+} review_type_e;
+
+typedef zxerr_t (*viewfunc_getNumItems_t)(uint8_t *num_items);
+typedef zxerr_t (*viewfunc_getItem_t)(int8_t displayIdx, char *outKey, uint16_t outKeyLen, char *outVal,
+                                      uint16_t outValLen, uint8_t pageIdx, uint8_t *pageCount);
+typedef void (*viewfunc_accept_t)(void);
+
+void view_init(void);
+void view_idle_show(uint8_t item_idx, const char *statusString);
+void view_review_init(viewfunc_getItem_t viewfuncGetItem, viewfunc_getNumItems_t viewfuncGetNumItems,
+                      viewfunc_accept_t viewfuncAccept);
+void view_review_show(review_type_e reviewKind);
+void view_blindsign_error_show(void);
+
+#ifdef __cplusplus
+}
+#endif
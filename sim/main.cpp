@@ -0,0 +1,269 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+// sei-sim: replays APDU scripts against the app compiled for the host.
+//
+// Script syntax, one directive per line:
+//   > <hex>                 send an APDU
+//   < <hex>                 expect the previous response to be exactly <hex>
+//   < ...<hex>              expect the previous response to end with <hex>
+//   < <hex>...              expect the previous response to start with <hex>
+//   review approve|reject   how the next reviews are answered (default approve)
+//   expert on|off           toggle expert mode
+//   blindsign on|off        toggle blind signing
+//   pin on|off              lock or unlock the device
+// Blank lines and lines starting with # are ignored.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "app_mode.h"
+#include "sim.h"
+
+namespace {
+
+struct options_t {
+    bool verbose = false;
+    bool json = false;
+};
+
+struct exchange_result_t {
+    std::string script;
+    size_t line;
+    std::vector<uint8_t> command;
+    std::vector<uint8_t> response;
+    sim_stats_t stats;
+};
+
+bool parse_hex(const std::string &in, std::vector<uint8_t> *out) {
+    std::string hex;
+    for (const char c : in) {
+        if (!isspace(static_cast<unsigned char>(c))) {
+            hex.push_back(c);
+        }
+    }
+    if (hex.size() % 2 != 0) {
+        return false;
+    }
+    out->clear();
+    for (size_t i = 0; i < hex.size(); i += 2) {
+        char *end = nullptr;
+        const std::string byte = hex.substr(i, 2);
+        const long value = strtol(byte.c_str(), &end, 16);
+        if (end != byte.c_str() + 2) {
+            return false;
+        }
+        out->push_back(static_cast<uint8_t>(value));
+    }
+    return true;
+}
+
+std::string to_hex(const std::vector<uint8_t> &data) {
+    std::string out;
+    char tmp[3];
+    for (const uint8_t b : data) {
+        snprintf(tmp, sizeof(tmp), "%02x", b);
+        out += tmp;
+    }
+    return out;
+}
+
+uint16_t status_word(const std::vector<uint8_t> &response) {
+    if (response.size() < 2) {
+        return 0;
+    }
+    return static_cast<uint16_t>((response[response.size() - 2] << 8) | response[response.size() - 1]);
+}
+
+void print_page(void *user, uint8_t itemIdx, uint8_t pageIdx, uint8_t pageCount, const char *key, const char *value) {
+    (void)user;
+    if (pageCount > 1) {
+        printf("      %u | %s [%u/%u] : %s\n", itemIdx, key, pageIdx + 1, pageCount, value);
+    } else {
+        printf("      %u | %s : %s\n", itemIdx, key, value);
+    }
+}
+
+bool run_script(const std::string &path, const options_t &opts, std::vector<exchange_result_t> *results) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        fprintf(stderr, "%s: cannot open\n", path.c_str());
+        return false;
+    }
+
+    sim_reset();
+
+    bool ok = true;
+    bool have_response = false;
+    std::vector<uint8_t> last_response;
+    std::string line;
+    size_t lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        lineNumber++;
+        std::istringstream ss(line);
+        std::string directive;
+        if (!(ss >> directive) || directive[0] == '#') {
+            continue;
+        }
+        std::string rest;
+        std::getline(ss, rest);
+        const size_t first = rest.find_first_not_of(" \t");
+        rest = first == std::string::npos ? "" : rest.substr(first);
+
+        if (directive == ">") {
+            exchange_result_t result{path, lineNumber, {}, {}, {}};
+            if (!parse_hex(rest, &result.command)) {
+                fprintf(stderr, "%s:%zu: invalid hex\n", path.c_str(), lineNumber);
+                return false;
+            }
+
+            uint8_t response[512];
+            if (opts.verbose && !opts.json) {
+                printf("%s:%zu\n", path.c_str(), lineNumber);
+            }
+            const uint16_t responseLen = sim_exchange(result.command.data(), static_cast<uint16_t>(result.command.size()),
+                                                      response, sizeof(response), &result.stats);
+            if (responseLen == 0) {
+                fprintf(stderr, "%s:%zu: no response\n", path.c_str(), lineNumber);
+                ok = false;
+            }
+            if (result.stats.review_error) {
+                fprintf(stderr, "%s:%zu: review could not be rendered\n", path.c_str(), lineNumber);
+                ok = false;
+            }
+            result.response.assign(response, response + responseLen);
+            last_response = result.response;
+            have_response = true;
+            results->push_back(result);
+        } else if (directive == "<") {
+            if (!have_response) {
+                fprintf(stderr, "%s:%zu: expectation without a command\n", path.c_str(), lineNumber);
+                return false;
+            }
+            const bool suffix = rest.size() >= 3 && rest.compare(0, 3, "...") == 0;
+            const bool prefix = !suffix && rest.size() >= 3 && rest.compare(rest.size() - 3, 3, "...") == 0;
+            std::vector<uint8_t> expected;
+            const std::string expectedHex = suffix ? rest.substr(3) : prefix ? rest.substr(0, rest.size() - 3) : rest;
+            if (!parse_hex(expectedHex, &expected)) {
+                fprintf(stderr, "%s:%zu: invalid hex\n", path.c_str(), lineNumber);
+                return false;
+            }
+
+            bool match = last_response == expected;
+            if (suffix || prefix) {
+                const auto offset = static_cast<long>(suffix ? last_response.size() - expected.size() : 0);
+                match = last_response.size() >= expected.size() &&
+                        std::equal(expected.begin(), expected.end(), last_response.begin() + offset);
+            }
+            if (!match) {
+                fprintf(stderr, "%s:%zu: unexpected response\n  expected %s\n  received %s\n", path.c_str(), lineNumber,
+                        rest.c_str(), to_hex(last_response).c_str());
+                ok = false;
+            }
+        } else if (directive == "review") {
+            sim_set_review_action(rest == "reject" ? SIM_REVIEW_REJECT : SIM_REVIEW_APPROVE);
+        } else if (directive == "expert") {
+            app_mode_set_expert(rest == "on");
+        } else if (directive == "blindsign") {
+            app_mode_set_blindsign(rest == "on");
+        } else if (directive == "pin") {
+            sim_set_pin_validated(rest == "on");
+        } else {
+            fprintf(stderr, "%s:%zu: unknown directive '%s'\n", path.c_str(), lineNumber, directive.c_str());
+            return false;
+        }
+    }
+
+    return ok;
+}
+
+void print_table(const std::vector<exchange_result_t> &results) {
+    printf("%-32s %4s %4s %4s %4s %5s %6s %12s %12s %8s %6s\n", "script:line", "cla", "ins", "p1", "p2", "lc", "sw",
+           "handler_us", "review_us", "stack", "pages");
+    for (const auto &r : results) {
+        const auto &c = r.command;
+        char location[64];
+        snprintf(location, sizeof(location), "%s:%zu", r.script.substr(r.script.find_last_of('/') + 1).c_str(), r.line);
+        printf("%-32s %4.2x %4.2x %4.2x %4.2x %5zu %6.4x %12.1f %12.1f %8u %6u\n", location, c.size() > 0 ? c[0] : 0,
+               c.size() > 1 ? c[1] : 0, c.size() > 2 ? c[2] : 0, c.size() > 3 ? c[3] : 0,
+               c.size() > 5 ? c.size() - 5 : 0, status_word(r.response), static_cast<double>(r.stats.handler_ns) / 1e3,
+               static_cast<double>(r.stats.review_ns) / 1e3, r.stats.stack_peak, r.stats.review_pages);
+    }
+}
+
+void print_json(const std::vector<exchange_result_t> &results) {
+    printf("[\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto &r = results[i];
+        printf(
+            "  {\"script\": \"%s\", \"line\": %zu, \"command\": \"%s\", \"response\": \"%s\", \"sw\": %u, "
+            "\"handler_ns\": %llu, \"review_ns\": %llu, \"stack_peak\": %u, \"review_pages\": %u}%s\n",
+            r.script.c_str(), r.line, to_hex(r.command).c_str(), to_hex(r.response).c_str(), status_word(r.response),
+            static_cast<unsigned long long>(r.stats.handler_ns), static_cast<unsigned long long>(r.stats.review_ns),
+            r.stats.stack_peak, r.stats.review_pages, i + 1 < results.size() ? "," : "");
+    }
+    printf("]\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    options_t opts;
+    std::vector<std::string> scripts;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            opts.verbose = true;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            opts.json = true;
+        } else {
+            scripts.emplace_back(argv[i]);
+        }
+    }
+
+    if (scripts.empty()) {
+        fprintf(stderr, "usage: %s [-v] [--json] script.apdu...\n", argv[0]);
+        return 2;
+    }
+
+    sim_init();
+    if (opts.verbose && !opts.json) {
+        sim_set_page_callback(print_page, nullptr);
+    }
+
+    bool ok = true;
+    std::vector<exchange_result_t> results;
+    for (const auto &script : scripts) {
+        ok = run_script(script, opts, &results) && ok;
+    }
+
+    if (opts.json) {
+        print_json(results);
+    } else {
+        print_table(results);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include "sim.h"
+
+#include <string.h>
+#include <time.h>
+
+#include "actions.h"
+#include "app_main.h"
+#include "app_mode.h"
+#include "crypto_cache.h"
+#include "host_stack.h"
+#include "os.h"
+#include "os_io_seproxyhal.h"
+#include "sim_internal.h"
+#include "zxmacros.h"
+
+static sim_review_action_e review_action = SIM_REVIEW_APPROVE;
+static sim_page_cb_t page_callback = NULL;
+static void *page_callback_user = NULL;
+
+void sim_init(void) {
+    sim_sdk_init();
+    sim_reset();
+}
+
+void sim_reset(void) {
+    sim_sdk_init();
+    sim_sdk_set_pin_validated(true);
+    crypto_cache_reset();
+    app_mode_set_expert(0);
+    app_mode_set_blindsign(0);
+    review_action = SIM_REVIEW_APPROVE;
+}
+
+void sim_set_pin_validated(bool validated) { sim_sdk_set_pin_validated(validated); }
+
+void sim_set_review_action(sim_review_action_e action) { review_action = action; }
+
+void sim_set_page_callback(sim_page_cb_t callback, void *user) {
+    page_callback = callback;
+    page_callback_user = user;
+}
+
+static uint64_t sim_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Pages through the review like the device UI and returns false if an item
+// could not be rendered
+static bool sim_walk_review(uint16_t *pages) {
+    char key[SIM_VIEW_KEY_LEN];
+    char value[SIM_VIEW_VALUE_LEN];
+
+    // The zxlib view starts from a non-zero count, some getNumItems rely on it
+    uint8_t numItems = 0xFF;
+    if (sim_review.getNumItems == NULL || sim_review.getItem == NULL ||
+        sim_review.getNumItems(&numItems) != zxerr_ok) {
+        return false;
+    }
+
+    for (uint8_t itemIdx = 0; itemIdx < numItems; itemIdx++) {
+        uint8_t pageCount = 1;
+        for (uint8_t pageIdx = 0; pageIdx < pageCount; pageIdx++) {
+            MEMZERO(key, sizeof(key));
+            MEMZERO(value, sizeof(value));
+            const zxerr_t err =
+                sim_review.getItem((int8_t)itemIdx, key, sizeof(key), value, sizeof(value), pageIdx, &pageCount);
+            if (err == zxerr_no_data) {
+                break;
+            }
+            if (err != zxerr_ok) {
+                return false;
+            }
+            (*pages)++;
+            if (page_callback != NULL) {
+                page_callback(page_callback_user, itemIdx, pageIdx, pageCount, key, value);
+            }
+        }
+    }
+    return true;
+}
+
+uint16_t sim_exchange(const uint8_t *command, uint16_t commandLen, uint8_t *response, uint16_t responseMaxLen,
+                      sim_stats_t *stats) {
+    if (command == NULL || response == NULL || stats == NULL || commandLen == 0 ||
+        commandLen > IO_APDU_BUFFER_SIZE) {
+        return 0;
+    }
+
+    MEMZERO(stats, sizeof(*stats));
+    MEMZERO(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    MEMCPY(G_io_apdu_buffer, command, commandLen);
+    MEMZERO(&sim_review, sizeof(sim_review));
+    MEMZERO(&sim_reply, sizeof(sim_reply));
+    sim_blindsign_error = false;
+
+    volatile uint8_t top_marker = 0;
+    host_stack_paint();
+
+    volatile uint32_t flags = 0;
+    volatile uint32_t tx = 0;
+
+    const uint64_t start = sim_now_ns();
+    BEGIN_TRY {
+        TRY { handleApdu(&flags, &tx, commandLen); }
+        CATCH_OTHER(e) {
+            // Only EXCEPTION_IO_RESET escapes handleApdu
+            UNUSED(e);
+            set_code(G_io_apdu_buffer, 0, APDU_CODE_EXECUTION_ERROR);
+            tx = 2;
+        }
+        FINALLY {}
+    }
+    END_TRY;
+    const uint64_t handled = sim_now_ns();
+
+    if ((flags & IO_ASYNCH_REPLY) && sim_review.pending) {
+        const bool rendered = sim_walk_review(&stats->review_pages);
+        stats->review_error = !rendered;
+        if (rendered && review_action == SIM_REVIEW_APPROVE) {
+            sim_review.accept();
+        } else {
+            app_reject();
+        }
+    } else {
+        // Synchronous replies, and errors shown on screen before replying
+        sim_reply.len = (uint16_t)MIN(tx, sizeof(sim_reply.data));
+        MEMCPY(sim_reply.data, G_io_apdu_buffer, sim_reply.len);
+        sim_reply.sent = true;
+    }
+    const uint64_t done = sim_now_ns();
+
+    stats->handler_ns = handled - start;
+    stats->review_ns = done - handled;
+    stats->stack_peak = host_stack_peak((uintptr_t)&top_marker);
+    stats->blindsign_error = sim_blindsign_error;
+
+    if (!sim_reply.sent || sim_reply.len > responseMaxLen) {
+        return 0;
+    }
+    MEMCPY(response, sim_reply.data, sim_reply.len);
+    return sim_reply.len;
+}
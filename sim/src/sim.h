@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+// Host APDU simulator: feeds commands to handleApdu exactly as the device
+// main loop would, walks any review it opens and reports timing and stack
+// usage for every exchange.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SIM_VIEW_KEY_LEN 40u
+#define SIM_VIEW_VALUE_LEN 40u
+
+typedef enum {
+    SIM_REVIEW_APPROVE = 0,
+    SIM_REVIEW_REJECT,
+} sim_review_action_e;
+
+typedef struct {
+    // Time spent inside handleApdu
+    uint64_t handler_ns;
+    // Time spent paging through the review and running the accept/reject action
+    uint64_t review_ns;
+    // Deepest stack use in bytes, covering both phases
+    uint32_t stack_peak;
+    // Pages rendered during the review, 0 when no review was opened
+    uint16_t review_pages;
+    bool review_error;
+    bool blindsign_error;
+} sim_stats_t;
+
+typedef void (*sim_page_cb_t)(void *user, uint8_t itemIdx, uint8_t pageIdx, uint8_t pageCount, const char *key,
+                              const char *value);
+
+// Derives the test seed and resets the app state. Must be called first.
+void sim_init(void);
+
+// Clears app modes, cached keys and pending reviews
+void sim_reset(void);
+
+void sim_set_pin_validated(bool validated);
+void sim_set_review_action(sim_review_action_e action);
+void sim_set_page_callback(sim_page_cb_t callback, void *user);
+
+// Runs one command through handleApdu. Returns the response length (data and
+// status word) or 0 if the command could not be delivered.
+uint16_t sim_exchange(const uint8_t *command, uint16_t commandLen, uint8_t *response, uint16_t responseMaxLen,
+                      sim_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,43 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "os_io_seproxyhal.h"
+#include "view.h"
+
+typedef struct {
+    bool pending;
+    review_type_e kind;
+    viewfunc_getItem_t getItem;
+    viewfunc_getNumItems_t getNumItems;
+    viewfunc_accept_t accept;
+} sim_review_t;
+
+typedef struct {
+    bool sent;
+    uint16_t len;
+    uint8_t data[IO_APDU_BUFFER_SIZE];
+} sim_reply_t;
+
+extern sim_review_t sim_review;
+extern sim_reply_t sim_reply;
+extern bool sim_blindsign_error;
+
+void sim_sdk_init(void);
+void sim_sdk_set_pin_validated(bool validated);
@@ -0,0 +1,236 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cx.h"
+#include "host_hash.h"
+#include "host_secp256k1.h"
+#include "os.h"
+#include "os_io_seproxyhal.h"
+#include "sim_internal.h"
+#include "view.h"
+#include "zxmacros.h"
+
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+sim_review_t sim_review;
+sim_reply_t sim_reply;
+bool sim_blindsign_error = false;
+
+static try_context_t *current_try_context = NULL;
+static bool pin_validated = true;
+static uint8_t test_seed[HOST_BIP39_SEED_LEN];
+static bool test_seed_ready = false;
+
+void sim_sdk_init(void) {
+    if (!test_seed_ready) {
+        host_bip39_seed(HOST_TEST_MNEMONIC, "", test_seed);
+        test_seed_ready = true;
+    }
+    MEMZERO(&sim_review, sizeof(sim_review));
+    MEMZERO(&sim_reply, sizeof(sim_reply));
+    sim_blindsign_error = false;
+}
+
+void sim_sdk_set_pin_validated(bool validated) { pin_validated = validated; }
+
+/////////////////////////////////////////////////////////////////////
+// Exceptions
+
+try_context_t *try_context_get(void) { return current_try_context; }
+
+try_context_t *try_context_set(try_context_t *context) {
+    try_context_t *previous = current_try_context;
+    current_try_context = context;
+    return previous;
+}
+
+void os_longjmp(exception_t exception) {
+    if (current_try_context == NULL) {
+        (void)fprintf(stderr, "sim: uncaught exception 0x%04x\n", exception);
+        abort();
+    }
+    longjmp(current_try_context->jmp_buf, exception);
+}
+
+uint8_t os_global_pin_is_validated(void) { return pin_validated ? BOLOS_UX_OK : BOLOS_UX_CANCEL; }
+
+/////////////////////////////////////////////////////////////////////
+// IO
+
+unsigned short io_exchange(unsigned char channel_and_flags, unsigned short tx_len) {
+    UNUSED(channel_and_flags);
+    if (tx_len > sizeof(sim_reply.data)) {
+        tx_len = sizeof(sim_reply.data);
+    }
+    MEMCPY(sim_reply.data, G_io_apdu_buffer, tx_len);
+    sim_reply.len = tx_len;
+    sim_reply.sent = true;
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+// View
+
+void view_init(void) {}
+
+void view_idle_show(uint8_t item_idx, const char *statusString) {
+    UNUSED(item_idx);
+    UNUSED(statusString);
+}
+
+void view_review_init(viewfunc_getItem_t viewfuncGetItem, viewfunc_getNumItems_t viewfuncGetNumItems,
+                      viewfunc_accept_t viewfuncAccept) {
+    sim_review.getItem = viewfuncGetItem;
+    sim_review.getNumItems = viewfuncGetNumItems;
+    sim_review.accept = viewfuncAccept;
+}
+
+void view_review_show(review_type_e reviewKind) {
+    sim_review.kind = reviewKind;
+    sim_review.pending = true;
+}
+
+void view_blindsign_error_show(void) { sim_blindsign_error = true; }
+
+/////////////////////////////////////////////////////////////////////
+// Crypto
+
+cx_err_t cx_sha256_init_no_throw(cx_sha256_t *hash) {
+    if (hash == NULL) {
+        return CX_INVALID_PARAMETER;
+    }
+    hash->header.algo = CX_SHA256;
+    host_sha256_init(&hash->state);
+    return CX_OK;
+}
+
+cx_err_t cx_keccak_init_no_throw(cx_sha3_t *hash, size_t size) {
+    if (hash == NULL || size != 256) {
+        return CX_INVALID_PARAMETER;
+    }
+    hash->header.algo = CX_KECCAK;
+    host_keccak256_init(&hash->state);
+    return CX_OK;
+}
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash, uint32_t mode, const uint8_t *in, size_t len, uint8_t *out, size_t out_len) {
+    if (hash == NULL || (in == NULL && len > 0)) {
+        return CX_INVALID_PARAMETER;
+    }
+
+    switch (hash->algo) {
+        case CX_SHA256: {
+            cx_sha256_t *ctx = (cx_sha256_t *)hash;
+            host_sha256_update(&ctx->state, in, len);
+            if (mode & CX_LAST) {
+                if (out == NULL || out_len < HOST_SHA256_SIZE) {
+                    return CX_INVALID_PARAMETER;
+                }
+                host_sha256_final(&ctx->state, out);
+            }
+            return CX_OK;
+        }
+        case CX_KECCAK: {
+            cx_sha3_t *ctx = (cx_sha3_t *)hash;
+            host_keccak256_update(&ctx->state, in, len);
+            if (mode & CX_LAST) {
+                if (out == NULL || out_len < HOST_KECCAK256_SIZE) {
+                    return CX_INVALID_PARAMETER;
+                }
+                host_keccak256_final(&ctx->state, out);
+            }
+            return CX_OK;
+        }
+        default:
+            return CX_INVALID_PARAMETER;
+    }
+}
+
+cx_err_t os_derive_bip32_with_seed_no_throw(unsigned int derivation_mode, cx_curve_t curve, const uint32_t *path,
+                                            size_t path_len, uint8_t raw_privkey[64], uint8_t *chain_code,
+                                            const unsigned char *seed_key, unsigned int seed_key_length) {
+    UNUSED(seed_key_length);
+    if (derivation_mode != HDW_NORMAL || curve != CX_CURVE_256K1 || seed_key != NULL || path == NULL ||
+        raw_privkey == NULL || path_len > 10 || !test_seed_ready) {
+        return CX_INVALID_PARAMETER;
+    }
+
+    MEMZERO(raw_privkey, 64);
+    if (host_bip32_derive(test_seed, sizeof(test_seed), path, (uint8_t)path_len, raw_privkey, chain_code) != zxerr_ok) {
+        return CX_INTERNAL_ERROR;
+    }
+    return CX_OK;
+}
+
+cx_err_t cx_ecfp_init_private_key_no_throw(cx_curve_t curve, const uint8_t *rawkey, size_t key_len,
+                                           cx_ecfp_private_key_t *pvkey) {
+    if (curve != CX_CURVE_256K1 || pvkey == NULL || rawkey == NULL || key_len != HOST_SECP256K1_SK_LEN) {
+        return CX_INVALID_PARAMETER;
+    }
+    pvkey->curve = curve;
+    pvkey->d_len = key_len;
+    MEMCPY(pvkey->d, rawkey, key_len);
+    return CX_OK;
+}
+
+cx_err_t cx_ecfp_init_public_key_no_throw(cx_curve_t curve, const uint8_t *rawkey, size_t key_len,
+                                          cx_ecfp_public_key_t *key) {
+    if (curve != CX_CURVE_256K1 || key == NULL || key_len > sizeof(key->W) || (rawkey == NULL && key_len > 0)) {
+        return CX_INVALID_PARAMETER;
+    }
+    MEMZERO(key, sizeof(*key));
+    key->curve = curve;
+    key->W_len = key_len;
+    if (key_len > 0) {
+        MEMCPY(key->W, rawkey, key_len);
+    }
+    return CX_OK;
+}
+
+cx_err_t cx_ecfp_generate_pair_no_throw(cx_curve_t curve, cx_ecfp_public_key_t *pubkey, cx_ecfp_private_key_t *privkey,
+                                        bool keepprivate) {
+    // The simulator never generates fresh private keys
+    if (curve != CX_CURVE_256K1 || pubkey == NULL || privkey == NULL || !keepprivate ||
+        privkey->d_len != HOST_SECP256K1_SK_LEN) {
+        return CX_INVALID_PARAMETER;
+    }
+    if (host_secp256k1_get_pubkey(privkey->d, pubkey->W) != zxerr_ok) {
+        return CX_INTERNAL_ERROR;
+    }
+    pubkey->curve = curve;
+    pubkey->W_len = HOST_SECP256K1_PK_LEN;
+    return CX_OK;
+}
+
+cx_err_t cx_ecdsa_sign_no_throw(const cx_ecfp_private_key_t *pvkey, uint32_t mode, cx_md_t hashID, const uint8_t *hash,
+                                size_t hash_len, uint8_t *sig, size_t *sig_len, uint32_t *info) {
+    UNUSED(hashID);
+    if (pvkey == NULL || pvkey->curve != CX_CURVE_256K1 || (mode & CX_RND_RFC6979) != CX_RND_RFC6979 || hash == NULL ||
+        hash_len > UINT16_MAX || sig == NULL || sig_len == NULL || info == NULL) {
+        return CX_INVALID_PARAMETER;
+    }
+
+    uint16_t derLen = (*sig_len > UINT16_MAX) ? UINT16_MAX : (uint16_t)*sig_len;
+    if (host_secp256k1_sign(pvkey->d, hash, (uint16_t)hash_len, sig, &derLen, info) != zxerr_ok) {
+        return CX_INTERNAL_ERROR;
+    }
+    *sig_len = derLen;
+    return CX_OK;
+}
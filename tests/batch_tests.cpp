@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <parser.h>
+#include <parser_batch.h>
+
+#include <string>
+#include <vector>
+
+#include "app_mode.h"
+#include "gtest/gtest.h"
+#include "utils/common.h"
+
+namespace {
+const char *kTo2 = "sei1zxg7kfwt5wcfr5vjutcvpsgmpnkefyphpa4lkq";
+
+parser_error_t batchAdd(parser_batch_t *batch, const std::string &json) {
+    parser_context_t ctx = {};
+    parser_tx_t tx_obj = {};
+    CHECK_ERROR(parseTx(&ctx, &tx_obj, json))
+    return parser_batch_add(batch, &ctx);
+}
+
+std::vector<std::string> dumpBatch(const parser_batch_t *batch) {
+    std::vector<std::string> answer;
+    uint8_t numItems = 0;
+    if (parser_batch_getNumItems(batch, &numItems) != parser_ok) {
+        return answer;
+    }
+
+    for (uint8_t idx = 0; idx < numItems; idx++) {
+        char key[40];
+        char value[40];
+        uint8_t pageIdx = 0;
+        uint8_t pageCount = 1;
+        while (pageIdx < pageCount) {
+            const parser_error_t err = parser_batch_getItem(batch, idx, key, 39, value, 39, pageIdx, &pageCount);
+            std::string line = std::to_string(idx) + " | " + key;
+            if (pageCount > 1) {
+                line += " [" + std::to_string(pageIdx + 1) + "/" + std::to_string(pageCount) + "]";
+            }
+            line += " : ";
+            line += err == parser_ok ? value : parser_getErrorDescription(err);
+            answer.push_back(line);
+            pageIdx++;
+        }
+    }
+    return answer;
+}
+}  // namespace
+
+TEST(BatchSigning, TotalsPerRecipient) {
+    app_mode_set_expert(false);
+    parser_batch_t batch;
+    parser_batch_init(&batch);
+
+    ASSERT_EQ(batchAdd(&batch, signDoc(msgSend(kTo, coin("1000000")))), parser_ok);
+    ASSERT_EQ(batchAdd(&batch, signDoc(msgSend(kTo2, coin("250000")), coin("20000"))), parser_ok);
+    // Two coins and two messages to the same recipients
+    ASSERT_EQ(batchAdd(&batch, signDoc(msgSend(kTo, coin("1") + "," + coin("2")) + "," + msgSend(kTo2, coin("750000")))),
+              parser_ok);
+
+    const std::vector<std::string> expected = {
+        "0 | Chain ID : pacific-1",
+        "1 | Transactions : 3",
+        "2 | From address [1/2] : sei14ae4g3422thcyuxler2ws3w25fpesrh2uq",
+        "2 | From address [2/2] : mgm9",
+        "3 | Recipient 1 [1/2] : sei1cdvr6tns50wv03ek94ds6vnxh7pl3pmm9a",
+        "3 | Recipient 1 [2/2] : mstu",
+        "4 | Amount 1 : 1.000003 SEI",
+        "5 | Recipient 2 [1/2] : sei1zxg7kfwt5wcfr5vjutcvpsgmpnkefyphpa",
+        "5 | Recipient 2 [2/2] : 4lkq",
+        "6 | Amount 2 : 1 SEI",
+        "7 | Total fees : 0.04 SEI",
+    };
+    EXPECT_EQ(dumpBatch(&batch), expected);
+}
+
+TEST(BatchSigning, RejectsWhatTheSummaryCannotShow) {
+    app_mode_set_expert(false);
+    parser_batch_t batch;
+
+    const std::vector<std::pair<std::string, parser_error_t>> cases = {
+        {signDoc(msgSend(kTo, coin("1"))), parser_ok},
+        {signDoc(msgSend(kTo, coin("1")), coin("1"), "invoice 42"), parser_batch_unsupported_tx},
+        {signDoc(msgSend(kTo, coin("1", "uatom"))), parser_batch_unsupported_tx},
+        {signDoc(msgSend(kTo, coin("1")), coin("1", "uatom")), parser_batch_unsupported_tx},
+        {signDoc(msgSend(kTo, coin("18446744073709551616"))), parser_value_out_of_range},
+        {signDoc(R"({"type":"cosmos-sdk/MsgDelegate","value":{"amount":)" + coin("1") +
+                 R"(,"delegator_address":"sei14ae4g3422thcyuxler2ws3w25fpesrh2uqmgm9","validator_address":"seivaloper1"}})"),
+         parser_batch_unsupported_tx},
+        {signDoc(msgSend(kTo, coin("1"), kTo2)), parser_batch_mismatch},
+        {signDoc(msgSend(kTo, coin("1")), coin("1"), "", "atlantic-2"), parser_batch_mismatch},
+    };
+
+    for (const auto &testcase : cases) {
+        parser_batch_init(&batch);
+        ASSERT_EQ(batchAdd(&batch, signDoc(msgSend(kTo2, coin("5")))), parser_ok);
+        EXPECT_EQ(batchAdd(&batch, testcase.first), testcase.second) << testcase.first;
+    }
+}
+
+TEST(BatchSigning, Limits) {
+    parser_batch_t batch;
+    parser_batch_init(&batch);
+
+    uint8_t numItems = 0;
+    EXPECT_EQ(parser_batch_getNumItems(&batch, &numItems), parser_no_data);
+
+    for (uint8_t i = 0; i < BATCH_MAX_TXS; i++) {
+        ASSERT_EQ(batchAdd(&batch, signDoc(msgSend(kTo, coin("1")))), parser_ok);
+    }
+    EXPECT_EQ(batchAdd(&batch, signDoc(msgSend(kTo, coin("1")))), parser_batch_full);
+
+    // Totals are checked for overflow
+    parser_batch_init(&batch);
+    ASSERT_EQ(batchAdd(&batch, signDoc(msgSend(kTo, coin("18446744073709551615")))), parser_ok);
+    EXPECT_EQ(batchAdd(&batch, signDoc(msgSend(kTo, coin("1")))), parser_value_out_of_range);
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <crypto_cache.h>
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+namespace {
+struct FakeKey {
+    uint8_t pubKey[PK_LEN_SECP256K1_UNCOMPRESSED];
+    uint8_t chainCode[CRYPTO_CACHE_CHAIN_CODE_LEN];
+
+    explicit FakeKey(uint8_t seed) {
+        memset(pubKey, seed, sizeof(pubKey));
+        memset(chainCode, seed ^ 0xFF, sizeof(chainCode));
+    }
+};
+
+uint32_t path_with_index(uint32_t index, uint32_t *path) {
+    path[0] = HDPATH_0_DEFAULT;
+    path[1] = HDPATH_1_DEFAULT;
+    path[2] = HDPATH_2_DEFAULT;
+    path[3] = HDPATH_3_DEFAULT;
+    path[4] = index;
+    return HDPATH_LEN_DEFAULT;
+}
+
+class CryptoCacheTest : public ::testing::Test {
+   protected:
+    void SetUp() override { crypto_cache_reset(); }
+    void TearDown() override { crypto_cache_reset(); }
+};
+
+TEST_F(CryptoCacheTest, MissOnEmptyCache) {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    const uint8_t pathLen = path_with_index(0, path);
+    uint8_t pubKey[PK_LEN_SECP256K1_UNCOMPRESSED] = {0};
+
+    EXPECT_FALSE(crypto_cache_lookup(path, pathLen, pubKey, sizeof(pubKey), nullptr, 0));
+}
+
+TEST_F(CryptoCacheTest, HitReturnsPublicKeyAndChainCode) {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    const uint8_t pathLen = path_with_index(7, path);
+    const FakeKey key(0x42);
+    crypto_cache_store(path, pathLen, key.pubKey, key.chainCode);
+
+    uint8_t pubKey[PK_LEN_SECP256K1_UNCOMPRESSED] = {0};
+    uint8_t chainCode[CRYPTO_CACHE_CHAIN_CODE_LEN] = {0};
+    ASSERT_TRUE(crypto_cache_lookup(path, pathLen, pubKey, sizeof(pubKey), chainCode, sizeof(chainCode)));
+    EXPECT_EQ(memcmp(pubKey, key.pubKey, sizeof(pubKey)), 0);
+    EXPECT_EQ(memcmp(chainCode, key.chainCode, sizeof(chainCode)), 0);
+
+    // Chain code is optional
+    ASSERT_TRUE(crypto_cache_lookup(path, pathLen, pubKey, sizeof(pubKey), nullptr, 0));
+}
+
+TEST_F(CryptoCacheTest, PathLengthIsPartOfTheKey) {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    const uint8_t pathLen = path_with_index(0, path);
+    const FakeKey key(0x01);
+    crypto_cache_store(path, pathLen, key.pubKey, key.chainCode);
+
+    uint8_t pubKey[PK_LEN_SECP256K1_UNCOMPRESSED] = {0};
+    EXPECT_FALSE(crypto_cache_lookup(path, pathLen - 1, pubKey, sizeof(pubKey), nullptr, 0));
+    EXPECT_TRUE(crypto_cache_lookup(path, pathLen, pubKey, sizeof(pubKey), nullptr, 0));
+}
+
+TEST_F(CryptoCacheTest, RejectsShortBuffers) {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    const uint8_t pathLen = path_with_index(0, path);
+    const FakeKey key(0x01);
+    crypto_cache_store(path, pathLen, key.pubKey, key.chainCode);
+
+    uint8_t pubKey[PK_LEN_SECP256K1_UNCOMPRESSED] = {0};
+    uint8_t chainCode[CRYPTO_CACHE_CHAIN_CODE_LEN] = {0};
+    EXPECT_FALSE(crypto_cache_lookup(path, pathLen, pubKey, sizeof(pubKey) - 1, nullptr, 0));
+    EXPECT_FALSE(crypto_cache_lookup(path, pathLen, pubKey, sizeof(pubKey), chainCode, sizeof(chainCode) - 1));
+}
+
+TEST_F(CryptoCacheTest, EvictsLeastRecentlyUsed) {
+    uint32_t paths[CRYPTO_CACHE_ENTRIES + 1][HDPATH_LEN_DEFAULT];
+    uint8_t pubKey[PK_LEN_SECP256K1_UNCOMPRESSED] = {0};
+
+    for (uint32_t i = 0; i < CRYPTO_CACHE_ENTRIES; i++) {
+        const FakeKey key(i);
+        crypto_cache_store(paths[i], path_with_index(i, paths[i]), key.pubKey, key.chainCode);
+    }
+
+    // Touch the first entry so the second one becomes the oldest
+    ASSERT_TRUE(crypto_cache_lookup(paths[0], HDPATH_LEN_DEFAULT, pubKey, sizeof(pubKey), nullptr, 0));
+
+    const FakeKey extra(0xAA);
+    crypto_cache_store(paths[CRYPTO_CACHE_ENTRIES], path_with_index(CRYPTO_CACHE_ENTRIES, paths[CRYPTO_CACHE_ENTRIES]),
+                       extra.pubKey, extra.chainCode);
+
+    EXPECT_TRUE(crypto_cache_lookup(paths[0], HDPATH_LEN_DEFAULT, pubKey, sizeof(pubKey), nullptr, 0));
+    EXPECT_FALSE(crypto_cache_lookup(paths[1], HDPATH_LEN_DEFAULT, pubKey, sizeof(pubKey), nullptr, 0));
+    EXPECT_TRUE(crypto_cache_lookup(paths[CRYPTO_CACHE_ENTRIES], HDPATH_LEN_DEFAULT, pubKey, sizeof(pubKey), nullptr, 0));
+    EXPECT_EQ(memcmp(pubKey, extra.pubKey, sizeof(pubKey)), 0);
+}
+
+TEST_F(CryptoCacheTest, ResetDropsEverything) {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    const uint8_t pathLen = path_with_index(3, path);
+    const FakeKey key(0x33);
+    crypto_cache_store(path, pathLen, key.pubKey, key.chainCode);
+
+    crypto_cache_reset();
+
+    uint8_t pubKey[PK_LEN_SECP256K1_UNCOMPRESSED] = {0};
+    EXPECT_FALSE(crypto_cache_lookup(path, pathLen, pubKey, sizeof(pubKey), nullptr, 0));
+}
+}  // namespace
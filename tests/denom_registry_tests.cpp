@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <denom_registry.h>
+#include <parser_print.h>
+
+#include <cstring>
+#include <string>
+
+#include "coin.h"
+#include "gtest/gtest.h"
+
+namespace {
+std::string formatCoin(const std::string &amount, const std::string &denom) {
+    char out[100] = {0};
+    uint8_t pageCount = 0;
+    EXPECT_EQ(parser_formatCoin(amount.c_str(), amount.size(), denom.c_str(), denom.size(), out, sizeof(out), 0,
+                                &pageCount),
+              parser_ok);
+    return out;
+}
+}  // namespace
+
+TEST(DenomRegistry, EntriesAreSortedByTheirHash) {
+    ASSERT_GT(denom_registry_size(), 0);
+    for (uint16_t i = 0; i < denom_registry_size(); i++) {
+        const denom_info_t *info = denom_registry_get(i);
+        ASSERT_NE(info, nullptr);
+        EXPECT_EQ(info->hash, denom_registry_hash(info->base, strlen(info->base))) << info->base;
+        EXPECT_LT(strlen(info->base), COIN_DENOM_MAXSIZE) << info->base;
+        if (i > 0) {
+            EXPECT_LE(denom_registry_get(i - 1)->hash, info->hash) << info->base;
+        }
+        EXPECT_EQ(denom_registry_lookup(info->base, strlen(info->base)), info) << info->base;
+    }
+    EXPECT_EQ(denom_registry_get(denom_registry_size()), nullptr);
+}
+
+TEST(DenomRegistry, LookupMatchesWholeDenom) {
+    const denom_info_t *info = denom_registry_lookup("usei", 4);
+    ASSERT_NE(info, nullptr);
+    EXPECT_STREQ(info->symbol, COIN_DEFAULT_DENOM_REPR);
+    EXPECT_EQ(info->exponent, COIN_DEFAULT_DENOM_FACTOR);
+
+    EXPECT_EQ(denom_registry_lookup("usei", 3), nullptr);
+    EXPECT_EQ(denom_registry_lookup("useix", 5), nullptr);
+    EXPECT_EQ(denom_registry_lookup("USEI", 4), nullptr);
+    EXPECT_EQ(denom_registry_lookup("", 0), nullptr);
+}
+
+TEST(DenomRegistry, IbcDenomsUseTheirChannelHash) {
+    // ibc/ + SHA-256 of transfer/channel-45/uusdc, USDC from Noble
+    const std::string usdc = "ibc/CA6FBFAF399474A06263E10D0CE5AEBBE15189D6D4B2DD9ADE61007E68EB9DB0";
+    const denom_info_t *info = denom_registry_lookup(usdc.c_str(), usdc.size());
+    ASSERT_NE(info, nullptr);
+    EXPECT_STREQ(info->symbol, "USDC");
+    EXPECT_EQ(info->exponent, 6);
+
+    std::string lower = usdc;
+    lower[4] = 'c';
+    EXPECT_EQ(denom_registry_lookup(lower.c_str(), lower.size()), nullptr);
+}
+
+TEST(DenomRegistry, FormatsRegisteredDenomsOnly) {
+    EXPECT_EQ(formatCoin("1500000", "usei"), "1.5 SEI");
+    EXPECT_EQ(formatCoin("1", "usei"), "0.000001 SEI");
+    EXPECT_EQ(formatCoin("2500000", "ibc/CA6FBFAF399474A06263E10D0CE5AEBBE15189D6D4B2DD9ADE61007E68EB9DB0"), "2.5 USDC");
+    EXPECT_EQ(formatCoin("1500000", "useix"), "1500000 useix");
+    EXPECT_EQ(formatCoin("1500000", "uatom"), "1500000 uatom");
+}
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <coin.h>
+#include <crypto.h>
+#include <crypto_helper.h>
+#include <hexutils.h>
+#include <host_hash.h>
+#include <host_secp256k1.h>
+#include <zxformat.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace {
+// Values expected by the zemu tests for m/44'/60'/0'/0'/5 and the test mnemonic
+const char EXPECTED_ETH_PK[] =
+    "044f1dd50f180bfd546339e75410b127331469837fa618d950f7cfb8be351b002035e2b0343bcf8bba5874b9c6c9311de5911d471e896b1f17f"
+    "10137842a2265b0";
+const char EXPECTED_ETH_ADDRESS[] = "cadff9350e9548bc68cb1e44d744bd9a801d5a5b";
+const char EXPECTED_ADDRESS[] = "sei1zxg7kfwt5wcfr5vjutcvpsgmpnkefyphpa4lkq";
+const uint32_t TEST_PATH[HDPATH_LEN_DEFAULT] = {HDPATH_0_DEFAULT, HDPATH_1_DEFAULT, HDPATH_2_DEFAULT, 0x80000000u, 5};
+
+std::string to_hex(const uint8_t *data, size_t len) {
+    char out[2 * 256 + 1] = {0};
+    array_to_hexstr(out, sizeof(out), data, len);
+    return std::string(out);
+}
+
+void derive_test_key(uint8_t *sk) {
+    uint8_t seed[HOST_BIP39_SEED_LEN];
+    host_bip39_seed(HOST_TEST_MNEMONIC, "", seed);
+    ASSERT_EQ(host_bip32_derive(seed, sizeof(seed), TEST_PATH, HDPATH_LEN_DEFAULT, sk, nullptr), zxerr_ok);
+}
+
+TEST(HostCrypto, Sha256) {
+    uint8_t digest[32];
+    ASSERT_EQ(crypto_sha256((const uint8_t *)"abc", 3, digest, sizeof(digest)), zxerr_ok);
+    EXPECT_EQ(to_hex(digest, sizeof(digest)), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
+
+TEST(HostCrypto, Keccak256) {
+    uint8_t digest[32];
+    host_keccak256(nullptr, 0, digest);
+    EXPECT_EQ(to_hex(digest, sizeof(digest)), "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+
+    ASSERT_EQ(keccak_digest((const uint8_t *)"abc", 3, digest, sizeof(digest)), zxerr_ok);
+    EXPECT_EQ(to_hex(digest, sizeof(digest)), "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+}
+
+TEST(HostCrypto, Ripemd160) {
+    uint8_t digest[HOST_RIPEMD160_SIZE];
+    host_ripemd160((const uint8_t *)"abc", 3, digest);
+    EXPECT_EQ(to_hex(digest, sizeof(digest)), "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc");
+}
+
+TEST(HostCrypto, DerivesZemuTestKeys) {
+    uint8_t sk[HOST_SECP256K1_SK_LEN];
+    derive_test_key(sk);
+
+    uint8_t pk[HOST_SECP256K1_PK_LEN];
+    ASSERT_EQ(host_secp256k1_get_pubkey(sk, pk), zxerr_ok);
+    EXPECT_EQ(to_hex(pk, sizeof(pk)), EXPECTED_ETH_PK);
+
+    uint8_t hash[32];
+    ASSERT_EQ(keccak_digest(pk + 1, sizeof(pk) - 1, hash, sizeof(hash)), zxerr_ok);
+    EXPECT_EQ(to_hex(hash + 12, 20), EXPECTED_ETH_ADDRESS);
+
+    uint8_t compressed[PK_LEN_SECP256K1];
+    memcpy(compressed, pk, sizeof(compressed));
+    compressed[0] = (pk[64] & 1) ? 0x03 : 0x02;
+    char address[SECP256K1_ADDR_MAX_LEN] = {0};
+    ASSERT_GT(crypto_encodePubkey(compressed, address, sizeof(address)), 0);
+    EXPECT_STREQ(address, EXPECTED_ADDRESS);
+}
+
+TEST(HostCrypto, DeterministicSignature) {
+    uint8_t sk[HOST_SECP256K1_SK_LEN];
+    derive_test_key(sk);
+
+    uint8_t digest[32];
+    ASSERT_EQ(crypto_sha256((const uint8_t *)"hello", 5, digest, sizeof(digest)), zxerr_ok);
+
+    uint8_t der[HOST_SECP256K1_DER_MAX_LEN];
+    uint16_t derLen = sizeof(der);
+    uint32_t info = 0;
+    ASSERT_EQ(host_secp256k1_sign(sk, digest, sizeof(digest), der, &derLen, &info), zxerr_ok);
+
+    // RFC6979 makes the signature reproducible, low-S form
+    EXPECT_EQ(to_hex(der, derLen),
+              "3044022061efc88bda92897c70a65988d170b182a3124697cb0af8510c9f93662a7b3fd90220201f4d566ad395665c81be3415b37c13"
+              "0beadda1d92c7cc54b10b909d9059ecb");
+    EXPECT_EQ(info, 0u);
+}
+}  // namespace
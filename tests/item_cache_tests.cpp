@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <item_cache.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace {
+constexpr uint16_t kValLen = 18;
+
+class ItemCacheTest : public ::testing::Test {
+   protected:
+    void SetUp() override { item_cache_reset(); }
+    void TearDown() override { item_cache_reset(); }
+
+    // Returns "key|value|pageCount", or "miss"
+    static std::string lookup(uint8_t displayIdx, bool expert, uint8_t pageIdx, uint16_t valLen = kValLen) {
+        char key[ITEM_CACHE_KEY_SIZE];
+        char val[ITEM_CACHE_VALUE_SIZE + 1];
+        uint8_t pageCount = 0;
+        if (!item_cache_lookup(displayIdx, expert, key, sizeof(key), val, valLen, pageIdx, &pageCount)) {
+            return "miss";
+        }
+        return std::string(key) + "|" + val + "|" + std::to_string(pageCount);
+    }
+};
+
+TEST_F(ItemCacheTest, MissOnEmptyCache) { EXPECT_EQ(lookup(0, false, 0), "miss"); }
+
+TEST_F(ItemCacheTest, ServesStoredPages) {
+    item_cache_store(3, false, "Memo", "first page here..", kValLen, 0, 3);
+    item_cache_store(3, false, "Memo", "second", kValLen, 1, 3);
+    item_cache_store(3, false, "Memo", "", kValLen, 2, 3);
+
+    EXPECT_EQ(lookup(3, false, 1), "Memo|second|3");
+    EXPECT_EQ(lookup(3, false, 0), "Memo|first page here..|3");
+    EXPECT_EQ(lookup(3, false, 2), "Memo||3");
+    EXPECT_EQ(lookup(3, false, 3), "miss");
+}
+
+TEST_F(ItemCacheTest, KeepsOnlyPagesInOrder) {
+    item_cache_store(1, false, "Msg", "page 1", kValLen, 1, 3);
+    EXPECT_EQ(lookup(1, false, 1), "miss");
+
+    item_cache_store(1, false, "Msg", "page 0", kValLen, 0, 3);
+    item_cache_store(1, false, "Msg", "page 2", kValLen, 2, 3);
+    EXPECT_EQ(lookup(1, false, 0), "Msg|page 0|3");
+    EXPECT_EQ(lookup(1, false, 2), "miss");
+}
+
+TEST_F(ItemCacheTest, ExpertModeAndPageSizeArePartOfTheKey) {
+    item_cache_store(2, false, "Fee", "0.01 SEI", kValLen, 0, 1);
+
+    EXPECT_EQ(lookup(2, true, 0), "miss");
+    EXPECT_EQ(lookup(2, false, 0, kValLen + 1), "miss");
+    EXPECT_EQ(lookup(2, false, 0), "Fee|0.01 SEI|1");
+}
+
+TEST_F(ItemCacheTest, StopsWhenTheValueDoesNotFit) {
+    // Four pages are a few bytes more than an entry holds
+    const std::string page(ITEM_CACHE_VALUE_SIZE / 4 + 1, 'x');
+    const uint16_t valLen = page.size() + 1;
+    for (uint8_t i = 0; i < 4; i++) {
+        item_cache_store(0, false, "Msg", page.c_str(), valLen, i, 4);
+    }
+
+    EXPECT_EQ(lookup(0, false, 2, valLen), "Msg|" + page + "|4");
+    EXPECT_EQ(lookup(0, false, 3, valLen), "miss");
+}
+
+TEST_F(ItemCacheTest, EvictsLeastRecentlyUsed) {
+    for (uint8_t i = 0; i < ITEM_CACHE_ENTRIES; i++) {
+        item_cache_store(i, false, "Key", "value", kValLen, 0, 1);
+    }
+
+    // Touch the first entry so the second one becomes the oldest
+    ASSERT_NE(lookup(0, false, 0), "miss");
+
+    item_cache_store(ITEM_CACHE_ENTRIES, false, "Extra", "value", kValLen, 0, 1);
+
+    EXPECT_NE(lookup(0, false, 0), "miss");
+    if (ITEM_CACHE_ENTRIES > 1) {
+        EXPECT_EQ(lookup(1, false, 0), "miss");
+    }
+    EXPECT_EQ(lookup(ITEM_CACHE_ENTRIES, false, 0), "Extra|value|1");
+}
+
+TEST_F(ItemCacheTest, ResetDropsEverything) {
+    item_cache_store(0, false, "Key", "value", kValLen, 0, 1);
+
+    item_cache_reset();
+
+    EXPECT_EQ(lookup(0, false, 0), "miss");
+}
+}  // namespace
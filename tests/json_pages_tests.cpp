@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <json_pages.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace {
+// Renders every page of span with pages of outLen - 1 characters and returns them joined
+std::string renderAll(json_pages_t *pages, const std::string &span, uint16_t outLen, uint8_t *pageCount) {
+    std::string joined;
+    char out[300] = {0};
+    uint8_t idx = 0;
+    do {
+        EXPECT_EQ(json_pages_render(pages, span.c_str(), span.size(), out, outLen, idx, pageCount), parser_ok);
+        joined += out;
+        idx++;
+    } while (idx < *pageCount);
+    return joined;
+}
+}  // namespace
+
+TEST(JsonPages, DropsWhitespaceOutsideStrings) {
+    json_pages_t pages = {};
+    uint8_t pageCount = 0;
+    const std::string span = "{ \"increment\" : {},\n  \"a b\": \"x  y\", \"k\": [1, 2], \"e\": \"q\\\"  :\" }";
+    EXPECT_EQ(renderAll(&pages, span, 200, &pageCount),
+              "{\"increment\":{},\"a b\":\"x  y\",\"k\":[1,2],\"e\":\"q\\\"  :\"}");
+    EXPECT_EQ(pageCount, 1);
+}
+
+TEST(JsonPages, PagesJoinToTheCompactText) {
+    std::string span = "{\"contract\": {\"recipients\": [";
+    for (int i = 0; i < 6; i++) {
+        span += "{\"addr\": \"sei1qwerty" + std::to_string(i) + "\", \"amount\": \"" + std::to_string(i * 7) + "\"},";
+    }
+    span += "{}]}}";
+
+    json_pages_t pages = {};
+    uint8_t pageCount = 0;
+    const std::string compact = renderAll(&pages, span, 300, &pageCount);
+    ASSERT_EQ(pageCount, 1);
+
+    for (uint16_t outLen : {2, 7, 18, 40, 64}) {
+        uint8_t count = 0;
+        EXPECT_EQ(renderAll(&pages, span, outLen, &count), compact) << outLen;
+        EXPECT_EQ(count, (compact.size() + outLen - 2) / (outLen - 1)) << outLen;
+    }
+}
+
+TEST(JsonPages, PagesCanBeReadInAnyOrder) {
+    std::string span = "[";
+    for (int i = 0; i < 200; i++) {
+        span += "\"v" + std::to_string(i) + "\", ";
+    }
+    span += "0]";
+
+    json_pages_t pages = {};
+    uint8_t pageCount = 0;
+    const std::string compact = renderAll(&pages, span, 11, &pageCount);
+    ASSERT_GT(pageCount, 64);
+
+    char out[11] = {0};
+    for (int idx = pageCount - 1; idx >= 0; idx -= 3) {
+        ASSERT_EQ(json_pages_render(&pages, span.c_str(), span.size(), out, sizeof(out), idx, &pageCount), parser_ok);
+        EXPECT_EQ(std::string(out), compact.substr(idx * 10, 10)) << idx;
+    }
+    EXPECT_EQ(json_pages_render(&pages, span.c_str(), span.size(), out, sizeof(out), pageCount, &pageCount),
+              parser_display_page_out_of_range);
+}
+
+TEST(JsonPages, PagesKeepTheStringState) {
+    // Page boundaries fall inside strings and right after their escapes
+    const std::string span = "{ \"a b\" : \"x \\\"  y\\\\\" , \"k\" : [ 1 ,\t2 ] }";
+    json_pages_t pages = {};
+    uint8_t pageCount = 0;
+    const std::string compact = renderAll(&pages, span, 200, &pageCount);
+    EXPECT_EQ(compact, "{\"a b\":\"x \\\"  y\\\\\",\"k\":[1,2]}");
+
+    for (uint16_t outLen : {2, 3, 4, 5}) {
+        uint8_t count = 0;
+        EXPECT_EQ(renderAll(&pages, span, outLen, &count), compact) << outLen;
+    }
+}
+
+TEST(JsonPages, RefusesMoreThan255Pages) {
+    json_pages_t pages = {};
+    uint8_t pageCount = 0;
+    char out[11] = {0};
+
+    const std::string fits(255 * 10, '1');
+    EXPECT_EQ(json_pages_render(&pages, fits.c_str(), fits.size(), out, sizeof(out), 254, &pageCount), parser_ok);
+    EXPECT_EQ(pageCount, 255);
+
+    const std::string tooLong(255 * 10 + 1, '1');
+    EXPECT_EQ(json_pages_render(&pages, tooLong.c_str(), tooLong.size(), out, sizeof(out), 0, &pageCount),
+              parser_value_out_of_range);
+    EXPECT_EQ(pageCount, 0);
+    EXPECT_FALSE(pages.valid);
+}
+
+TEST(JsonPages, EmptyTextIsOnePage) {
+    json_pages_t pages = {};
+    uint8_t pageCount = 0;
+    char out[11] = {0};
+    const std::string span = " \n ";
+    EXPECT_EQ(json_pages_render(&pages, span.c_str(), span.size(), out, sizeof(out), 0, &pageCount), parser_ok);
+    EXPECT_EQ(pageCount, 1);
+    EXPECT_STREQ(out, "");
+}
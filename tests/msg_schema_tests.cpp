@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <msg_schema.h>
+#include <parser.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/common.h"
+
+namespace {
+std::string msgMultiSend(const std::string &amount) {
+    return R"({"type":"cosmos-sdk/MsgMultiSend","value":{"inputs":[{"address":")" + std::string(kFrom) +
+           R"(","coins":)" + coins(amount) + R"(}],"outputs":[{"address":")" + kTo + R"(","coins":)" + coins(amount) +
+           R"(}]}})";
+}
+
+std::string msgExec(const std::string &msgs) {
+    return R"({"type":"cosmos-sdk/MsgExec","value":{"grantee":")" + std::string(kTo) + R"(","msgs":[)" + msgs + R"(]}})";
+}
+
+std::vector<std::string> itemsOf(const std::string &msgs) { return txItems(signDoc(msgs), 80); }
+
+bool contains(const std::vector<std::string> &items, const std::string &item) {
+    return std::find(items.begin(), items.end(), item) != items.end();
+}
+}  // namespace
+
+TEST(MsgSchema, FindMatchesWholeType) {
+    const uint8_t idx = msg_schema_find("cosmos-sdk/MsgMultiSend", strlen("cosmos-sdk/MsgMultiSend"));
+    ASSERT_NE(idx, MSG_SCHEMA_UNKNOWN);
+    EXPECT_EQ(msg_schema_get(idx)->display_level, 3);
+    EXPECT_TRUE(msg_schema_isAmountField(msg_schema_get(idx), "inputs/coins"));
+    EXPECT_FALSE(msg_schema_isAmountField(msg_schema_get(idx), "outputs/coins"));
+
+    EXPECT_EQ(msg_schema_find("cosmos-sdk/MsgSend", strlen("cosmos-sdk/MsgSen")), MSG_SCHEMA_UNKNOWN);
+    EXPECT_EQ(msg_schema_find("cosmos-sdk/MsgSendX", strlen("cosmos-sdk/MsgSendX")), MSG_SCHEMA_UNKNOWN);
+    EXPECT_EQ(msg_schema_find(nullptr, 0), MSG_SCHEMA_UNKNOWN);
+
+    const msg_schema_t *unknown = msg_schema_get(UINT8_MAX);
+    EXPECT_EQ(unknown, msg_schema_get(MSG_SCHEMA_UNKNOWN));
+    EXPECT_EQ(unknown->display_level, MSG_SCHEMA_DEFAULT_LEVEL);
+    EXPECT_FALSE(msg_schema_isAmountField(unknown, "amount"));
+}
+
+TEST(MsgSchema, EachMessageKeepsItsOwnLevel) {
+    // The level of MultiSend used to follow the last type printed, whatever message came next
+    const auto items = itemsOf(msgMultiSend("5") + "," + msgSend(kTo, coin("7")) + "," + msgMultiSend("9"));
+    EXPECT_EQ(std::count(items.begin(), items.end(), std::string("Src Address : ") + kFrom), 2);
+    EXPECT_TRUE(contains(items, "Src Coins : 0.000009 SEI"));
+    EXPECT_TRUE(contains(items, "Amount : 0.000007 SEI"));
+    EXPECT_TRUE(contains(items, "Total : 0.010021 SEI"));
+}
+
+TEST(MsgSchema, ExecShowsTheMessagesItWraps) {
+    const auto items =
+        itemsOf(msgExec(msgSend(kTo, coin("5"))) + "," + msgSend(kTo, coin("7")) + "," + msgSend(kTo, coin("8")));
+    EXPECT_TRUE(contains(items, "Type : cosmos-sdk/MsgExec"));
+    EXPECT_TRUE(contains(items, std::string("Grantee : ") + kTo));
+    EXPECT_TRUE(contains(items, "Authz type : cosmos-sdk/MsgSend"));
+    EXPECT_TRUE(contains(items, "Authz amount : 0.000005 SEI"));
+    EXPECT_TRUE(contains(items, std::string("Authz from : ") + kFrom));
+    EXPECT_TRUE(contains(items, std::string("Authz to : ") + kTo));
+
+    // What the grantee executes is spent by the granter, not by the signer
+    EXPECT_TRUE(contains(items, "Total : 0.010015 SEI"));
+}
+
+TEST(MsgSchema, NestingIsBounded) {
+    const auto items = itemsOf(msgExec(msgExec(msgSend(kTo, coin("5")))));
+    EXPECT_TRUE(contains(items, "Authz type : cosmos-sdk/MsgExec"));
+    EXPECT_TRUE(contains(items, std::string("Authz grantee : ") + kTo));
+
+    // Messages wrapped twice are shown as they are in the transaction
+    const std::string inner = "Authz msgs";
+    EXPECT_TRUE(std::any_of(items.begin(), items.end(), [&](const std::string &item) {
+        return item.rfind(inner, 0) == 0 && item.find("cosmos-sdk/MsgSend") != std::string::npos;
+    }));
+}
+
+TEST(MsgSchema, NestedKeysAreNotCut) {
+    const std::string delegate = R"({"type":"cosmos-sdk/MsgDelegate","value":{"amount":)" + coin("5") +
+                                 R"(,"delegator_address":"sei1granter","validator_address":"seivaloper1xyz"}})";
+    const auto items = itemsOf(msgExec(delegate));
+    EXPECT_TRUE(contains(items, "Authz amount : 0.000005 SEI"));
+    EXPECT_TRUE(contains(items, "Authz delegator : sei1granter"));
+    EXPECT_TRUE(contains(items, "Authz validator : seivaloper1xyz"));
+}
+
+TEST(MsgSchema, NestedContractHasLabels) {
+    const std::string execute = R"({"type":"wasm/MsgExecuteContract","value":{"contract":"sei1contract","funds":[)" +
+                                coin("5") + R"(],"msg":{"increment":{}},"sender":")" + kFrom + R"("}})";
+    const auto items = itemsOf(msgExec(execute));
+    EXPECT_TRUE(contains(items, "Authz contract : sei1contract"));
+    EXPECT_TRUE(contains(items, R"(Authz funds : [{"amount":"5","denom":"usei"}])"));
+    EXPECT_TRUE(contains(items, R"(Authz msg : {"increment":{}})"));
+    EXPECT_TRUE(contains(items, std::string("Authz sender : ") + kFrom));
+}
+
+TEST(MsgSchema, KeysThatDoNotFitAreRefused) {
+    const std::string field(60, 'k');
+    const std::string msg = R"({"type":"custom/MsgLongKey","value":{")" + field + R"(":"1"}})";
+    parser_context_t ctx = {};
+    parser_tx_t tx_obj = {};
+    EXPECT_EQ(parseTx(&ctx, &tx_obj, signDoc(msg)), parser_display_key_too_long);
+}
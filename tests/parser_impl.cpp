@@ -31,6 +31,7 @@ using namespace std;
 
 TEST(SCALE, ReadBytes) {
     parser_context_t ctx;
+    parser_tx_t tx_obj;
     parser_error_t err;
     uint8_t buffer[100];
     auto bufferLen = parseHexString(buffer, sizeof(buffer),
@@ -38,7 +39,7 @@ TEST(SCALE, ReadBytes) {
                                     "123456"
                                     "12345678901234567890");
 
-    parser_parse(&ctx, buffer, bufferLen);
+    parser_parse(&ctx, buffer, bufferLen, &tx_obj);
 
     // uint8_t bytesArray[100] = {0};
     // err = _readBytes(&ctx, bytesArray, 1);
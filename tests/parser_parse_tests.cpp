@@ -25,22 +25,23 @@
 namespace {
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "ConstantParameter"
-parser_error_t parser_traverse(int16_t root_token_index, uint8_t *numChunks) {
+parser_error_t parser_traverse(parser_tx_t *tx_obj, int16_t root_token_index, uint8_t *numChunks) {
     uint16_t ret_value_token_index = 0;
-    const parser_error_t err = parser_traverse_find(root_token_index, &ret_value_token_index);
+    const parser_error_t err = parser_traverse_find(tx_obj, root_token_index, &ret_value_token_index);
 
     if (err != parser_ok) {
         return err;
     }
 
-    return parser_getToken(ret_value_token_index, parser_tx_obj.query.out_val, parser_tx_obj.query.out_val_len,
-                           parser_tx_obj.query.page_index, numChunks);
+    return parser_getToken(tx_obj, ret_value_token_index, tx_obj->query.out_val, tx_obj->query.out_val_len,
+                           tx_obj->query.page_index, numChunks);
 }
 #pragma clang diagnostic pop
 
 TEST(TxParse, parser_traverse) {
     auto transaction = R"({"keyA":"123456", "keyB":"abcdefg", "keyC":""})";
 
+    parser_tx_t parser_tx_obj = {};
     parser_tx_obj.tx = transaction;
     parser_tx_obj.flags.cache_valid = false;
     parser_error_t err = JSON_PARSE(&parser_tx_obj.json, parser_tx_obj.tx);
@@ -59,53 +60,100 @@ TEST(TxParse, parser_traverse) {
     uint8_t numChunks;
 
     // Try second key - first chunk
-    INIT_QUERY_CONTEXT(key, sizeof(key), val, sizeof(val), 0, 4)
+    INIT_QUERY_CONTEXT(&parser_tx_obj, key, sizeof(key), val, sizeof(val), 0, 4)
     parser_tx_obj.query.item_index = 1;
 
-    err = parser_traverse(0, &numChunks);
+    err = parser_traverse(&parser_tx_obj, 0, &numChunks);
     EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
     EXPECT_EQ(numChunks, 1) << "Incorrect number of chunks";
     EXPECT_EQ_STR(key, "keyB", "Incorrect key")
     EXPECT_EQ_STR(val, "abcdefg", "Incorrect value")
 
     // Try second key - Second chunk
-    INIT_QUERY_CONTEXT(key, sizeof(key), val, sizeof(val), 1, 4)
+    INIT_QUERY_CONTEXT(&parser_tx_obj, key, sizeof(key), val, sizeof(val), 1, 4)
     parser_tx_obj.query.item_index = 1;
-    err = parser_traverse(0, &numChunks);
+    err = parser_traverse(&parser_tx_obj, 0, &numChunks);
     EXPECT_EQ(err, parser_display_page_out_of_range) << parser_getErrorDescription(err);
     EXPECT_EQ(numChunks, 1) << "Incorrect number of chunks";
 
     // Find first key
-    INIT_QUERY_CONTEXT(key, sizeof(key), val, sizeof(val), 0, 4)
+    INIT_QUERY_CONTEXT(&parser_tx_obj, key, sizeof(key), val, sizeof(val), 0, 4)
     parser_tx_obj.query.item_index = 0;
-    err = parser_traverse(0, &numChunks);
+    err = parser_traverse(&parser_tx_obj, 0, &numChunks);
     EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
     EXPECT_EQ(numChunks, 1) << "Incorrect number of chunks";
     EXPECT_EQ_STR(key, "keyA", "Incorrect key")
     EXPECT_EQ_STR(val, "123456", "Incorrect value")
 
     // Try the same again
-    INIT_QUERY_CONTEXT(key, sizeof(key), val, sizeof(val), 0, 4)
+    INIT_QUERY_CONTEXT(&parser_tx_obj, key, sizeof(key), val, sizeof(val), 0, 4)
     parser_tx_obj.query.item_index = 0;
-    err = parser_traverse(0, &numChunks);
+    err = parser_traverse(&parser_tx_obj, 0, &numChunks);
     EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
     EXPECT_EQ(numChunks, 1) << "Incorrect number of chunks";
     EXPECT_EQ_STR(key, "keyA", "Incorrect key")
     EXPECT_EQ_STR(val, "123456", "Incorrect value")
 
     // Try last key
-    INIT_QUERY_CONTEXT(key, sizeof(key), val, sizeof(val), 0, 4)
+    INIT_QUERY_CONTEXT(&parser_tx_obj, key, sizeof(key), val, sizeof(val), 0, 4)
     parser_tx_obj.query.item_index = 2;
-    err = parser_traverse(0, &numChunks);
+    err = parser_traverse(&parser_tx_obj, 0, &numChunks);
     EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
     EXPECT_EQ(numChunks, 1) << "Incorrect number of chunks";
     EXPECT_EQ_STR(key, "keyC", "Incorrect key")
     EXPECT_EQ_STR(val, "", "Incorrect value")
 }
 
+TEST(TxParse, parser_traverse_resume) {
+    auto transaction =
+        R"({"a":"1","b":{"c":[{"d":"2","e":"3"},{"d":"4"}],"f":"5"},"g":[{"x":"6"},{"x":"7"}],"h":"8"})";
+
+    parser_tx_t parser_tx_obj = {};
+    parser_tx_obj.tx = transaction;
+    parser_tx_obj.flags.cache_valid = false;
+    parser_error_t err = JSON_PARSE(&parser_tx_obj.json, parser_tx_obj.tx);
+    ASSERT_EQ(err, parser_ok);
+
+    const std::vector<std::pair<std::string, std::string>> expected = {
+        {"a", "1"}, {"b/c/d", "2"}, {"b/c/e", "3"}, {"b/c/d", "4"}, {"b/f", "5"}, {"g/x", "6"}, {"g/x", "7"}, {"h", "8"},
+    };
+
+    char key[100];
+    char val[100];
+    uint8_t numChunks;
+
+    // In order, each item twice (as when paging), then backwards, then skipping
+    std::vector<int16_t> order;
+    for (int16_t i = 0; i < (int16_t)expected.size(); i++) {
+        order.push_back(i);
+        order.push_back(i);
+    }
+    for (int16_t i = (int16_t)expected.size() - 1; i >= 0; i--) {
+        order.push_back(i);
+    }
+    order.insert(order.end(), {0, 3, 7, 1, 6});
+
+    for (const int16_t item : order) {
+        INIT_QUERY_CONTEXT(&parser_tx_obj, key, sizeof(key), val, sizeof(val), 0, 4)
+        parser_tx_obj.query.item_index = item;
+        err = parser_traverse(&parser_tx_obj, 0, &numChunks);
+        ASSERT_EQ(err, parser_ok) << "item " << item << ": " << parser_getErrorDescription(err);
+        EXPECT_EQ_STR(key, expected[item].first.c_str(), "Incorrect key")
+        EXPECT_EQ_STR(val, expected[item].second.c_str(), "Incorrect value")
+    }
+
+    // Past the last item, also when continuing from it
+    INIT_QUERY_CONTEXT(&parser_tx_obj, key, sizeof(key), val, sizeof(val), 0, 4)
+    parser_tx_obj.query.item_index = (int16_t)expected.size();
+    err = parser_traverse(&parser_tx_obj, 0, &numChunks);
+    EXPECT_EQ(err, parser_query_no_results) << parser_getErrorDescription(err);
+    EXPECT_EQ_STR(key, "", "Key should be empty")
+}
+
 TEST(TxParse, OutOfBoundsSmall) {
     auto transaction = R"({"keyA":"123456", "keyB":"abcdefg"})";
 
+    parser_tx_t parser_tx_obj = {};
     parser_tx_obj.tx = transaction;
     parser_tx_obj.flags.cache_valid = false;
     parser_error_t err = JSON_PARSE(&parser_tx_obj.json, parser_tx_obj.tx);
@@ -115,13 +163,13 @@ TEST(TxParse, OutOfBoundsSmall) {
     char val[1000];
     uint8_t numChunks;
 
-    INIT_QUERY_CONTEXT(key, sizeof(key), val, sizeof(val), 5, 4)
-    err = parser_traverse(0, &numChunks);
+    INIT_QUERY_CONTEXT(&parser_tx_obj, key, sizeof(key), val, sizeof(val), 5, 4)
+    err = parser_traverse(&parser_tx_obj, 0, &numChunks);
     EXPECT_EQ(err, parser_display_page_out_of_range) << "This call should have resulted in a display out of range";
 
     // We should find it. but later tx_display should fail
-    INIT_QUERY_CONTEXT(key, sizeof(key), val, sizeof(val), 0, 4)
-    err = parser_traverse(0, &numChunks);
+    INIT_QUERY_CONTEXT(&parser_tx_obj, key, sizeof(key), val, sizeof(val), 0, 4)
+    err = parser_traverse(&parser_tx_obj, 0, &numChunks);
     EXPECT_EQ(err, parser_ok);
     EXPECT_EQ(numChunks, 1) << "Item not found";
 }
@@ -129,13 +177,14 @@ TEST(TxParse, OutOfBoundsSmall) {
 TEST(TxParse, Count_Minimal) {
     auto transaction = R"({"account_number":"3"})";
 
+    parser_tx_t parser_tx_obj = {};
     parser_tx_obj.tx = transaction;
     parser_tx_obj.flags.cache_valid = false;
     parser_error_t err = JSON_PARSE(&parser_tx_obj.json, parser_tx_obj.tx);
     EXPECT_EQ(err, parser_ok);
 
-    uint8_t numItems;
-    parser_display_numItems(&numItems);
+    uint16_t numItems;
+    parser_display_numItems(&parser_tx_obj, &numItems);
 
     EXPECT_EQ(1, numItems) << "Wrong number of items";
 }
@@ -144,13 +193,14 @@ TEST(TxParse, Tx_Chain_not_Allowed) {
     auto transaction =
         R"({"account_number":"0","chain_id":"0","fee":{"amount":[{"amount":"5","denom":"photon"}],"gas":"10000"},"memo":"testmemo","msgs":[{"inputs":[{"address":"cosmosaccaddr1d9h8qat5e4ehc5","coins":[{"amount":"10","denom":"atom"}]}],"outputs":[{"address":"cosmosaccaddr1da6hgur4wse3jx32","coins":[{"amount":"10","denom":"atom"}]}]}],"sequence":"1"})";
 
+    parser_tx_t parser_tx_obj = {};
     parser_tx_obj.tx = transaction;
     parser_tx_obj.flags.cache_valid = false;
     parser_error_t err = JSON_PARSE(&parser_tx_obj.json, parser_tx_obj.tx);
     EXPECT_EQ(err, parser_ok);
 
-    uint8_t numItems;
-    parser_error_t err2 = parser_display_numItems(&numItems);
+    uint16_t numItems;
+    parser_error_t err2 = parser_display_numItems(&parser_tx_obj, &numItems);
     EXPECT_EQ(err2, parser_unexpected_chain);
 }
 
@@ -158,13 +208,14 @@ TEST(TxParse, Tx_Page_Count) {
     auto transaction =
         R"({"account_number":"0","chain_id":"test-chain-1","fee":{"amount":[{"amount":"5","denom":"photon"}],"gas":"10000"},"memo":"testmemo","msgs":[{"inputs":[{"address":"cosmosaccaddr1d9h8qat5e4ehc5","coins":[{"amount":"10","denom":"atom"}]}],"outputs":[{"address":"cosmosaccaddr1da6hgur4wse3jx32","coins":[{"amount":"10","denom":"atom"}]}]}],"sequence":"1"})";
 
+    parser_tx_t parser_tx_obj = {};
     parser_tx_obj.tx = transaction;
     parser_tx_obj.flags.cache_valid = false;
     const parser_error_t err = JSON_PARSE(&parser_tx_obj.json, parser_tx_obj.tx);
     EXPECT_EQ(err, parser_ok);
 
-    uint8_t numItems;
-    parser_display_numItems(&numItems);
+    uint16_t numItems;
+    parser_display_numItems(&parser_tx_obj, &numItems);
     EXPECT_EQ(7, numItems) << "Wrong number of items";
 }
 
@@ -172,13 +223,48 @@ TEST(TxParse, Page_Count_MultipleMsgs) {
     auto transaction =
         R"({"account_number":"0","chain_id":"test-chain-1","fee":{"amount":[{"amount":"5","denom":"photon"}],"gas":"10000"},"memo":"testmemo","msgs":[{"inputs":[{"address":"cosmosaccaddr1d9h8qat5e4ehc5","coins":[{"amount":"10","denom":"atom"}]}],"outputs":[{"address":"cosmosaccaddr1da6hgur4wse3jx32","coins":[{"amount":"10","denom":"atom"}]}]},{"inputs":[{"address":"cosmosaccaddr1d9h8qat5e4ehc5","coins":[{"amount":"10","denom":"atom"}]}],"outputs":[{"address":"cosmosaccaddr1da6hgur4wse3jx32","coins":[{"amount":"10","denom":"atom"}]}]},{"inputs":[{"address":"cosmosaccaddr1d9h8qat5e4ehc5","coins":[{"amount":"10","denom":"atom"}]}],"outputs":[{"address":"cosmosaccaddr1da6hgur4wse3jx32","coins":[{"amount":"10","denom":"atom"}]}]},{"inputs":[{"address":"cosmosaccaddr1d9h8qat5e4ehc5","coins":[{"amount":"10","denom":"atom"}]}],"outputs":[{"address":"cosmosaccaddr1da6hgur4wse3jx32","coins":[{"amount":"10","denom":"atom"}]}]}],"sequence":"1"})";
 
+    parser_tx_t parser_tx_obj = {};
     parser_tx_obj.tx = transaction;
     parser_tx_obj.flags.cache_valid = false;
     parser_error_t err = JSON_PARSE(&parser_tx_obj.json, parser_tx_obj.tx);
     EXPECT_EQ(err, parser_ok);
 
-    uint8_t numItems;
-    parser_display_numItems(&numItems);
+    uint16_t numItems;
+    parser_display_numItems(&parser_tx_obj, &numItems);
     EXPECT_EQ(19, numItems) << "Wrong number of items";
 }
+
+// Display indexes past 255 must not wrap around
+TEST(TxParse, Page_Count_MoreThan255Items) {
+    std::string transaction =
+        R"({"account_number":"0","chain_id":"test-chain-1","fee":{"amount":[{"amount":"5","denom":"photon"}],"gas":"10000"},"memo":"testmemo","msgs":[)";
+    for (int i = 0; i < 300; i++) {
+        char field[24];
+        snprintf(field, sizeof(field), R"(%s"f%03d":"%d")", i == 0 ? "{" : ",", i, i);
+        transaction += field;
+    }
+    transaction += R"(}],"sequence":"1"})";
+
+    parser_context_t ctx = {};
+    parser_tx_t parser_tx_obj = {};
+    ASSERT_EQ(parser_parse(&ctx, reinterpret_cast<const uint8_t *>(transaction.c_str()), transaction.size(), &parser_tx_obj),
+              parser_ok);
+    ASSERT_EQ(parser_validate(&ctx), parser_ok);
+
+    uint16_t numItems;
+    ASSERT_EQ(parser_getNumItems(&ctx, &numItems), parser_ok);
+    EXPECT_EQ(303, numItems) << "Wrong number of items";
+
+    char key[40];
+    char val[40];
+    uint8_t pageCount = 0;
+    ASSERT_EQ(parser_getItem(&ctx, 300, key, sizeof(key), val, sizeof(val), 0, &pageCount), parser_ok);
+    EXPECT_STREQ(key, "msgs/f299");
+    EXPECT_STREQ(val, "299");
+
+    ASSERT_EQ(parser_getItem(&ctx, numItems - 1, key, sizeof(key), val, sizeof(val), 0, &pageCount), parser_ok);
+    EXPECT_STREQ(key, "Fee");
+    EXPECT_EQ(parser_getItem(&ctx, numItems, key, sizeof(key), val, sizeof(val), 0, &pageCount),
+              parser_display_idx_out_of_range);
+}
 }  // namespace
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <hexutils.h>
+#include <json/json.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "app_mode.h"
+#include "gmock/gmock.h"
+#include "preview.h"
+#include "utils/common.h"
+
+namespace {
+
+struct vector_t {
+    std::string name;
+    std::vector<uint8_t> blob;
+    std::vector<std::string> expected;
+    std::vector<std::string> expected_expert;
+};
+
+std::vector<vector_t> load_vectors(const std::string &jsonFile, const char *blobField) {
+    const Json::CharReaderBuilder builder;
+    Json::Value obj;
+    std::ifstream inFile(std::string(TESTVECTORS_DIR) + jsonFile);
+    JSONCPP_STRING errs;
+    Json::parseFromStream(builder, inFile, &obj, &errs);
+
+    std::vector<vector_t> answer;
+    for (auto &i : obj) {
+        vector_t v;
+        v.name = i.isMember("name") ? i["name"].asString() : i["description"].asString();
+        const std::string hex = i[blobField].asString();
+        v.blob.resize(hex.size() / 2);
+        v.blob.resize(parseHexString(v.blob.data(), v.blob.size(), hex.c_str()));
+        for (auto &s : i["output"]) {
+            v.expected.push_back(s.asString());
+        }
+        for (auto &s : i["output_expert"]) {
+            v.expected_expert.push_back(s.asString());
+        }
+        answer.push_back(v);
+    }
+    return answer;
+}
+
+// Repeats the vectors so the batch spans several chunks per worker
+std::vector<preview_request_t> make_batch(const std::vector<vector_t> &vectors, preview_kind_e kind, size_t copies) {
+    std::vector<preview_request_t> requests;
+    for (size_t c = 0; c < copies; c++) {
+        for (const auto &v : vectors) {
+            requests.push_back({kind, v.blob.data(), v.blob.size()});
+        }
+    }
+    return requests;
+}
+
+TEST(Preview, AminoBatchMatchesExpectedUI) {
+    const auto vectors = load_vectors("testvectors/amino.json", "blob");
+    ASSERT_FALSE(vectors.empty());
+    const auto requests = make_batch(vectors, preview_kind_e::amino_json, 16);
+
+    preview_pool_t pool(4);
+    for (const bool expert : {false, true}) {
+        preview_options_t options;
+        options.expert = expert;
+        const auto results = pool.run(requests, options);
+
+        ASSERT_EQ(results.size(), requests.size());
+        for (size_t i = 0; i < results.size(); i++) {
+            const auto &v = vectors[i % vectors.size()];
+            EXPECT_EQ(results[i].error, parser_ok) << v.name;
+            EXPECT_EQ(results[i].items, expert ? v.expected_expert : v.expected) << v.name << " expert=" << expert;
+        }
+    }
+}
+
+// EVM vectors are checked against dumpUI run on the calling thread, after the same parse and validate
+TEST(Preview, EvmBatchMatchesDumpUI) {
+    const auto vectors = load_vectors("testvectors/evm.json", "encoded_tx_hex");
+    ASSERT_FALSE(vectors.empty());
+
+    preview_options_t options;
+    options.blindsign = true;
+    app_mode_set_expert(options.expert);
+    app_mode_set_blindsign(options.blindsign);
+
+    std::vector<std::vector<std::string>> reference;
+    for (const auto &v : vectors) {
+        parser_context_t ctx;
+        eth_tx_t eth_tx_obj;
+        ASSERT_EQ(parser_parse_eth(&ctx, v.blob.data(), v.blob.size(), &eth_tx_obj), parser_ok) << v.name;
+        ASSERT_EQ(parser_validate_eth(&ctx), parser_ok) << v.name;
+        reference.push_back(dumpUI(&ctx, options.keyLen, options.valueLen, true));
+    }
+
+    const auto requests = make_batch(vectors, preview_kind_e::evm_rlp, 4);
+    preview_pool_t pool(3);
+    const auto results = pool.run(requests, options);
+
+    ASSERT_EQ(results.size(), requests.size());
+    for (size_t i = 0; i < results.size(); i++) {
+        EXPECT_EQ(results[i].error, parser_ok) << vectors[i % vectors.size()].name;
+        EXPECT_EQ(results[i].items, reference[i % vectors.size()]) << vectors[i % vectors.size()].name;
+    }
+}
+
+TEST(Preview, ReportsErrors) {
+    const std::string notJson = "{\"chain_id\":";
+    const std::vector<uint8_t> tooBig(UINT16_MAX + 1u, '{');
+    const uint8_t notRlp[] = {0xC5, 0x01};
+
+    const std::vector<preview_request_t> requests = {
+        {preview_kind_e::amino_json, nullptr, 0},
+        {preview_kind_e::amino_json, reinterpret_cast<const uint8_t *>(notJson.data()), notJson.size()},
+        {preview_kind_e::amino_json, tooBig.data(), tooBig.size()},
+        {preview_kind_e::evm_rlp, notRlp, sizeof(notRlp)},
+    };
+
+    preview_pool_t pool(2);
+    const auto results = pool.run(requests, preview_options_t());
+    ASSERT_EQ(results.size(), requests.size());
+    EXPECT_EQ(results[0].error, parser_no_data);
+    EXPECT_NE(results[1].error, parser_ok);
+    EXPECT_EQ(results[2].error, parser_transaction_too_big);
+    EXPECT_NE(results[3].error, parser_ok);
+    for (const auto &r : results) {
+        EXPECT_TRUE(r.items.empty());
+    }
+
+    EXPECT_EQ(preview_one(requests[2], preview_options_t()).error, parser_transaction_too_big);
+}
+
+}  // namespace
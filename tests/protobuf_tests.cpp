@@ -0,0 +1,251 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <hexutils.h>
+#include <parser.h>
+#include <parser_pb.h>
+
+#include <string>
+#include <vector>
+
+#include "app_mode.h"
+#include "gtest/gtest.h"
+#include "utils/common.h"
+
+namespace {
+// cosmos.tx.v1beta1.SignDoc of the MsgSend amino test vector (same chain, account, sequence, memo and fee)
+const char *kSignDocMsgSend =
+    "0a96010a89010a1c2f636f736d6f732e62616e6b2e763162657461312e4d736753656e6412690a2a73656931346165346733"
+    "3432327468637975786c6572327773337732356670657372683275716d676d39122a736569316364767236746e7335307776"
+    "3033656b3934647336766e786837706c33706d6d39616d7374751a0f0a047573656912073130303030303012085472616e73"
+    "66657212690a520a460a1f2f636f736d6f732e63727970746f2e736563703235366b312e5075624b657912230a2102111111"
+    "111111111111111111111111111111111111111111111111111111111112040a02080118e59a0b12130a0d0a047573656912"
+    "05313030303010a08d061a0a61746c616e7469632d3220cb09";
+
+// The same transaction in amino JSON
+const char *kAminoMsgSend =
+    "7b226163636f756e745f6e756d626572223a2231323237222c22636861696e5f6964223a2261746c616e7469632d32222c22"
+    "666565223a7b22616d6f756e74223a5b7b22616d6f756e74223a223130303030222c2264656e6f6d223a2275736569227d5d"
+    "2c22676173223a22313030303030227d2c226d656d6f223a225472616e73666572222c226d736773223a5b7b227479706522"
+    "3a22636f736d6f732d73646b2f4d736753656e64222c2276616c7565223a7b22616d6f756e74223a5b7b22616d6f756e7422"
+    "3a2231303030303030222c2264656e6f6d223a2275736569227d5d2c2266726f6d5f61646472657373223a22736569313461"
+    "653467333432327468637975786c6572327773337732356670657372683275716d676d39222c22746f5f6164647265737322"
+    "3a22736569316364767236746e73353077763033656b3934647336766e786837706c33706d6d39616d737475227d7d5d2c22"
+    "73657175656e6365223a22313833363533227d";
+
+// MsgSend and MsgDelegate, fee paid in two denoms
+const char *kSignDocSendDelegate =
+    "0ab0020a89010a1c2f636f736d6f732e62616e6b2e763162657461312e4d736753656e6412690a2a73656931346165346733"
+    "3432327468637975786c6572327773337732356670657372683275716d676d39122a736569316364767236746e7335307776"
+    "3033656b3934647336766e786837706c33706d6d39616d7374751a0f0a04757365691207313030303030300a97010a232f63"
+    "6f736d6f732e7374616b696e672e763162657461312e4d736744656c656761746512700a2a73656931346165346733343232"
+    "7468637975786c6572327773337732356670657372683275716d676d39123173656976616c6f70657231737137783072326d"
+    "663367767772326c39616d746c79653079643363366471613474683935761a0f0a0475736569120732353030303030120854"
+    "72616e7366657212750a520a460a1f2f636f736d6f732e63727970746f2e736563703235366b312e5075624b657912230a21"
+    "02111111111111111111111111111111111111111111111111111111111111111112040a02080118e59a0b121f0a0d0a0475"
+    "736569120531303030300a0a0a057561746f6d12013510a08d061a0a61746c616e7469632d3220cb09";
+
+std::vector<std::string> dumpPb(parser_context_t *ctx) {
+    std::vector<std::string> answer;
+    uint8_t numItems = 0;
+    if (parser_getNumItemsPb(ctx, &numItems) != parser_ok) {
+        return answer;
+    }
+
+    for (uint8_t idx = 0; idx < numItems; idx++) {
+        char key[40];
+        char value[40];
+        uint8_t pageIdx = 0;
+        uint8_t pageCount = 1;
+        while (pageIdx < pageCount) {
+            const parser_error_t err = parser_getItemPb(ctx, idx, key, 39, value, 39, pageIdx, &pageCount);
+            std::string line = std::to_string(idx) + " | " + key;
+            if (pageCount > 1) {
+                line += " [" + std::to_string(pageIdx + 1) + "/" + std::to_string(pageCount) + "]";
+            }
+            line += " : ";
+            line += err == parser_ok ? value : parser_getErrorDescription(err);
+            answer.push_back(line);
+            pageIdx++;
+        }
+    }
+    return answer;
+}
+
+parser_error_t parsePb(const std::string &hex, std::vector<uint8_t> &buffer, parser_context_t *ctx, pb_tx_t *tx_obj) {
+    buffer.resize(hex.size() / 2);
+    const uint16_t bufferLen = parseHexString(buffer.data(), buffer.size(), hex.c_str());
+    CHECK_ERROR(parser_parse_pb(ctx, buffer.data(), bufferLen, tx_obj))
+    return parser_validate_pb(ctx);
+}
+
+TEST(ProtobufSignDoc, MsgSend) {
+    app_mode_set_expert(false);
+    std::vector<uint8_t> buffer;
+    parser_context_t ctx = {};
+    pb_tx_t tx_obj = {};
+    const parser_error_t err = parsePb(kSignDocMsgSend, buffer, &ctx, &tx_obj);
+    ASSERT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+
+    const std::vector<std::string> expected = {
+        "0 | Chain ID : atlantic-2",
+        "1 | Type : cosmos-sdk/MsgSend",
+        "2 | Amount : 1 SEI",
+        "3 | From address [1/2] : sei14ae4g3422thcyuxler2ws3w25fpesrh2uq",
+        "3 | From address [2/2] : mgm9",
+        "4 | To address [1/2] : sei1cdvr6tns50wv03ek94ds6vnxh7pl3pmm9a",
+        "4 | To address [2/2] : mstu",
+        "5 | Memo : Transfer",
+        "6 | Fee : 0.01 SEI",
+    };
+    EXPECT_EQ(dumpPb(&ctx), expected);
+}
+
+TEST(ProtobufSignDoc, SameScreensAsAmino) {
+    for (const bool expert : {false, true}) {
+        app_mode_set_expert(expert);
+
+        std::vector<uint8_t> pbBuffer;
+        parser_context_t pbCtx = {};
+        pb_tx_t pbTx = {};
+        ASSERT_EQ(parsePb(kSignDocMsgSend, pbBuffer, &pbCtx, &pbTx), parser_ok);
+
+        uint8_t aminoBuffer[1000];
+        const uint16_t aminoLen = parseHexString(aminoBuffer, sizeof(aminoBuffer), kAminoMsgSend);
+        parser_context_t aminoCtx = {};
+        parser_tx_t aminoTx = {};
+        ASSERT_EQ(parser_parse(&aminoCtx, aminoBuffer, aminoLen, &aminoTx), parser_ok);
+        ASSERT_EQ(parser_validate(&aminoCtx), parser_ok);
+
+        EXPECT_EQ(dumpPb(&pbCtx), dumpUI(&aminoCtx, 39, 39, false)) << "expert: " << expert;
+    }
+    app_mode_set_expert(false);
+}
+
+TEST(ProtobufSignDoc, SeveralMessagesExpert) {
+    app_mode_set_expert(true);
+    std::vector<uint8_t> buffer;
+    parser_context_t ctx = {};
+    pb_tx_t tx_obj = {};
+    const parser_error_t err = parsePb(kSignDocSendDelegate, buffer, &ctx, &tx_obj);
+    ASSERT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+
+    const std::vector<std::string> expected = {
+        "0 | Chain ID : atlantic-2",
+        "1 | Account number : 1227",
+        "2 | Sequence : 183653",
+        "3 | Type : cosmos-sdk/MsgSend",
+        "4 | Amount : 1 SEI",
+        "5 | From address [1/2] : sei14ae4g3422thcyuxler2ws3w25fpesrh2uq",
+        "5 | From address [2/2] : mgm9",
+        "6 | To address [1/2] : sei1cdvr6tns50wv03ek94ds6vnxh7pl3pmm9a",
+        "6 | To address [2/2] : mstu",
+        "7 | Type : cosmos-sdk/MsgDelegate",
+        "8 | Amount : 2.5 SEI",
+        "9 | Delegator address [1/2] : sei14ae4g3422thcyuxler2ws3w25fpesrh2uq",
+        "9 | Delegator address [2/2] : mgm9",
+        "10 | Validator address [1/2] : seivaloper1sq7x0r2mf3gvwr2l9amtlye0yd3",
+        "10 | Validator address [2/2] : c6dqa4th95v",
+        "11 | Memo : Transfer",
+        "12 | Fee [1/2] : 0.01 SEI",
+        "12 | Fee [2/2] : 5 uatom",
+        "13 | Gas : 100000",
+    };
+    EXPECT_EQ(dumpPb(&ctx), expected);
+    app_mode_set_expert(false);
+}
+
+struct InvalidSignDoc {
+    const char *name;
+    const char *hex;
+    parser_error_t error;
+};
+
+TEST(ProtobufSignDoc, Rejected) {
+    const InvalidSignDoc cases[] = {
+        {"unknown message type",
+         "0a230a210a1b2f636f736d6f732e676f762e763162657461312e4d7367566f74651202100112690a520a460a1f2f636f736d"
+         "6f732e63727970746f2e736563703235366b312e5075624b657912230a210211111111111111111111111111111111111111"
+         "1111111111111111111111111112040a02080118e59a0b12130a0d0a04757365691205313030303010a08d061a0a61746c61"
+         "6e7469632d3220cb09",
+         parser_unsupported_tx},
+        {"unknown message field",
+         "0a7d0a7b0a1c2f636f736d6f732e62616e6b2e763162657461312e4d736753656e64125b0a2a736569313461653467333432"
+         "327468637975786c6572327773337732356670657372683275716d676d39122a736569316364767236746e73353077763033"
+         "656b3934647336766e786837706c33706d6d39616d7374754a017812690a520a460a1f2f636f736d6f732e63727970746f2e"
+         "736563703235366b312e5075624b657912230a21021111111111111111111111111111111111111111111111111111111111"
+         "11111112040a02080118e59a0b12130a0d0a04757365691205313030303010a08d061a0a61746c616e7469632d3220cb09",
+         parser_unexpected_field},
+        {"duplicated chain id",
+         "0a8c010a89010a1c2f636f736d6f732e62616e6b2e763162657461312e4d736753656e6412690a2a73656931346165346733"
+         "3432327468637975786c6572327773337732356670657372683275716d676d39122a736569316364767236746e7335307776"
+         "3033656b3934647336766e786837706c33706d6d39616d7374751a0f0a047573656912073130303030303012690a520a460a"
+         "1f2f636f736d6f732e63727970746f2e736563703235366b312e5075624b657912230a210211111111111111111111111111"
+         "1111111111111111111111111111111111111112040a02080118e59a0b12130a0d0a04757365691205313030303010a08d06"
+         "1a0a61746c616e7469632d3220cb091a09706163696669632d31",
+         parser_duplicated_field},
+        {"timeout height",
+         "0a8e010a89010a1c2f636f736d6f732e62616e6b2e763162657461312e4d736753656e6412690a2a73656931346165346733"
+         "3432327468637975786c6572327773337732356670657372683275716d676d39122a736569316364767236746e7335307776"
+         "3033656b3934647336766e786837706c33706d6d39616d7374751a0f0a0475736569120731303030303030180512690a520a"
+         "460a1f2f636f736d6f732e63727970746f2e736563703235366b312e5075624b657912230a21021111111111111111111111"
+         "11111111111111111111111111111111111111111112040a02080118e59a0b12130a0d0a04757365691205313030303010a0"
+         "8d061a0a61746c616e7469632d3220cb09",
+         parser_unexpected_value},
+        {"tip",
+         "0a8c010a89010a1c2f636f736d6f732e62616e6b2e763162657461312e4d736753656e6412690a2a73656931346165346733"
+         "3432327468637975786c6572327773337732356670657372683275716d676d39122a736569316364767236746e7335307776"
+         "3033656b3934647336766e786837706c33706d6d39616d7374751a0f0a0475736569120731303030303030126b0a520a460a"
+         "1f2f636f736d6f732e63727970746f2e736563703235366b312e5075624b657912230a210211111111111111111111111111"
+         "1111111111111111111111111111111111111112040a02080118e59a0b12130a0d0a04757365691205313030303010a08d06"
+         "1a001a0a61746c616e7469632d3220cb09",
+         parser_unexpected_field},
+        {"missing recipient",
+         "0a590a570a1c2f636f736d6f732e62616e6b2e763162657461312e4d736753656e6412370a2a736569313461653467333432"
+         "327468637975786c6572327773337732356670657372683275716d676d391a090a047573656912013112690a520a460a1f2f"
+         "636f736d6f732e63727970746f2e736563703235366b312e5075624b657912230a2102111111111111111111111111111111"
+         "111111111111111111111111111111111112040a02080118e59a0b12130a0d0a04757365691205313030303010a08d061a0a"
+         "61746c616e7469632d3220cb09",
+         parser_missing_field},
+        {"decimal amount",
+         "0a88010a85010a1c2f636f736d6f732e62616e6b2e763162657461312e4d736753656e6412650a2a73656931346165346733"
+         "3432327468637975786c6572327773337732356670657372683275716d676d39122a736569316364767236746e7335307776"
+         "3033656b3934647336766e786837706c33706d6d39616d7374751a0b0a04757365691203312e3512690a520a460a1f2f636f"
+         "736d6f732e63727970746f2e736563703235366b312e5075624b657912230a21021111111111111111111111111111111111"
+         "11111111111111111111111111111112040a02080118e59a0b12130a0d0a04757365691205313030303010a08d061a0a6174"
+         "6c616e7469632d3220cb09",
+         parser_unexpected_characters},
+        {"reserved chain id",
+         "0a8c010a89010a1c2f636f736d6f732e62616e6b2e763162657461312e4d736753656e6412690a2a73656931346165346733"
+         "3432327468637975786c6572327773337732356670657372683275716d676d39122a736569316364767236746e7335307776"
+         "3033656b3934647336766e786837706c33706d6d39616d7374751a0f0a047573656912073130303030303012690a520a460a"
+         "1f2f636f736d6f732e63727970746f2e736563703235366b312e5075624b657912230a210211111111111111111111111111"
+         "1111111111111111111111111111111111111112040a02080118e59a0b12130a0d0a04757365691205313030303010a08d06"
+         "1a013120cb09",
+         parser_unexpected_chain},
+        {"truncated", "0a05", parser_unexpected_buffer_end},
+        {"fixed64 wire type", "19" "0000000000000000", parser_unexpected_type},
+        {"overlong varint", "20" "ffffffffffffffffffff01", parser_value_out_of_range},
+    };
+
+    for (const auto &tc : cases) {
+        std::vector<uint8_t> buffer;
+        parser_context_t ctx = {};
+        pb_tx_t tx_obj = {};
+        EXPECT_EQ(parsePb(tc.hex, buffer, &ctx, &tx_obj), tc.error) << tc.name;
+    }
+}
+}  // namespace
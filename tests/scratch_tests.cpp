@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <hexutils.h>
+#include <json/json.h>
+#include <parser.h>
+#include <parser_evm.h>
+#include <parser_print.h>
+#include <scratch.h>
+
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "utils/common.h"
+
+TEST(Scratch, ReleaseReturnsToMark) {
+    scratch_reset();
+    ASSERT_EQ(scratch_used(), 0);
+
+    auto *first = static_cast<uint8_t *>(scratch_alloc(3));
+    ASSERT_NE(first, nullptr);
+    const scratch_mark_t mark = scratch_mark();
+    auto *second = static_cast<uint8_t *>(scratch_alloc(10));
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % 4, 0u);
+    EXPECT_GE(scratch_used(), 13);
+
+    second[0] = 0xAA;
+    scratch_release(mark);
+    EXPECT_EQ(scratch_used(), mark);
+
+    // Released bytes come back zeroed
+    auto *again = static_cast<uint8_t *>(scratch_alloc(10));
+    EXPECT_EQ(again, second);
+    EXPECT_EQ(again[0], 0);
+
+    scratch_reset();
+    EXPECT_EQ(scratch_used(), 0);
+}
+
+TEST(Scratch, FullArenaReturnsNull) {
+    scratch_reset();
+    EXPECT_NE(scratch_alloc(SCRATCH_SIZE), nullptr);
+    EXPECT_EQ(scratch_alloc(1), nullptr);
+    EXPECT_EQ(scratch_used(), SCRATCH_SIZE);
+
+    scratch_reset();
+    EXPECT_EQ(scratch_alloc(SCRATCH_SIZE + 1), nullptr);
+    EXPECT_EQ(scratch_used(), 0);
+}
+
+TEST(Scratch, FullArenaIsNotAShortInput) {
+    char outVal[40] = {0};
+    uint8_t pageCount = 0;
+
+    scratch_reset();
+    ASSERT_NE(scratch_alloc(SCRATCH_SIZE), nullptr);
+    EXPECT_EQ(parser_formatCoin("1000000", 7, "usei", 4, outVal, sizeof(outVal), 0, &pageCount),
+              parser_unexpected_error);
+    scratch_reset();
+}
+
+TEST(Scratch, FormattersReleaseWhatTheyTake) {
+    const std::string json =
+        R"({"account_number":"1227","chain_id":"pacific-1","fee":{"amount":[{"amount":"10000","denom":"usei"}],)"
+        R"("gas":"100000"},"memo":"","msgs":[{"type":"cosmos-sdk/MsgSend","value":{"amount":[{"amount":"12345",)"
+        R"("denom":"usei"}],"from_address":"sei14ae4g3422thcyuxler2ws3w25fpesrh2uqmgm9",)"
+        R"("to_address":"sei1cdvr6tns50wv03ek94ds6vnxh7pl3pmm9amstu"}}],"sequence":"183653"})";
+    parser_context_t ctx = {};
+    parser_tx_t tx_obj = {};
+
+    scratch_reset();
+    ASSERT_EQ(parser_parse(&ctx, (const uint8_t *)json.c_str(), json.size(), &tx_obj), parser_ok);
+    ASSERT_EQ(parser_validate(&ctx), parser_ok);
+    EXPECT_EQ(scratch_used(), 0);
+
+    EXPECT_FALSE(dumpUI(&ctx, 39, 39, false).empty());
+    EXPECT_EQ(scratch_used(), 0);
+    EXPECT_GT(scratch_peak(), 0);
+    EXPECT_LE(scratch_peak(), SCRATCH_SIZE);
+}
+
+TEST(Scratch, EvmFormattersReleaseWhatTheyTake) {
+    std::ifstream inFile(std::string(TESTVECTORS_DIR) + "testvectors/evm.json");
+    ASSERT_TRUE(inFile.is_open());
+    Json::Value obj;
+    JSONCPP_STRING errs;
+    ASSERT_TRUE(Json::parseFromStream(Json::CharReaderBuilder(), inFile, &obj, &errs));
+
+    for (const auto &testcase : obj) {
+        uint8_t buffer[5000];
+        const uint16_t bufferLen = parseHexString(buffer, sizeof(buffer), testcase["encoded_tx_hex"].asCString());
+        parser_context_t ctx = {};
+        eth_tx_t eth_tx_obj = {};
+
+        scratch_reset();
+        ASSERT_EQ(parser_parse_eth(&ctx, buffer, bufferLen, &eth_tx_obj), parser_ok);
+        EXPECT_FALSE(dumpUI(&ctx, 39, 39, true).empty());
+        EXPECT_EQ(scratch_used(), 0) << testcase["description"].asString();
+    }
+    EXPECT_LE(scratch_peak(), SCRATCH_SIZE);
+}
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+#include <parser.h>
+#include <parser_totals.h>
+
+#include <string>
+#include <vector>
+
+#include "app_mode.h"
+#include "gtest/gtest.h"
+#include "utils/common.h"
+
+namespace {
+const char *kValidator = "seivaloper1zxg7kfwt5wcfr5vjutcvpsgmpnkefyphuy0tnm";
+
+std::string msgUndelegate(const std::string &amount) {
+    return R"({"type":"cosmos-sdk/MsgUndelegate","value":{"amount":)" + amount + R"(,"delegator_address":")" + kFrom +
+           R"(","validator_address":")" + kValidator + R"("}})";
+}
+
+std::vector<std::string> totalsOf(const std::string &json) {
+    std::vector<std::string> answer;
+    for (const auto &item : txItems(json, 39)) {
+        if (item.rfind("Total", 0) == 0) {
+            answer.push_back(item);
+        }
+    }
+    return answer;
+}
+}  // namespace
+
+TEST(Totals, DecimalAdd) {
+    char acc[8] = {0};
+    ASSERT_EQ(parser_decimal_add(acc, sizeof(acc), "999", 3), parser_ok);
+    EXPECT_STREQ(acc, "999");
+    ASSERT_EQ(parser_decimal_add(acc, sizeof(acc), "1", 1), parser_ok);
+    EXPECT_STREQ(acc, "1000");
+    ASSERT_EQ(parser_decimal_add(acc, sizeof(acc), "0009000", 7), parser_ok);
+    EXPECT_STREQ(acc, "10000");
+
+    char zero[4] = {0};
+    ASSERT_EQ(parser_decimal_add(zero, sizeof(zero), "000", 3), parser_ok);
+    EXPECT_STREQ(zero, "0");
+}
+
+TEST(Totals, DecimalAddRejectsOverflowAndNonDigits) {
+    char acc[4] = "999";
+    EXPECT_EQ(parser_decimal_add(acc, sizeof(acc), "1", 1), parser_value_out_of_range);
+    EXPECT_STREQ(acc, "999");
+    EXPECT_EQ(parser_decimal_add(acc, sizeof(acc), "-1", 2), parser_unexpected_characters);
+    EXPECT_EQ(parser_decimal_add(acc, sizeof(acc), "1.5", 3), parser_unexpected_characters);
+    EXPECT_STREQ(acc, "999");
+}
+
+TEST(Totals, SumsPerDenomAcrossMessagesAndFee) {
+    app_mode_set_expert(false);
+    const auto json = signDoc(msgSend(kTo, coin("1000000") + "," + coin("18446744073709551615", "uatom")) + "," +
+                              msgSend(kTo, coin("2500000") + "," + coin("1", "uatom")));
+    const std::vector<std::string> expected = {"Total : 3.51 SEI", "Total : 18446744073709551616 uatom"};
+    EXPECT_EQ(totalsOf(json), expected);
+}
+
+TEST(Totals, NotShownForASingleSpendingMessage) {
+    app_mode_set_expert(false);
+    EXPECT_TRUE(totalsOf(signDoc(msgSend(kTo, coin("1000000")))).empty());
+
+    // Undelegated funds come back to the account, they are not spent
+    EXPECT_TRUE(totalsOf(signDoc(msgSend(kTo, coin("1000000")) + "," + msgUndelegate(coin("5")))).empty());
+}
+
+TEST(Totals, NotShownWhenDenomsDoNotFit) {
+    app_mode_set_expert(false);
+    std::string coins;
+    for (uint8_t i = 0; i <= COIN_TOTALS_MAX_DENOMS; i++) {
+        coins += (i == 0 ? "" : ",") + coin("1", "denom" + std::to_string(i));
+    }
+    EXPECT_TRUE(totalsOf(signDoc(msgSend(kTo, coins) + "," + msgSend(kTo, coin("1")))).empty());
+}
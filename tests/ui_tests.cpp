@@ -20,12 +20,15 @@
 
 #include <fstream>
 #include <iostream>
+#include <memory>
 
 #include "app_mode.h"
+#include "crypto_helper.h"
 #include "expected_output.h"
 #include "gmock/gmock.h"
 #include "parser.h"
 #include "testcases.h"
+#include "zxformat.h"
 #include "utils/common.h"
 
 using ::testing::TestWithParam;
@@ -127,15 +130,17 @@ void check_testcase(const testcase_t &tc, bool expert_mode, bool is_eth) {
     app_mode_set_expert(expert_mode);
 
     parser_error_t err;
-    parser_context_t ctx;
+    parser_context_t ctx = {};
+    parser_tx_t tx_obj = {};
+    eth_tx_t eth_tx_obj = {};
 
     uint8_t buffer[5000];
     uint16_t bufferLen = parseHexString(buffer, sizeof(buffer), tc.blob.c_str());
 
     if (is_eth) {
-        err = parser_parse_eth(&ctx, buffer, bufferLen);
+        err = parser_parse_eth(&ctx, buffer, bufferLen, &eth_tx_obj);
     } else {
-        err = parser_parse(&ctx, buffer, bufferLen);
+        err = parser_parse(&ctx, buffer, bufferLen, &tx_obj);
     }
     ASSERT_EQ(err, parser_ok) << parser_getErrorDescription(err);
 
@@ -171,3 +176,163 @@ INSTANTIATE_TEST_SUITE_P(JSONTransactions, VerifyJSONTransactions,
 TEST_P(VerifyEvmTransactions, CheckUIOutput_CurrentTX_Normal) { check_testcase(GetParam(), false, true); }
 TEST_P(VerifyJSONTransactions, CheckUIOutput_CurrentTX_Normal) { check_testcase(GetParam(), false, false); }
 TEST_P(VerifyJSONTransactions, CheckUIOutput_CurrentTX_Expert) { check_testcase(GetParam(), true, false); }
+
+// Every vector is parsed into its own context before any of them is rendered, so the
+// output only matches if no parser state is shared between contexts
+TEST(JSONTransactions, IndependentContexts) {
+    struct parsed_t {
+        std::vector<uint8_t> blob;
+        parser_context_t ctx;
+        parser_tx_t tx_obj;
+    };
+
+    app_mode_set_expert(false);
+    const auto testcases = GetJsonTestCases("testvectors/amino.json");
+    ASSERT_FALSE(testcases.empty());
+
+    std::vector<std::unique_ptr<parsed_t>> parsed;
+    for (const auto &tc : testcases) {
+        auto p = std::make_unique<parsed_t>();
+        p->blob.resize(tc.blob.size() / 2);
+        p->blob.resize(parseHexString(p->blob.data(), p->blob.size(), tc.blob.c_str()));
+        const parser_error_t err = parser_parse(&p->ctx, p->blob.data(), p->blob.size(), &p->tx_obj);
+        ASSERT_EQ(err, parser_ok) << tc.name << ": " << parser_getErrorDescription(err);
+        parsed.push_back(std::move(p));
+    }
+
+    for (size_t i = parsed.size(); i-- > 0;) {
+        EXPECT_EQ(dumpUI(&parsed[i]->ctx, 39, 39, false), testcases[i].expected) << testcases[i].name;
+    }
+}
+
+// Items read backwards, twice in a row and across an expert mode switch must match the ones read in order
+TEST(JSONTransactions, RandomAccessMatchesSequential) {
+    using item_t = std::pair<std::string, std::string>;
+
+    for (const auto &tc : GetJsonTestCases("testvectors/amino.json")) {
+        std::vector<uint8_t> blob(tc.blob.size() / 2);
+        blob.resize(parseHexString(blob.data(), blob.size(), tc.blob.c_str()));
+        parser_context_t ctx = {};
+        parser_tx_t tx_obj = {};
+        ASSERT_EQ(parser_parse(&ctx, blob.data(), blob.size(), &tx_obj), parser_ok) << tc.name;
+
+        auto read_item = [&](uint16_t idx) {
+            char key[40];
+            char val[40];
+            uint8_t pageCount = 0;
+            const parser_error_t err = parser_getItem(&ctx, idx, key, sizeof(key), val, sizeof(val), 0, &pageCount);
+            EXPECT_EQ(err, parser_ok) << tc.name << " item " << (int)idx << ": " << parser_getErrorDescription(err);
+            return item_t{key, val};
+        };
+
+        std::vector<item_t> sequential[2];
+        for (const bool expert : {false, true}) {
+            app_mode_set_expert(expert);
+            uint16_t numItems = 0;
+            ASSERT_EQ(parser_getNumItems(&ctx, &numItems), parser_ok) << tc.name;
+            for (uint16_t idx = 0; idx < numItems; idx++) {
+                sequential[expert].push_back(read_item(idx));
+            }
+        }
+
+        for (const bool expert : {false, true}) {
+            app_mode_set_expert(expert);
+            const auto &expected = sequential[expert];
+            for (size_t idx = expected.size(); idx-- > 0;) {
+                EXPECT_EQ(read_item(idx), expected[idx]) << tc.name;
+                EXPECT_EQ(read_item(idx), expected[idx]) << tc.name;
+            }
+        }
+    }
+    app_mode_set_expert(false);
+}
+
+// The Eth-Hash of every EVM vector must be the keccak256 of the encoded transaction
+TEST(EVMTransactions, EthHashMatchesEncodedTx) {
+    const Json::CharReaderBuilder builder;
+    Json::Value obj;
+
+    std::ifstream inFile(std::string(TESTVECTORS_DIR) + "testvectors/evm.json");
+    ASSERT_TRUE(inFile.is_open());
+
+    JSONCPP_STRING errs;
+    ASSERT_TRUE(Json::parseFromStream(builder, inFile, &obj, &errs)) << errs;
+
+    for (auto &i : obj) {
+        uint8_t buffer[5000];
+        const uint16_t bufferLen = parseHexString(buffer, sizeof(buffer), i["encoded_tx_hex"].asString().c_str());
+
+        uint8_t digest[32];
+        ASSERT_EQ(keccak_digest(buffer, bufferLen, digest, sizeof(digest)), zxerr_ok);
+
+        char digestHex[2 * sizeof(digest) + 1] = {0};
+        array_to_hexstr(digestHex, sizeof(digestHex), digest, sizeof(digest));
+        EXPECT_EQ(std::string(digestHex), i["message"]["Eth-Hash"].asString()) << i["description"].asString();
+    }
+}
+
+std::vector<std::vector<uint8_t>> GetEVMEncodedTxs() {
+    const Json::CharReaderBuilder builder;
+    Json::Value obj;
+    std::ifstream inFile(std::string(TESTVECTORS_DIR) + "testvectors/evm.json");
+    JSONCPP_STRING errs;
+    Json::parseFromStream(builder, inFile, &obj, &errs);
+
+    std::vector<std::vector<uint8_t>> answer;
+    for (auto &i : obj) {
+        const std::string hex = i["encoded_tx_hex"].asString();
+        std::vector<uint8_t> tx(hex.size() / 2);
+        tx.resize(parseHexString(tx.data(), tx.size(), hex.c_str()));
+        answer.push_back(tx);
+    }
+    return answer;
+}
+
+// The check done while chunks arrive must never refuse something the full parse accepts
+TEST(EVMTransactions, PrecheckAcceptsEveryPrefix) {
+    const auto txs = GetEVMEncodedTxs();
+    ASSERT_FALSE(txs.empty());
+    for (const auto &tx : txs) {
+        for (size_t len = 0; len <= tx.size(); len++) {
+            ASSERT_EQ(parser_precheck_eth(tx.data(), len), parser_ok) << "prefix " << len << " of " << tx.size();
+        }
+    }
+}
+
+TEST(EVMTransactions, PrecheckRejectsEarly) {
+    auto expect_rejected_from = [](const std::vector<uint8_t> &tx, size_t firstBadPrefix, parser_error_t expected) {
+        for (size_t len = 0; len < firstBadPrefix; len++) {
+            EXPECT_EQ(parser_precheck_eth(tx.data(), len), parser_ok) << "prefix " << len;
+        }
+        for (size_t len = firstBadPrefix; len <= tx.size(); len++) {
+            EXPECT_EQ(parser_precheck_eth(tx.data(), len), expected) << "prefix " << len;
+        }
+
+        // Same verdict as the full parse
+        parser_context_t ctx = {};
+        eth_tx_t eth_tx_obj = {};
+        EXPECT_EQ(parser_parse_eth(&ctx, tx.data(), tx.size(), &eth_tx_obj), expected);
+    };
+
+    for (auto tx : GetEVMEncodedTxs()) {
+        if (tx[0] == eip1559 || tx[0] == eip2930) {
+            // Chain ID 1329 (82 05 31) right after the list header, changed to 1337
+            const size_t header = tx[1] <= 0xF7 ? 1 : 1 + (tx[1] - 0xF7);
+            const size_t chainId = 1 + header;
+            ASSERT_EQ(tx[chainId], 0x82);
+            ASSERT_EQ(tx[chainId + 2], 0x31);
+            tx[chainId + 2] = 0x39;
+            expect_rejected_from(tx, chainId + 3, parser_invalid_chain_id);
+        } else {
+            // EIP-155 legacy transactions end with chain ID, r = 0 and s = 0
+            ASSERT_EQ(tx[tx.size() - 2], 0x80);
+            ASSERT_EQ(tx[tx.size() - 1], 0x80);
+            tx[tx.size() - 2] = 0x01;
+            tx[tx.size() - 1] = 0x01;
+            expect_rejected_from(tx, tx.size(), parser_invalid_rs_values);
+        }
+    }
+
+    const std::vector<uint8_t> blobTx = {0x03, 0xC1, 0x80};
+    expect_rejected_from(blobTx, 1, parser_unsupported_tx);
+}
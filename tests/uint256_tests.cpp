@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *   (c) 2018 - 2024 Zondax AG
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#include <uint256.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace {
+uint256_t make_u256(uint64_t w3, uint64_t w2, uint64_t w1, uint64_t w0) {
+    uint256_t v;
+    UPPER(UPPER(v)) = w3;
+    LOWER(UPPER(v)) = w2;
+    UPPER(LOWER(v)) = w1;
+    LOWER(LOWER(v)) = w0;
+    return v;
+}
+
+std::string to_hex(uint256_t v) {
+    char out[80];
+    EXPECT_TRUE(tostring256(&v, 16, out, sizeof(out)));
+    return out;
+}
+}  // namespace
+
+// The carry out of the second 64-bit column used to land in the top word
+TEST(Uint256, MulCarriesIntoThirdColumn) {
+    uint256_t a = make_u256(0, 0, UINT64_MAX, UINT64_MAX);
+    uint256_t product;
+    mul256(&a, &a, &product);
+    EXPECT_EQ(to_hex(product), "fffffffffffffffffffffffffffffffe00000000000000000000000000000001");
+}
+
+TEST(Uint256, MulWrapsModulo2To256) {
+    uint256_t a = make_u256(0, 1, 0, 0);
+    uint256_t b = make_u256(0, 0, 0, 3);
+    uint256_t product;
+    mul256(&a, &b, &product);
+    EXPECT_EQ(to_hex(product), "300000000000000000000000000000000");
+
+    mul256(&a, &a, &product);
+    EXPECT_EQ(to_hex(product), "0");
+}
+
+TEST(Uint256, DivModAndToString) {
+    uint256_t l = make_u256(0, 0, 0x1234, 0x5678);
+    uint256_t r = make_u256(0, 0, 0, 10);
+    uint256_t div;
+    uint256_t mod;
+    divmod256(&l, &r, &div, &mod);
+    EXPECT_EQ(to_hex(div), "1d200000000000008a5");
+    EXPECT_EQ(to_hex(mod), "6");
+
+    char out[4];
+    EXPECT_FALSE(tostring256(&l, 10, out, sizeof(out)));
+    EXPECT_FALSE(tostring256(&l, 17, out, sizeof(out)));
+}
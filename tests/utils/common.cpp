@@ -18,13 +18,17 @@
 #include <sstream>
 #include <string>
 
+#include "gtest/gtest.h"
+
 std::vector<std::string> dumpUI(parser_context_t *ctx, uint16_t maxKeyLen, uint16_t maxValueLen, bool is_eth) {
     auto answer = std::vector<std::string>();
 
-    uint8_t numItems;
+    uint16_t numItems = 0;
     parser_error_t err = parser_ok;
     if (is_eth) {
-        err = parser_getNumItemsEth(ctx, &numItems);
+        uint8_t numItemsEth = 0;
+        err = parser_getNumItemsEth(ctx, &numItemsEth);
+        numItems = numItemsEth;
     } else {
         err = parser_getNumItems(ctx, &numItems);
     }
@@ -43,7 +47,8 @@ std::vector<std::string> dumpUI(parser_context_t *ctx, uint16_t maxKeyLen, uint1
             std::stringstream ss;
 
             if (is_eth) {
-                err = parser_getItemEth(ctx, idx, keyBuffer, maxKeyLen, valueBuffer, maxValueLen, pageIdx, &pageCount);
+                err = parser_getItemEth(ctx, (uint8_t)idx, keyBuffer, maxKeyLen, valueBuffer, maxValueLen, pageIdx,
+                                        &pageCount);
             } else {
                 err = parser_getItem(ctx, idx, keyBuffer, maxKeyLen, valueBuffer, maxValueLen, pageIdx, &pageCount);
             }
@@ -67,3 +72,39 @@ std::vector<std::string> dumpUI(parser_context_t *ctx, uint16_t maxKeyLen, uint1
 
     return answer;
 }
+
+const char *const kFrom = "sei14ae4g3422thcyuxler2ws3w25fpesrh2uqmgm9";
+const char *const kTo = "sei1cdvr6tns50wv03ek94ds6vnxh7pl3pmm9amstu";
+
+std::string coin(const std::string &amount, const std::string &denom) {
+    return R"({"amount":")" + amount + R"(","denom":")" + denom + R"("})";
+}
+
+std::string coins(const std::string &amount, const std::string &denom) { return "[" + coin(amount, denom) + "]"; }
+
+std::string msgSend(const std::string &to, const std::string &amount, const std::string &from) {
+    return R"({"type":"cosmos-sdk/MsgSend","value":{"amount":[)" + amount + R"(],"from_address":")" + from +
+           R"(","to_address":")" + to + R"("}})";
+}
+
+std::string signDoc(const std::string &msgs, const std::string &fee, const std::string &memo,
+                    const std::string &chainId) {
+    return R"({"account_number":"1227","chain_id":")" + chainId + R"(","fee":{"amount":[)" + fee +
+           R"(],"gas":"100000"},"memo":")" + memo + R"(","msgs":[)" + msgs + R"(],"sequence":"183653"})";
+}
+
+parser_error_t parseTx(parser_context_t *ctx, parser_tx_t *tx_obj, const std::string &json) {
+    CHECK_ERROR(parser_parse(ctx, (const uint8_t *)json.c_str(), json.size(), tx_obj))
+    return parser_validate(ctx);
+}
+
+std::vector<std::string> txItems(const std::string &json, uint16_t maxValueLen) {
+    parser_context_t ctx = {};
+    parser_tx_t tx_obj = {};
+    std::vector<std::string> answer;
+    EXPECT_EQ(parseTx(&ctx, &tx_obj, json), parser_ok) << json;
+    for (const auto &line : dumpUI(&ctx, 39, maxValueLen, false)) {
+        answer.push_back(line.substr(line.find('|') + 2));
+    }
+    return answer;
+}
@@ -20,6 +20,22 @@
 #include <vector>
 std::vector<std::string> dumpUI(parser_context_t *ctx, uint16_t maxKeyLen, uint16_t maxValueLen, bool is_eth);
 
+// Amino sign doc builders, the defaults are those of the pacific-1 MsgSend vectors
+extern const char *const kFrom;
+extern const char *const kTo;
+
+std::string coin(const std::string &amount, const std::string &denom = "usei");
+std::string coins(const std::string &amount, const std::string &denom = "usei");
+// amount is the content of the coin list, e.g. coin("1") + "," + coin("2")
+std::string msgSend(const std::string &to, const std::string &amount, const std::string &from = kFrom);
+std::string signDoc(const std::string &msgs, const std::string &fee = coin("10000"), const std::string &memo = "",
+                    const std::string &chainId = "pacific-1");
+
+// Parses and validates json, which has to outlive ctx like tx_obj
+parser_error_t parseTx(parser_context_t *ctx, parser_tx_t *tx_obj, const std::string &json);
+// Items of a tx that has to parse and validate, without their "<idx> | " prefix
+std::vector<std::string> txItems(const std::string &json, uint16_t maxValueLen);
+
 #define JSON_PARSE(parsed_json, buffer) json_parse(parsed_json, buffer, strlen(buffer))
 #define EXPECT_EQ_STR(_STR1, _STR2, _ERROR_MESSAGE)                                            \
     {                                                                                          \